@@ -178,22 +178,60 @@ static void update_gptp(struct net_if *iface, struct net_pkt *pkt,
 #define update_gptp(iface, pkt, send)
 #endif /* CONFIG_NET_GPTP */
 
+/* Gather the fragments of a packet for a single writev(), the way a
+ * scatter-gather DMA engine would. Returns the number of fragments, or
+ * -1 if there are more than max.
+ */
+static int eth_pkt_gather(struct net_pkt *pkt, void **bufs, size_t *lens,
+			  int max)
+{
+	struct net_buf *frag;
+	int count = 0;
+
+	for (frag = pkt->buffer; frag; frag = frag->frags) {
+		if (frag->len == 0) {
+			continue;
+		}
+
+		if (count == max) {
+			return -1;
+		}
+
+		bufs[count] = frag->data;
+		lens[count] = frag->len;
+		count++;
+	}
+
+	return count;
+}
+
 static int eth_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_context *ctx = dev->data;
 	int count = net_pkt_get_len(pkt);
+	void *bufs[ETH_NATIVE_POSIX_SG_MAX];
+	size_t lens[ETH_NATIVE_POSIX_SG_MAX];
+	int frags;
 	int ret;
 
-	ret = net_pkt_read(pkt, ctx->send, count);
-	if (ret) {
-		return ret;
+	frags = eth_pkt_gather(pkt, bufs, lens, ARRAY_SIZE(bufs));
+	if (frags < 0) {
+		ret = net_pkt_read(pkt, ctx->send, count);
+		if (ret) {
+			return ret;
+		}
 	}
 
 	update_gptp(net_pkt_iface(pkt), pkt, true);
 
-	LOG_DBG("Send pkt %p len %d", pkt, count);
+	LOG_DBG("Send pkt %p len %d frags %d", pkt, count, frags);
+
+	if (frags < 0) {
+		ret = eth_write_data(ctx->dev_fd, ctx->send, count);
+	} else {
+		ret = eth_write_data_vec(ctx->dev_fd, bufs, lens, frags);
+	}
 
-	ret = eth_write_data(ctx->dev_fd, ctx->send, count);
 	if (ret < 0) {
 		LOG_DBG("Cannot send pkt %p (%d)", pkt, ret);
 	}
@@ -23,6 +23,7 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <time.h>
 #include <arch/posix/posix_trace.h>
@@ -175,6 +176,25 @@ ssize_t eth_write_data(int fd, void *buf, size_t buf_len)
 	return write(fd, buf, buf_len);
 }
 
+ssize_t eth_write_data_vec(int fd, void * const *bufs, const size_t *lens,
+			   int count)
+{
+	struct iovec iov[ETH_NATIVE_POSIX_SG_MAX];
+	int i;
+
+	if (count > ETH_NATIVE_POSIX_SG_MAX) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = lens[i];
+	}
+
+	/* A TAP device takes the whole vector as one frame */
+	return writev(fd, iov, count);
+}
+
 #if defined(CONFIG_NET_GPTP)
 int eth_clock_gettime(struct net_ptp_time *time)
 {
@@ -14,6 +14,9 @@
 #define ETH_NATIVE_POSIX_DRV_NAME CONFIG_ETH_NATIVE_POSIX_DRV_NAME
 #define ETH_NATIVE_POSIX_DEV_NAME CONFIG_ETH_NATIVE_POSIX_DEV_NAME
 
+/* Packets with more fragments than this are copied before sending */
+#define ETH_NATIVE_POSIX_SG_MAX 16
+
 #if defined(CONFIG_ETH_NATIVE_POSIX_STARTUP_AUTOMATIC)
 #define ETH_NATIVE_POSIX_SETUP_SCRIPT CONFIG_ETH_NATIVE_POSIX_SETUP_SCRIPT
 #define ETH_NATIVE_POSIX_STARTUP_SCRIPT CONFIG_ETH_NATIVE_POSIX_STARTUP_SCRIPT
@@ -32,6 +35,8 @@ int eth_start_script(const char *if_name);
 int eth_wait_data(int fd);
 ssize_t eth_read_data(int fd, void *buf, size_t buf_len);
 ssize_t eth_write_data(int fd, void *buf, size_t buf_len);
+ssize_t eth_write_data_vec(int fd, void * const *bufs, const size_t *lens,
+			   int count);
 int eth_if_up(const char *if_name);
 int eth_if_down(const char *if_name);
 
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <net/net_if.h>
 
 #include <net/dummy.h>
+#include <net/loopback.h>
 
 int loopback_dev_init(const struct device *dev)
 {
@@ -31,6 +32,42 @@ int loopback_dev_init(const struct device *dev)
 	return 0;
 }
 
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+static float drop_ratio;
+static float drop_credit;
+static int dropped;
+
+int loopback_set_packet_drop_ratio(float ratio)
+{
+	if (ratio < 0.0f || ratio > 1.0f) {
+		return -EINVAL;
+	}
+
+	drop_ratio = ratio;
+	drop_credit = 0.0f;
+
+	return 0;
+}
+
+int loopback_get_num_dropped_packets(void)
+{
+	return dropped;
+}
+
+static bool loopback_drop(void)
+{
+	drop_credit += drop_ratio;
+	if (drop_credit < 1.0f) {
+		return false;
+	}
+
+	drop_credit -= 1.0f;
+	dropped++;
+
+	return true;
+}
+#endif
+
 static void loopback_init(struct net_if *iface)
 {
 	/* RFC 7042, s.2.1.1. address to use in documentation */
@@ -70,6 +107,14 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		net_ipaddr_copy(&NET_IPV4_HDR(pkt)->dst, &addr);
 	}
 
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+	/* Lost on the wire: the send itself still succeeds */
+	if (loopback_drop()) {
+		res = 0;
+		goto out;
+	}
+#endif
+
 	/* We should simulate normal driver meaning that if the packet is
 	 * properly sent (which is always in this driver), then the packet
 	 * must be dropped. This is very much needed for TCP packets where
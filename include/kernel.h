@@ -1926,23 +1926,49 @@ struct k_queue {
 	sys_sflist_t data_q;
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
+#ifdef CONFIG_QUEUE_MPSC
+	/* Items pushed by lock-free producers, newest first */
+	atomic_ptr_t mpsc_inbox;
+	/* Threads that may be pended on an MPSC queue */
+	atomic_t mpsc_waiters;
+	uint8_t mpsc_mode;
+#endif
 
 	_POLL_EVENT;
 	_OBJECT_TRACING_NEXT_PTR(k_queue)
 	_OBJECT_TRACING_LINKED_FLAG
 };
 
-#define Z_QUEUE_INITIALIZER(obj) \
+#ifdef CONFIG_QUEUE_MPSC
+/* Values of k_queue::mpsc_mode */
+#define Z_QUEUE_MPSC_NONE 0U
+#define Z_QUEUE_MPSC_FIFO 1U
+#define Z_QUEUE_MPSC_LIFO 2U
+
+#define _QUEUE_MPSC_INIT(mode) .mpsc_mode = (mode),
+#else
+#define _QUEUE_MPSC_INIT(mode)
+#endif
+
+#define Z_QUEUE_INITIALIZER_MODE(obj, mode) \
 	{ \
 	.data_q = SYS_SFLIST_STATIC_INIT(&obj.data_q), \
 	.lock = { }, \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),	\
+	_QUEUE_MPSC_INIT(mode)			\
 	_POLL_EVENT_OBJ_INIT(obj)		\
 	_OBJECT_TRACING_INIT \
 	}
 
+#define Z_QUEUE_INITIALIZER(obj) Z_QUEUE_INITIALIZER_MODE(obj, 0U)
+
 extern void *z_queue_node_peek(sys_sfnode_t *node, bool needs_free);
 
+#ifdef CONFIG_QUEUE_MPSC
+extern void z_queue_mpsc_init(struct k_queue *queue, uint8_t mode);
+extern void z_queue_mpsc_flush(struct k_queue *queue);
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2137,6 +2163,9 @@ __syscall void *k_queue_get(struct k_queue *queue, k_timeout_t timeout);
  */
 static inline bool k_queue_remove(struct k_queue *queue, void *data)
 {
+#ifdef CONFIG_QUEUE_MPSC
+	z_queue_mpsc_flush(queue);
+#endif
 	return sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 }
 
@@ -2158,6 +2187,9 @@ static inline bool k_queue_unique_append(struct k_queue *queue, void *data)
 {
 	sys_sfnode_t *test;
 
+#ifdef CONFIG_QUEUE_MPSC
+	z_queue_mpsc_flush(queue);
+#endif
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			return false;
@@ -2185,6 +2217,11 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_MPSC
+	if (atomic_ptr_get(&queue->mpsc_inbox) != NULL) {
+		return 0;
+	}
+#endif
 	return (int)sys_sflist_is_empty(&queue->data_q);
 }
 
@@ -2201,6 +2238,9 @@ __syscall void *k_queue_peek_head(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_MPSC
+	z_queue_mpsc_flush(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 }
 
@@ -2217,6 +2257,9 @@ __syscall void *k_queue_peek_tail(struct k_queue *queue);
 
 static inline void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_MPSC
+	z_queue_mpsc_flush(queue);
+#endif
 	return z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 }
 
@@ -2347,6 +2390,26 @@ struct k_fifo {
 #define k_fifo_init(fifo) \
 	k_queue_init(&(fifo)->_queue)
 
+#if defined(CONFIG_QUEUE_MPSC) || defined(__DOXYGEN__)
+/**
+ * @brief Initialize a FIFO queue in lock-free producer mode.
+ *
+ * Like k_fifo_init(), but k_fifo_put() on this FIFO pushes items
+ * without taking the FIFO's lock unless a thread is waiting in
+ * k_fifo_get().  Any number of threads and ISRs, on any CPU, may put
+ * concurrently.  All other operations behave as for a regular FIFO,
+ * except that the FIFO cannot be waited on with k_poll().
+ *
+ * @note Requires CONFIG_QUEUE_MPSC.
+ *
+ * @param fifo Address of the FIFO queue.
+ *
+ * @return N/A
+ */
+#define k_fifo_init_mpsc(fifo) \
+	z_queue_mpsc_init(&(fifo)->_queue, Z_QUEUE_MPSC_FIFO)
+#endif
+
 /**
  * @brief Cancel waiting on a FIFO queue.
  *
@@ -2513,6 +2576,22 @@ struct k_fifo {
 	Z_STRUCT_SECTION_ITERABLE_ALTERNATE(k_queue, k_fifo, name) = \
 		Z_FIFO_INITIALIZER(name)
 
+#if defined(CONFIG_QUEUE_MPSC) || defined(__DOXYGEN__)
+/**
+ * @brief Statically define a FIFO queue in lock-free producer mode.
+ *
+ * See k_fifo_init_mpsc().
+ *
+ * @note Requires CONFIG_QUEUE_MPSC.
+ *
+ * @param name Name of the FIFO queue.
+ */
+#define K_FIFO_MPSC_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE_ALTERNATE(k_queue, k_fifo, name) = \
+		{ ._queue = Z_QUEUE_INITIALIZER_MODE(name._queue, \
+						     Z_QUEUE_MPSC_FIFO) }
+#endif
+
 /** @} */
 
 struct k_lifo {
@@ -2550,6 +2629,24 @@ struct k_lifo {
 #define k_lifo_init(lifo) \
 	k_queue_init(&(lifo)->_queue)
 
+#if defined(CONFIG_QUEUE_MPSC) || defined(__DOXYGEN__)
+/**
+ * @brief Initialize a LIFO queue in lock-free producer mode.
+ *
+ * Like k_lifo_init(), but k_lifo_put() on this LIFO pushes items
+ * without taking the LIFO's lock unless a thread is waiting in
+ * k_lifo_get().  See k_fifo_init_mpsc().
+ *
+ * @note Requires CONFIG_QUEUE_MPSC.
+ *
+ * @param lifo Address of the LIFO queue.
+ *
+ * @return N/A
+ */
+#define k_lifo_init_mpsc(lifo) \
+	z_queue_mpsc_init(&(lifo)->_queue, Z_QUEUE_MPSC_LIFO)
+#endif
+
 /**
  * @brief Add an element to a LIFO queue.
  *
@@ -2617,6 +2714,22 @@ struct k_lifo {
 	Z_STRUCT_SECTION_ITERABLE_ALTERNATE(k_queue, k_lifo, name) = \
 		Z_LIFO_INITIALIZER(name)
 
+#if defined(CONFIG_QUEUE_MPSC) || defined(__DOXYGEN__)
+/**
+ * @brief Statically define a LIFO queue in lock-free producer mode.
+ *
+ * See k_lifo_init_mpsc().
+ *
+ * @note Requires CONFIG_QUEUE_MPSC.
+ *
+ * @param name Name of the LIFO queue.
+ */
+#define K_LIFO_MPSC_DEFINE(name) \
+	Z_STRUCT_SECTION_ITERABLE_ALTERNATE(k_queue, k_lifo, name) = \
+		{ ._queue = Z_QUEUE_INITIALIZER_MODE(name._queue, \
+						     Z_QUEUE_MPSC_LIFO) }
+#endif
+
 /** @} */
 
 /**
@@ -3817,6 +3930,141 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages stored at
+ * @a data to message queue @a msgq, taking the queue lock once and
+ * rescheduling at most once for the whole batch. Messages are handed
+ * directly to threads waiting in k_msgq_get() first; the rest are copied
+ * into the ring buffer until it is full.
+ *
+ * If no message can be sent immediately the caller waits up to @a timeout
+ * for room for the first one, after which any further messages that fit
+ * are sent without waiting again. The caller must check the return value
+ * and resubmit the messages that were not sent.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a num_msgs messages.
+ * @param num_msgs Number of messages in @a data.
+ * @param timeout Waiting period to send the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent (greater than zero unless @a num_msgs
+ *	is zero), -ENOMSG if none could be sent without waiting or the queue
+ *	was purged, or -EAGAIN if the waiting period timed out.
+ */
+__syscall int k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			       uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq into consecutive slots of @a data, taking the queue lock once
+ * and rescheduling at most once for the whole batch. Slots freed in the
+ * ring buffer are refilled from threads waiting in k_msgq_put().
+ *
+ * If the queue is empty the caller waits up to @a timeout for a first
+ * message, after which any further messages already queued are received
+ * without waiting again.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an area holding @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received (greater than zero unless
+ *	@a num_msgs is zero), -ENOMSG if the queue was empty and no waiting
+ *	was requested, or -EAGAIN if the waiting period timed out.
+ */
+__syscall int k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			       uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Claim free ring buffer slots for zero-copy sending.
+ *
+ * This routine returns a pointer into the ring buffer of @a msgq where the
+ * caller may write messages in place, and the number of consecutive free
+ * slots available there (at most @a num_msgs). Fewer slots than are free
+ * in total may be returned when the free space wraps around the end of
+ * the ring buffer. The messages become visible to receivers once
+ * k_msgq_put_commit() is called.
+ *
+ * No other thread or ISR may send to @a msgq, and the queue must not be
+ * purged, between the claim and the matching commit.
+ *
+ * @note Can be called by ISRs. Not available to user mode threads.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Set to the address of the first claimed slot.
+ * @param num_msgs Maximum number of slots to claim.
+ *
+ * @return Number of slots claimed; 0 if the queue is full.
+ */
+uint32_t k_msgq_put_claim(struct k_msgq *msgq, void **data,
+			  uint32_t num_msgs);
+
+/**
+ * @brief Publish messages written into claimed ring buffer slots.
+ *
+ * Waiting receivers are woken with a single reschedule.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of messages written, no more than were claimed.
+ *
+ * @retval 0 Messages committed.
+ * @retval -EINVAL @a num_msgs exceeds the claimed area.
+ */
+int k_msgq_put_commit(struct k_msgq *msgq, uint32_t num_msgs);
+
+/**
+ * @brief Peek at queued messages in place for zero-copy receiving.
+ *
+ * This routine returns a pointer to the oldest message in the ring buffer
+ * of @a msgq and the number of consecutive messages stored there (at most
+ * @a num_msgs). The messages stay queued until k_msgq_get_commit() is
+ * called.
+ *
+ * No other thread or ISR may receive from @a msgq, and the queue must not
+ * be purged, between the claim and the matching commit.
+ *
+ * @note Can be called by ISRs. Not available to user mode threads.
+ *
+ * @param msgq Address of the message queue.
+ * @param data Set to the address of the first queued message.
+ * @param num_msgs Maximum number of messages to claim.
+ *
+ * @return Number of messages claimed; 0 if the queue is empty.
+ */
+uint32_t k_msgq_get_claim(struct k_msgq *msgq, void **data,
+			  uint32_t num_msgs);
+
+/**
+ * @brief Release messages consumed in place.
+ *
+ * The freed ring buffer slots are refilled from waiting senders, which
+ * are woken with a single reschedule.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of messages consumed, no more than were claimed.
+ *
+ * @retval 0 Messages released.
+ * @retval -EINVAL @a num_msgs exceeds the claimed area.
+ */
+int k_msgq_get_commit(struct k_msgq *msgq, uint32_t num_msgs);
+
 /**
  * @brief Purge a message queue.
  *
@@ -4241,14 +4489,96 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space in a pipe's buffer for zero-copy writing.
+ *
+ * This routine returns a pointer into the ring buffer of @a pipe where the
+ * caller may write data in place, and the number of consecutive free bytes
+ * available there (at most @a size). Less than the total free space may be
+ * returned when it wraps around the end of the buffer; call the routine
+ * again after k_pipe_put_finish() to claim the remainder.
+ *
+ * The data becomes visible to readers once k_pipe_put_finish() is called.
+ * No other thread may write to @a pipe between the claim and the matching
+ * finish.
+ *
+ * @note Not available to user mode threads or ISRs.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed space.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; 0 if the buffer is full or the pipe
+ *         is unbuffered.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Publish data written into claimed pipe buffer space.
+ *
+ * Waiting readers whose requests can now be satisfied are woken with a
+ * single reschedule.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, no more than were claimed.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL @a size exceeds the claimed space.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's buffer for zero-copy reading.
+ *
+ * This routine returns a pointer to the oldest data in the ring buffer of
+ * @a pipe and the number of consecutive bytes available there (at most
+ * @a size). The data stays in the pipe until k_pipe_get_finish() is called.
+ * No other thread may read from @a pipe between the claim and the matching
+ * finish.
+ *
+ * @note Not available to user mode threads or ISRs.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param size Maximum number of bytes to claim.
+ *
+ * @return Number of bytes claimed; 0 if the buffer is empty or the pipe
+ *         is unbuffered.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size);
+
+/**
+ * @brief Release data consumed in place from a pipe's buffer.
+ *
+ * The freed space is refilled from waiting writers; those whose requests
+ * complete are woken with a single reschedule.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, no more than were claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL @a size exceeds the claimed data.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU magazine of free blocks held back from the shared free list */
+struct z_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	char *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 	uint32_t num_blocks;
 	size_t block_size;
 	char *buffer;
@@ -4257,6 +4587,13 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Set while threads may be pended on the slab, forcing frees
+	 * through the shared free list so waiters see them
+	 */
+	bool cache_bypass;
+	struct z_mem_slab_cpu_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab)
 	_OBJECT_TRACING_LINKED_FLAG
@@ -4266,6 +4603,7 @@ struct k_mem_slab {
 			       slab_num_blocks) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.lock = {}, \
 	.num_blocks = slab_num_blocks, \
 	.block_size = slab_block_size, \
 	.buffer = slab_buffer, \
@@ -4382,7 +4720,20 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* num_used counts blocks taken off the shared free list,
+	 * including those parked in the per-CPU caches
+	 */
+	uint32_t cached = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cache[i].count;
+	}
+
+	return slab->num_used - cached;
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -4417,7 +4768,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -4429,10 +4780,28 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+/* Per-CPU free lists of small blocks held back from the backing
+ * sys_heap, one singly linked list per size class
+ */
+struct z_heap_cpu_cache {
+	struct k_spinlock lock;
+	void *free[CONFIG_HEAP_CPU_CACHE_CLASSES];
+	uint8_t count[CONFIG_HEAP_CPU_CACHE_CLASSES];
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_CPU_CACHE
+	/* Set while threads may be pended on the heap, forcing frees
+	 * into the backing heap so waiters see them
+	 */
+	bool cache_bypass;
+	struct z_heap_cpu_cache cache[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 /**
@@ -4839,6 +5208,108 @@ extern void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 __syscall int k_poll(struct k_poll_event *events, int num_events,
 		     k_timeout_t timeout);
 
+/**
+ * @brief Persistent poll set
+ *
+ * A poll set keeps its events registered with their objects between waits,
+ * so that waiting only costs work proportional to the events that became
+ * ready rather than to the size of the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** Events signaled since they were last returned */
+	sys_dlist_t ready;
+
+	/** Events returned by the last wait, to be re-checked */
+	sys_dlist_t rearm;
+
+	/** Threads waiting on the set */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a persistent poll set.
+ *
+ * @param set Address of the poll set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a persistent poll set.
+ *
+ * The event is checked and registered with its object immediately; it stays
+ * registered until it is removed from the set. The event structure is owned
+ * by the set until then and must not be passed to k_poll() or added to
+ * another set.
+ *
+ * @param set Address of the poll set.
+ * @param event Event initialized with k_poll_event_init().
+ *
+ * @retval 0 Event added.
+ * @retval -EALREADY Event is already part of a poll set.
+ */
+extern int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a persistent poll set.
+ *
+ * @param set Address of the poll set.
+ * @param event Event previously added to @a set.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not part of @a set.
+ */
+extern int k_poll_set_remove(struct k_poll_set *set,
+			     struct k_poll_event *event);
+
+/**
+ * @brief Re-check events of a persistent poll set.
+ *
+ * Events of @a set that are waiting on their objects and whose condition
+ * holds are moved to the ready list, as if their object had signaled.
+ * Use this when an object may have become ready without notifying the
+ * set, e.g. while the events were not registered with it.
+ *
+ * @param set Address of the poll set.
+ * @param events Events of @a set to check, others are skipped.
+ * @param num_events Number of events in @a events.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_refresh(struct k_poll_set *set,
+			       struct k_poll_event *events, int num_events);
+
+/**
+ * @brief Wait for events of a persistent poll set to become ready.
+ *
+ * This routine returns up to @a max_events events of @a set that are ready,
+ * in the order they were signaled, with their state field set. Returned
+ * events are checked again at the start of the next wait and reported again
+ * if their condition still holds, so the set behaves level-triggered like
+ * k_poll().
+ *
+ * Unlike k_poll(), events that did not fire are not touched, and the cost
+ * of a wait does not depend on how many events the set holds.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param set Address of the poll set.
+ * @param ready Array filled with pointers to the ready events.
+ * @param max_events Size of @a ready.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a ready, or -EAGAIN if the
+ *	   waiting period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **ready, int max_events,
+			   k_timeout_t timeout);
+
 /**
  * @brief Initialize a poll signal object.
  *
@@ -4880,8 +5351,8 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
  * @brief Signal a poll signal object.
  *
  * This routine makes ready a poll signal, which is basically a poll event of
- * type K_POLL_TYPE_SIGNAL. If a thread was polling on that event, it will be
- * made ready to run. A @a result value can be specified.
+ * type K_POLL_TYPE_SIGNAL. Every thread and poll set polling on that event
+ * is made ready. A @a result value can be specified.
  *
  * The poll signal contains a 'signaled' field that, when set by
  * k_poll_signal_raise(), stays set until the user sets it back to 0 with
@@ -4897,7 +5368,8 @@ __syscall void k_poll_signal_check(struct k_poll_signal *signal,
  * @param result The value to store in the result field of the signal.
  *
  * @retval 0 The signal was delivered successfully.
- * @retval -EAGAIN The polling thread's timeout is in the process of expiring.
+ * @retval -EAGAIN The timeout of a polling thread is in the process of
+ *                 expiring. The other pollers are still signaled.
  */
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *signal, int result);
@@ -191,6 +191,48 @@ struct coap_resource {
 	int age;
 };
 
+/**
+ * @brief Node of a resource tree, one for each distinct path segment.
+ */
+struct coap_resource_node {
+	/** Path segment matched by the node, NULL for the root */
+	const char *segment;
+	/** First node one segment deeper */
+	struct coap_resource_node *child;
+	/** Next node at the same depth */
+	struct coap_resource_node *next;
+	/** Resource whose path ends at the node, if any */
+	struct coap_resource *resource;
+	/** Length of the path segment */
+	uint8_t len;
+};
+
+/**
+ * @brief Resources indexed by their path, see coap_resource_tree_build().
+ */
+struct coap_resource_tree {
+	struct coap_resource *resources;
+	struct coap_resource_node *nodes;
+	uint16_t max_nodes;
+	uint16_t used;
+};
+
+/**
+ * @brief Statically define a resource tree.
+ *
+ * A tree needs one node for the root plus one for each distinct path
+ * prefix of the resources.
+ *
+ * @param _name Name of the resource tree
+ * @param _max_nodes Number of nodes available to the tree
+ */
+#define COAP_RESOURCE_TREE_DEFINE(_name, _max_nodes)			\
+	static struct coap_resource_node _name##_nodes[_max_nodes];	\
+	static struct coap_resource_tree _name = {			\
+		.nodes = _name##_nodes,					\
+		.max_nodes = _max_nodes,				\
+	}
+
 /**
  * @brief Represents a remote device that is observing a local resource.
  */
@@ -199,6 +241,8 @@ struct coap_observer {
 	struct sockaddr addr;
 	uint8_t token[8];
 	uint8_t tkl;
+	/** Resource the observer is registered to, NULL if none */
+	struct coap_resource *resource;
 };
 
 /**
@@ -211,6 +255,9 @@ struct coap_packet {
 	uint8_t hdr_len; /* CoAP header length */
 	uint16_t opt_len; /* Total options length (delta + len + value) */
 	uint16_t delta; /* Used for delta calculation in CoAP packet */
+	/* Options indexed by coap_packet_parse_indexed(), or NULL */
+	struct coap_option *opt_index;
+	uint8_t opt_index_num; /* Number of options in opt_index */
 };
 
 struct coap_option {
@@ -332,6 +379,28 @@ const uint8_t *coap_packet_get_payload(const struct coap_packet *cpkt,
 int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 		      struct coap_option *options, uint8_t opt_num);
 
+/**
+ * @brief Parses the CoAP packet in data like coap_packet_parse(), and
+ * keeps @a options as an index of the packet options.
+ *
+ * When all options of the packet fit in @a options, coap_find_options()
+ * and the helpers built on it look the options up in the index instead
+ * of decoding the packet again. @a options must remain valid and
+ * unmodified while @a cpkt is used.
+ *
+ * @param cpkt Packet to be initialized from received @a data.
+ * @param data Data containing a CoAP packet, its @a data pointer is
+ * positioned on the start of the CoAP packet.
+ * @param len Length of the data
+ * @param options Parse options and cache its details.
+ * @param opt_num Number of options
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_packet_parse_indexed(struct coap_packet *cpkt, uint8_t *data,
+			      uint16_t len, struct coap_option *options,
+			      uint8_t opt_num);
+
 /**
  * @brief Creates a new CoAP Packet from input data.
  *
@@ -468,6 +537,57 @@ int coap_handle_request(struct coap_packet *cpkt,
 			uint8_t opt_num,
 			struct sockaddr *addr, socklen_t addr_len);
 
+/**
+ * @brief Builds a resource tree out of an array of resources.
+ *
+ * The tree has one level per path segment, so that a request is matched
+ * against the resources sharing its path prefix only. When several
+ * resources have the same path, the first one in @a resources is used.
+ * The tree must be rebuilt if @a resources is modified.
+ *
+ * @param tree Resource tree, see COAP_RESOURCE_TREE_DEFINE()
+ * @param resources Array of known resources, terminated by an entry
+ * with a NULL path
+ *
+ * @return 0 in case of success, -ENOMEM if the tree ran out of nodes or
+ * -EINVAL if a path segment is too long.
+ */
+int coap_resource_tree_build(struct coap_resource_tree *tree,
+			     struct coap_resource *resources);
+
+/**
+ * @brief Finds the resource matching the Uri-Path options of a request.
+ *
+ * @param tree Resource tree built with coap_resource_tree_build()
+ * @param options Parsed options from coap_packet_parse()
+ * @param opt_num Number of options
+ *
+ * @return The same resource coap_handle_request() would pick from the
+ * array, or NULL if there is none.
+ */
+struct coap_resource *coap_resource_tree_find(
+	const struct coap_resource_tree *tree,
+	const struct coap_option *options, uint8_t opt_num);
+
+/**
+ * @brief When a request is received, call the appropriate methods of
+ * the matching resource of a resource tree.
+ *
+ * @param cpkt Packet received
+ * @param tree Resource tree built with coap_resource_tree_build()
+ * @param options Parsed options from coap_packet_parse()
+ * @param opt_num Number of options
+ * @param addr Peer address
+ * @param addr_len Peer address length
+ *
+ * @return 0 in case of success or negative in case of error.
+ */
+int coap_handle_request_tree(struct coap_packet *cpkt,
+			     const struct coap_resource_tree *tree,
+			     struct coap_option *options,
+			     uint8_t opt_num,
+			     struct sockaddr *addr, socklen_t addr_len);
+
 /**
  * Represents the size of each block that will be transferred using
  * block-wise transfers [RFC7959]:
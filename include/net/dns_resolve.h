@@ -399,6 +399,48 @@ static inline int dns_cancel_addr_info(uint16_t dns_id)
 	return dns_resolve_cancel(dns_resolve_get_default(), dns_id);
 }
 
+/**
+ * @typedef dns_cache_cb_t
+ * @brief Callback used while iterating over the DNS answer cache.
+ *
+ * @param query Name that was resolved
+ * @param type Type of the query (A or AAAA)
+ * @param info Cached address, NULL if the name is cached as non-existent
+ * @param ttl Seconds until the entry expires
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*dns_cache_cb_t)(const char *query,
+			       enum dns_query_type type,
+			       const struct dns_addrinfo *info,
+			       uint32_t ttl,
+			       void *user_data);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Remove all entries from the DNS answer cache.
+ */
+void dns_cache_flush(void);
+
+/**
+ * @brief Go through all the valid entries of the DNS answer cache.
+ *
+ * @details The cache is locked while the callback runs, so the callback
+ * must not resolve names.
+ *
+ * @param cb User supplied callback function to call
+ * @param user_data User specified data
+ */
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the DNS answer cache statistics.
+ *
+ * @param hits Number of lookups answered from the cache
+ * @param misses Number of lookups that had to query a server
+ */
+void dns_cache_get_stats(uint32_t *hits, uint32_t *misses);
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 /**
  * @}
  */
@@ -130,6 +130,12 @@ enum ethernet_hw_caps {
 
 	/** VLAN Tag stripping */
 	ETHERNET_HW_VLAN_TAG_STRIP	= BIT(14),
+
+	/** TCP segmentation offload: packets with net_pkt_gso_size() set
+	 * are split into segments of that size, with their IP and TCP
+	 * checksums, by the device.
+	 */
+	ETHERNET_HW_TSO			= BIT(15),
 };
 
 /** @cond INTERNAL_HIDDEN */
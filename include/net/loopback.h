@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+#define ZEPHYR_INCLUDE_NET_LOOPBACK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Loopback network driver support functions
+ * @defgroup loopback Loopback Network Driver Support Functions
+ * @ingroup networking
+ * @{
+ */
+
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+/**
+ * @brief Set the ratio of packets the loopback driver drops.
+ *
+ * Drops are spread evenly rather than randomly, so that a test sees
+ * the same losses on every run: with a ratio of 0.1 every tenth packet
+ * is dropped.
+ *
+ * @param ratio Ratio of dropped packets, between 0 (none) and 1 (all).
+ *
+ * @return 0 on success, -EINVAL if the ratio is out of range.
+ */
+int loopback_set_packet_drop_ratio(float ratio);
+
+/**
+ * @brief Get the number of packets dropped by the loopback driver.
+ *
+ * @return Number of packets dropped since boot.
+ */
+int loopback_get_num_dropped_packets(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_LOOPBACK_H_ */
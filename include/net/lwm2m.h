@@ -687,6 +687,68 @@ int lwm2m_engine_get_float64(char *pathstr, float64_value_t *buf);
  */
 int lwm2m_engine_get_objlnk(char *pathstr, struct lwm2m_objlnk *buf);
 
+/**
+ * @brief Resource instance resolved by lwm2m_engine_resolve_path()
+ *
+ * The members are private to the LwM2M engine.
+ */
+struct lwm2m_res_handle {
+	struct lwm2m_engine_obj_inst *obj_inst;
+	struct lwm2m_engine_obj_field *obj_field;
+	struct lwm2m_engine_res *res;
+	struct lwm2m_engine_res_inst *res_inst;
+	uint32_t generation;
+};
+
+/**
+ * @brief Resolve a resource (instance) path into a handle
+ *
+ * The handle lets resources which are updated often be set or read
+ * without parsing the path and looking up the object instance on every
+ * access.  Once the object instance or the resource instance is
+ * deleted, accesses through the handle fail with -ENOENT, even if an
+ * instance with the same path is created again; the path must then be
+ * resolved again.
+ *
+ * @param[in] pathstr LwM2M path string "obj/obj-inst/res(/res-inst)"
+ * @param[out] handle Handle of the resource instance
+ *
+ * @return 0 for success or negative in case of error.
+ */
+int lwm2m_engine_resolve_path(char *pathstr, struct lwm2m_res_handle *handle);
+
+/**
+ * @brief Set resource (instance) value using a handle
+ *
+ * Behaves as the lwm2m_engine_set_*() function matching the type of the
+ * resource.
+ *
+ * @param[in] handle Handle from lwm2m_engine_resolve_path()
+ * @param[in] value Value of the resource type, e.g. a uint32_t for U32
+ * @param[in] len Length of the value
+ *
+ * @return 0 for success, -ENOENT if the instance was deleted or another
+ *         negative value in case of error.
+ */
+int lwm2m_engine_set_by_handle(const struct lwm2m_res_handle *handle,
+			       void *value, uint16_t len);
+
+/**
+ * @brief Get resource (instance) value using a handle
+ *
+ * Behaves as the lwm2m_engine_get_*() function matching the type of the
+ * resource.
+ *
+ * @param[in] handle Handle from lwm2m_engine_resolve_path()
+ * @param[out] buf Buffer to copy data into
+ * @param[in] buflen Length of the buffer
+ *
+ * @return 0 for success, -ENOENT if the instance was deleted or another
+ *         negative value in case of error.
+ */
+int lwm2m_engine_get_by_handle(const struct lwm2m_res_handle *handle,
+			       void *buf, uint16_t buflen);
+
 
 /**
  * @brief Set resource (instance) read callback
@@ -974,6 +974,37 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+struct net_pkt_ext_done;
+
+#if defined(CONFIG_NET_PKT_EXT_DATA) || defined(__DOXYGEN__)
+/**
+ * @brief Send data in iovec without copying it.
+ *
+ * @details Same as net_context_sendmsg(), but the iovec data is appended
+ * to the packet by reference with net_pkt_append_ext_data(). A reference
+ * to @a done is taken for each non-empty iovec; the caller must keep the
+ * data unchanged until the completion callback of @a done has run.
+ * Only UDP is supported, and the data must fit in one datagram.
+ *
+ * @param context The network context to use.
+ * @param msghdr The data to send
+ * @param flags Flags for the sending.
+ * @param done Completion of the data.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendmsg_ext(struct net_context *context,
+			    const struct msghdr *msghdr,
+			    int flags,
+			    struct net_pkt_ext_done *done,
+			    net_context_send_cb_t cb,
+			    k_timeout_t timeout,
+			    void *user_data);
+#endif /* CONFIG_NET_PKT_EXT_DATA */
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
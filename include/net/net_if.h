@@ -1928,6 +1928,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP packets carrying several segments (see
+ * net_pkt_gso_size()) need to be split by the IP stack, or if the
+ * device does it when sending them.
+ *
+ * @param iface Network interface
+ *
+ * @return True if the IP stack needs to split the packets, false otherwise.
+ */
+bool net_if_need_tcp_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
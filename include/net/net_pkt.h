@@ -212,6 +212,18 @@ struct net_pkt {
 	 */
 	uint8_t priority;
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP payload size of the segments this packet is to be split
+	 * into, 0 if it is a single segment.
+	 */
+	uint16_t gso_size;
+#endif
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+	/* Flow hash provided by the device (RSS), 0 if there is none */
+	uint32_t rx_hash;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -688,6 +700,56 @@ static inline void net_pkt_set_priority(struct net_pkt *pkt,
 	pkt->priority = priority;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	return pkt->rx_hash;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	pkt->rx_hash = hash;
+}
+#else
+static inline uint32_t net_pkt_rx_hash(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_rx_hash(struct net_pkt *pkt, uint32_t hash)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hash);
+}
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 static inline uint16_t net_pkt_vlan_tag(struct net_pkt *pkt)
 {
@@ -1565,6 +1627,66 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
  */
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer);
 
+/**
+ * @brief Completion of caller-owned data sent by reference
+ *
+ * Tracks the fragments created by net_pkt_append_ext_data(). The
+ * callback is called once, when the owner has called
+ * net_pkt_ext_done_put() and the stack has freed every fragment, i.e.
+ * the data was sent by the driver or dropped. The data must not be
+ * modified before that.
+ */
+struct net_pkt_ext_done {
+	/** Called when the data is no longer referenced */
+	void (*cb)(struct net_pkt_ext_done *done);
+
+	/** Number of references: the owner and each fragment */
+	atomic_t refs;
+};
+
+/**
+ * @brief Initialize a completion, holding the owner's reference
+ *
+ * @param done Completion to initialize
+ * @param cb   Callback to call when the data is no longer referenced
+ */
+static inline void net_pkt_ext_done_init(struct net_pkt_ext_done *done,
+					 void (*cb)(struct net_pkt_ext_done *))
+{
+	done->cb = cb;
+	atomic_set(&done->refs, 1);
+}
+
+#if defined(CONFIG_NET_PKT_EXT_DATA) || defined(__DOXYGEN__)
+/**
+ * @brief Drop a reference to a completion
+ *
+ * The owner calls this once all the data has been appended.
+ *
+ * @param done Completion
+ */
+void net_pkt_ext_done_put(struct net_pkt_ext_done *done);
+
+/**
+ * @brief Append caller-owned data to a packet without copying it
+ *
+ * The data is referenced by an external net_buf fragment appended after
+ * the current last fragment. Unlike net_pkt_write(), the cursor is not
+ * moved.
+ *
+ * @param pkt     Network packet
+ * @param data    Data to reference
+ * @param len     Length of the data
+ * @param done    Completion notified when the fragment is freed
+ * @param timeout Maximum time to wait for a free fragment
+ *
+ * @return 0 on success, negative errno otherwise
+ */
+int net_pkt_append_ext_data(struct net_pkt *pkt, const void *data,
+			    size_t len, struct net_pkt_ext_done *done,
+			    k_timeout_t timeout);
+#endif /* CONFIG_NET_PKT_EXT_DATA */
+
 /**
  * @brief Get available buffer space from a pkt
  *
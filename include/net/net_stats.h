@@ -163,6 +163,15 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of TCP segments retransmitted before their RTO expired. */
+	net_stats_t fast_rexmit;
+
+	/** Number of times fast recovery was entered. */
+	net_stats_t recovery;
+
+	/** Number of expired TCP retransmission timers. */
+	net_stats_t rexmit_timeout;
 };
 
 /**
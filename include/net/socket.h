@@ -54,6 +54,10 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Control data was discarded (output value only) */
+#define ZSOCK_MSG_CTRUNC 0x08
+/** zsock_recvmsg: Datagram was longer than the buffer (output value only) */
+#define ZSOCK_MSG_TRUNC 0x20
 /** zsock_recv/zsock_send: Override operation to non-blocking */
 #define ZSOCK_MSG_DONTWAIT 0x40
 
@@ -357,6 +361,137 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Message and its length for zsock_sendmmsg() and zsock_recvmmsg()
+ */
+struct mmsghdr {
+	struct msghdr msg_hdr;  /**< Message */
+	unsigned int  msg_len;  /**< Number of bytes sent or received */
+};
+
+/** Maximum number of messages handled by one mmsg call, more are ignored */
+#define ZSOCK_MMSG_VLEN_MAX 1024
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Calls sendmsg() for each of the ``vlen`` messages in ``msgvec`` and
+ * stores the number of bytes sent in ``msg_len``, as the Linux call of
+ * the same name does. Stops at the first message that cannot be sent.
+ * From userspace this costs a single system call for all messages.
+ * This function is also exposed as ``sendmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, or -1 with errno set if none could be
+ * sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive a message from a socket
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * Ancillary data is returned for the IP_PKTINFO, IPV6_RECVPKTINFO and
+ * SO_TIMESTAMPNS socket options.
+ * This function is also exposed as ``recvmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX) || defined(__DOXYGEN__)
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Takes the next datagram, or the next chunk of stream data as it was
+ * received, off the socket and describes it in @a iov with pointers into
+ * the network buffers holding it. The buffers belong to the caller until
+ * they are given back with zsock_recv_zc_release(), so the data can be
+ * parsed in place. Holding on to stream data does not close the TCP
+ * receive window, but holding on to many buffers starves the RX pool.
+ *
+ * Only native IP sockets are supported. This is not a system call, as
+ * the network buffers cannot be accessed from user mode.
+ *
+ * @param sock Socket
+ * @param iov Array to describe the data fragments in
+ * @param iovcnt Number of entries in @a iov. Set to the number of entries
+ *        used, or needed when failing with EMSGSIZE.
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param handle Set to the handle to release the buffers with, or NULL
+ *        if there is nothing to release.
+ *
+ * @return Number of bytes received, 0 at end of stream, or -1 with errno
+ * set. With EMSGSIZE the data stays queued on the socket.
+ */
+ssize_t zsock_recv_zc(int sock, struct iovec *iov, size_t *iovcnt,
+		      int flags, void **handle);
+
+/**
+ * @brief Give the buffers returned by zsock_recv_zc() back
+ *
+ * @param handle Handle set by zsock_recv_zc(), may be NULL
+ */
+void zsock_recv_zc_release(void *handle);
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_RX */
+
+struct net_pkt_ext_done;
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_TX) || defined(__DOXYGEN__)
+/**
+ * @brief Send a datagram without copying it
+ *
+ * @details
+ * Like zsock_sendmsg(), but the network packet references the iovec
+ * data instead of holding a copy, so drivers capable of scatter-gather
+ * DMA transmit it straight from the caller's buffers. @a done must have
+ * been set up with net_pkt_ext_done_init(); its callback is called once,
+ * even when sending fails, when the buffers may be reused. This may
+ * happen before the function returns.
+ *
+ * Only native UDP sockets are supported, and the data must fit in a
+ * single datagram. This is not a system call.
+ *
+ * @param sock Socket
+ * @param msg Message to send
+ * @param flags ZSOCK_MSG_DONTWAIT or 0
+ * @param done Completion of the buffers
+ *
+ * @return Number of bytes sent, or -1 with errno set.
+ */
+ssize_t zsock_sendmsg_zc(int sock, const struct msghdr *msg, int flags,
+			 struct net_pkt_ext_done *done);
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_TX */
+
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * @rst
+ * Waits for the first message according to ``flags`` and the blocking
+ * mode of the socket, then receives as many of the remaining ``vlen``
+ * messages as are already queued, like the Linux call of the same name
+ * with MSG_WAITFORONE. From userspace this costs a single system call
+ * for all messages.
+ * This function is also exposed as ``recvmmsg()``
+ * if :option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, or -1 with errno set if none was
+ * received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -697,6 +832,23 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -770,6 +922,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define POLLNVAL ZSOCK_POLLNVAL
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
+#define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -798,14 +952,43 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 /** sockopt: Timestamp TX packets */
 #define SO_TIMESTAMPING 37
 
+/** sockopt: Pass the RX timestamp of datagrams to zsock_recvmsg(), as a
+ * struct timespec in a SCM_TIMESTAMPNS control message like on Linux.
+ * Requires CONFIG_NET_PKT_TIMESTAMP.
+ */
+#define SO_TIMESTAMPNS 35
+#define SCM_TIMESTAMPNS SO_TIMESTAMPNS
+
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
 
+/* Socket options for IPPROTO_IP level */
+/** sockopt: Pass a struct in_pktinfo to zsock_recvmsg() for datagrams */
+#define IP_PKTINFO 8
+
+/** Destination address and interface of a received IPv4 datagram */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /**< Interface index */
+	struct in_addr ipi_spec_dst; /**< Local address */
+	struct in_addr ipi_addr;     /**< Destination address of the header */
+};
+
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
 
+/** sockopt: Pass a struct in6_pktinfo to zsock_recvmsg() for datagrams */
+#define IPV6_RECVPKTINFO 49
+/** Control message type of the IPV6_RECVPKTINFO data */
+#define IPV6_PKTINFO 50
+
+/** Destination address and interface of a received IPv6 datagram */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /**< Destination address */
+	unsigned int    ipi6_ifindex; /**< Interface index */
+};
+
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
 
@@ -54,6 +54,32 @@ struct sys_heap {
 	size_t init_bytes;
 };
 
+/* Upper bound on the number of free list buckets of a heap, one per
+ * bit of the chunk count
+ */
+#define SYS_HEAP_MAX_BUCKETS 32
+
+/** @brief Runtime statistics of a sys_heap
+ *
+ * Filled in by sys_heap_runtime_stats_get().  All sizes are in bytes.
+ */
+struct sys_heap_runtime_stats {
+	/** Bytes in free chunks, including chunk headers */
+	size_t free_bytes;
+	/** Bytes in allocated chunks, including chunk headers */
+	size_t allocated_bytes;
+	/** Largest single allocation that can currently succeed */
+	size_t max_free_bytes;
+	/** Number of free chunks */
+	size_t free_chunks;
+	/** Number of valid entries in @a bucket_free_bytes */
+	uint32_t nb_buckets;
+	/** Free bytes in each bucket.  Bucket n holds free chunks of
+	 * 2^n to 2^(n+1)-1 times the minimum chunk size.
+	 */
+	size_t bucket_free_bytes[SYS_HEAP_MAX_BUCKETS];
+};
+
 struct z_heap_stress_result {
 	uint32_t total_allocs;
 	uint32_t successful_allocs;
@@ -122,9 +148,10 @@ void sys_heap_free(struct sys_heap *h, void *mem);
  *
  * Returns a pointer to a new memory region with the same contents,
  * but a different allocated size.  If the new allocation can be
- * expanded in place, the pointer returned will be identical.
- * Otherwise the data will be copies to a new block and the old one
- * will be freed as per sys_heap_free().  If the specified size is
+ * expanded in place, the pointer returned will be identical.  If it
+ * can grow into free memory immediately below it, the data is moved
+ * down within the heap.  Otherwise the data will be copied to a new
+ * block and the old one will be freed as per sys_heap_free().  If the specified size is
  * smaller than the original, the block will be truncated in place and
  * the remaining memory returned to the heap.  If the allocation of a
  * new block fails, then NULL will be returned and the old block will
@@ -142,6 +169,43 @@ void sys_heap_free(struct sys_heap *h, void *mem);
  */
 void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes);
 
+/** @brief Return the usable size of an allocated block
+ *
+ * Returns the number of bytes the caller may use in a block returned
+ * by sys_heap_alloc(), sys_heap_aligned_alloc() or
+ * sys_heap_realloc().  This is at least the size that was requested
+ * and may be slightly larger due to the chunk granularity of the
+ * heap.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param heap Heap that owns the block
+ * @param mem A pointer previously returned from sys_heap_alloc()
+ * @return Usable size of the block, in bytes
+ */
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
+
+/** @brief Get runtime statistics of a sys_heap
+ *
+ * Reports free and allocated byte counts along with fragmentation
+ * information: the largest allocation that can currently succeed and
+ * the free bytes held in each size bucket.  Unlike the allocation
+ * functions this walks every free list, so it takes time linear in
+ * the number of free chunks.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param heap Heap to inspect
+ * @param stats Struct into which to store the statistics
+ * @return 0 on success, -EINVAL on NULL arguments
+ */
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats);
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
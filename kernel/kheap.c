@@ -13,6 +13,13 @@ void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	h->cache_bypass = false;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		h->cache[i] = (struct z_heap_cpu_cache) {};
+	}
+#endif
 }
 
 static int statics_init(const struct device *unused)
@@ -26,17 +33,225 @@ static int statics_init(const struct device *unused)
 
 SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+#define NUM_CLASSES CONFIG_HEAP_CPU_CACHE_CLASSES
+#define CLASS_SIZE(c) ((size_t)8 << (c))
+
+/* Blocks moved between a CPU cache and the backing heap at once */
+#define CACHE_BATCH MAX(CONFIG_HEAP_CPU_CACHE_DEPTH / 2, 1)
+
+/* Smallest size class that can satisfy a request, or -1 */
+static int alloc_class(size_t align, size_t bytes)
+{
+	/* sys_heap blocks are always pointer aligned, stronger
+	 * alignment requests bypass the caches
+	 */
+	if (bytes == 0U || align > sizeof(void *)) {
+		return -1;
+	}
+
+	for (int c = 0; c < NUM_CLASSES; c++) {
+		if (bytes <= CLASS_SIZE(c)) {
+			return c;
+		}
+	}
+
+	return -1;
+}
+
+/* Largest size class a block can serve, or -1 if it is too small or
+ * large enough that caching it would waste more than half of it.
+ */
+static int free_class(struct k_heap *h, void *mem)
+{
+	/* Only the header of this (allocated, so caller owned) chunk
+	 * is read, which is safe without the heap lock.
+	 */
+	size_t usable = sys_heap_usable_size(&h->heap, mem);
+	int c;
+
+	if (usable < CLASS_SIZE(0) ||
+	    usable >= 2 * CLASS_SIZE(NUM_CLASSES - 1)) {
+		return -1;
+	}
+
+	for (c = 0; c < NUM_CLASSES - 1; c++) {
+		if (usable < CLASS_SIZE(c + 1)) {
+			break;
+		}
+	}
+
+	return c;
+}
+
+static struct z_heap_cpu_cache *local_cache(struct k_heap *h)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_heap_cpu_cache *cache = &h->cache[_current_cpu->id];
+
+	arch_irq_unlock(key);
+
+	/* Migrating after this point is harmless: the caches are
+	 * interchangeable, only the cache line locality suffers.
+	 */
+	return cache;
+}
+
+static void *cache_get(struct k_heap *h, int c)
+{
+	struct z_heap_cpu_cache *cache = local_cache(h);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	void *mem = cache->free[c];
+
+	if (mem != NULL) {
+		cache->free[c] = *(void **)mem;
+		cache->count[c]--;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	return mem;
+}
+
+/* Pushes a freed block onto the calling CPU's cache, false if it has
+ * no size class, its class is full, or the heap may have waiters
+ * that need to see the block.
+ */
+static bool cache_put(struct k_heap *h, void *mem)
+{
+	int c = free_class(h, mem);
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key;
+	bool ret = false;
+
+	if (c < 0) {
+		return false;
+	}
+
+	cache = local_cache(h);
+	key = k_spin_lock(&cache->lock);
+	if (!h->cache_bypass &&
+	    cache->count[c] < CONFIG_HEAP_CPU_CACHE_DEPTH) {
+		*(void **)mem = cache->free[c];
+		cache->free[c] = mem;
+		cache->count[c]++;
+		ret = true;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+/* Allocates one block of class @c for the caller and, unless caching
+ * is bypassed, up to CACHE_BATCH - 1 more for the current CPU's
+ * cache.  Heap lock must be held.
+ */
+static void *cache_refill(struct k_heap *h, int c)
+{
+	void *ret = sys_heap_alloc(&h->heap, CLASS_SIZE(c));
+	struct z_heap_cpu_cache *cache = &h->cache[_current_cpu->id];
+	k_spinlock_key_t key;
+
+	if (ret == NULL || h->cache_bypass) {
+		return ret;
+	}
+
+	key = k_spin_lock(&cache->lock);
+	for (int i = 1; i < CACHE_BATCH; i++) {
+		void *mem;
+
+		if (cache->count[c] >= CONFIG_HEAP_CPU_CACHE_DEPTH) {
+			break;
+		}
+
+		mem = sys_heap_alloc(&h->heap, CLASS_SIZE(c));
+		if (mem == NULL) {
+			break;
+		}
+		*(void **)mem = cache->free[c];
+		cache->free[c] = mem;
+		cache->count[c]++;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+/* Returns cached blocks of one CPU to the backing heap until no size
+ * class holds more than @keep of them.  Heap lock must be held.
+ */
+static void cache_trim(struct k_heap *h, int cpu, uint8_t keep)
+{
+	struct z_heap_cpu_cache *cache = &h->cache[cpu];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	for (int c = 0; c < NUM_CLASSES; c++) {
+		while (cache->count[c] > keep) {
+			void *mem = cache->free[c];
+
+			cache->free[c] = *(void **)mem;
+			cache->count[c]--;
+			sys_heap_free(&h->heap, mem);
+		}
+	}
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Pulls every cached block back into the heap so that a failing
+ * allocation sees all free memory, coalesced.  Heap lock must be
+ * held.
+ */
+static void cache_drain(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cache_trim(h, i, 0);
+	}
+}
+#endif /* CONFIG_HEAP_CPU_CACHE */
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = z_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+	int c = alloc_class(align, bytes);
+
+	if (c >= 0) {
+		ret = cache_get(h, c);
+		if (ret != NULL) {
+			return ret;
+		}
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+
 	while (ret == NULL) {
+#ifdef CONFIG_HEAP_CPU_CACHE
+		if (c >= 0) {
+			ret = cache_refill(h, c);
+		} else {
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+
+		if (ret == NULL) {
+			/* Route frees around the caches while we may
+			 * pend, then pull back whatever is parked in
+			 * them and retry with the exact size.
+			 */
+			if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				h->cache_bypass = true;
+			}
+			cache_drain(h);
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+#else
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+#endif
 
 		now = z_tick_get();
 		if ((ret != NULL) || ((end - now) <= 0)) {
@@ -54,13 +269,32 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (mem == NULL || cache_put(h, mem)) {
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (!h->cache_bypass) {
+		/* The local cache may be full, make room in batches */
+		cache_trim(h, _current_cpu->id,
+			   CONFIG_HEAP_CPU_CACHE_DEPTH - CACHE_BATCH);
+	}
+#endif
+
 	if (z_unpend_all(&h->wait_q) != 0) {
 		z_reschedule(&h->lock, key);
 	} else {
+#ifdef CONFIG_HEAP_CPU_CACHE
+		h->cache_bypass = false;
+#endif
 		k_spin_unlock(&h->lock, key);
 	}
 }
@@ -15,8 +15,6 @@
 #include <init.h>
 #include <sys/check.h>
 
-static struct k_spinlock lock;
-
 #ifdef CONFIG_OBJECT_TRACING
 struct k_mem_slab *_trace_list_k_mem_slab;
 #endif	/* CONFIG_OBJECT_TRACING */
@@ -88,11 +86,19 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->block_size = block_size;
 	slab->buffer = buffer;
 	slab->num_used = 0U;
+	slab->lock = (struct k_spinlock) {};
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cache_bypass = false;
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		slab->cache[i] = (struct z_mem_slab_cpu_cache) {};
+	}
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -106,11 +112,126 @@ out:
 	return rc;
 }
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Blocks moved between a CPU cache and the shared free list at once */
+#define CACHE_BATCH MAX(CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2, 1)
+
+static struct z_mem_slab_cpu_cache *local_cache(struct k_mem_slab *slab)
+{
+	unsigned int key = arch_irq_lock();
+	struct z_mem_slab_cpu_cache *cache = &slab->cache[_current_cpu->id];
+
+	arch_irq_unlock(key);
+
+	/* Migrating after this point is harmless: the caches are
+	 * interchangeable, only the cache line locality suffers.
+	 */
+	return cache;
+}
+
+/* Pops a block from the calling CPU's cache, NULL if it is empty.
+ * Only the local cache lock is taken, so this never contends with
+ * other CPUs unless one of them is draining the caches.
+ */
+static char *cache_get(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cpu_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	char *block = NULL;
+
+	if (cache->count > 0U) {
+		block = cache->blocks[--cache->count];
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	return block;
+}
+
+/* Pushes a block onto the calling CPU's cache, false if it is full or
+ * the slab may have waiters that need to see the block.
+ */
+static bool cache_put(struct k_mem_slab *slab, char *block)
+{
+	struct z_mem_slab_cpu_cache *cache = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool ret = false;
+
+	if (!slab->cache_bypass &&
+	    cache->count < CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		cache->blocks[cache->count++] = block;
+		ret = true;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	return ret;
+}
+
+/* Moves up to CACHE_BATCH blocks from the free list into the current
+ * CPU's cache.  Slab lock must be held.
+ */
+static void cache_refill(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cpu_cache *cache = &slab->cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	while (slab->free_list != NULL && cache->count < CACHE_BATCH) {
+		cache->blocks[cache->count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->num_used++;
+	}
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Returns @count cached blocks of one CPU to the free list.  Slab lock
+ * must be held.
+ */
+static void cache_flush(struct k_mem_slab *slab, int cpu, uint32_t count)
+{
+	struct z_mem_slab_cpu_cache *cache = &slab->cache[cpu];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	while (count-- > 0U && cache->count > 0U) {
+		char *block = cache->blocks[--cache->count];
+
+		*(char **)block = slab->free_list;
+		slab->free_list = block;
+		slab->num_used--;
+	}
+	k_spin_unlock(&cache->lock, key);
+}
+
+/* Pulls every cached block back to the free list, used when the free
+ * list runs dry so no block is stranded on another CPU.  Slab lock
+ * must be held.
+ */
+static void cache_drain(struct k_mem_slab *slab)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cache_flush(slab, i, CONFIG_MEM_SLAB_CPU_CACHE_SIZE);
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	*mem = cache_get(slab);
+	if (*mem != NULL) {
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->free_list == NULL) {
+		cache_drain(slab);
+	}
+#endif
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -121,28 +242,57 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		slab->max_used = MAX(slab->num_used, slab->max_used);
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		if (!slab->cache_bypass) {
+			cache_refill(slab);
+		}
+#endif
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a free block to become available */
 		*mem = NULL;
 		result = -ENOMEM;
 	} else {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		/* Route frees through the free list until the waiters
+		 * are gone.  The caches were drained above with this set
+		 * visible to cache_put(), so nothing can be parked there
+		 * behind our back.
+		 */
+		slab->cache_bypass = true;
+		cache_drain(slab);
+		if (slab->free_list != NULL) {
+			*mem = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+			slab->num_used++;
+			k_spin_unlock(&slab->lock, key);
+			return 0;
+		}
+#endif
 		/* wait for a free block or timeout */
-		result = z_pend_curr(&lock, key, &slab->wait_q, timeout);
+		result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
 		if (result == 0) {
 			*mem = _current->base.swap_data;
 		}
 		return result;
 	}
 
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&slab->lock, key);
 
 	return result;
 }
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_put(slab, *mem)) {
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
 
 	if (slab->free_list == NULL) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
@@ -150,12 +300,22 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 		if (pending_thread != NULL) {
 			z_thread_return_value_set_with_data(pending_thread, 0, *mem);
 			z_ready_thread(pending_thread);
-			z_reschedule(&lock, key);
+			z_reschedule(&slab->lock, key);
 			return;
 		}
 	}
 	**(char ***) mem = slab->free_list;
 	slab->free_list = *(char **) mem;
 	slab->num_used--;
-	k_spin_unlock(&lock, key);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->cache_bypass) {
+		/* Waiters that timed out leave the flag behind */
+		slab->cache_bypass = z_waitq_head(&slab->wait_q) != NULL;
+	} else {
+		/* The local cache was full: make room for later frees */
+		cache_flush(slab, _current_cpu->id, CACHE_BATCH);
+	}
+#endif
+	k_spin_unlock(&slab->lock, key);
 }
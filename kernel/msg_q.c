@@ -285,6 +285,362 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *q, void *data)
 #include <syscalls/k_msgq_peek_mrsh.c>
 #endif
 
+/* Copy @a n messages into the ring at the write pointer, splitting the
+ * copy in two when it wraps. The caller guarantees the space is free.
+ */
+static void ring_put(struct k_msgq *msgq, const char *src, uint32_t n)
+{
+	size_t len = n * msgq->msg_size;
+	size_t tail = msgq->buffer_end - msgq->write_ptr;
+
+	if (len >= tail) {
+		(void)memcpy(msgq->write_ptr, src, tail);
+		(void)memcpy(msgq->buffer_start, src + tail, len - tail);
+		msgq->write_ptr = msgq->buffer_start + (len - tail);
+	} else {
+		(void)memcpy(msgq->write_ptr, src, len);
+		msgq->write_ptr += len;
+	}
+	msgq->used_msgs += n;
+}
+
+/* Copy @a n messages out of the ring at the read pointer */
+static void ring_get(struct k_msgq *msgq, char *dst, uint32_t n)
+{
+	size_t len = n * msgq->msg_size;
+	size_t tail = msgq->buffer_end - msgq->read_ptr;
+
+	if (len >= tail) {
+		(void)memcpy(dst, msgq->read_ptr, tail);
+		(void)memcpy(dst + tail, msgq->buffer_start, len - tail);
+		msgq->read_ptr = msgq->buffer_start + (len - tail);
+	} else {
+		(void)memcpy(dst, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	}
+	msgq->used_msgs -= n;
+}
+
+/* Hand queued messages to threads pending in k_msgq_get(). Threads only
+ * pend there while the ring is empty, so this only does work right
+ * after messages were added to an empty ring.
+ */
+static bool wake_readers(struct k_msgq *msgq)
+{
+	struct k_thread *thread;
+	bool woken = false;
+
+	while (msgq->used_msgs > 0) {
+		thread = z_unpend_first_thread(&msgq->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+		ring_get(msgq, thread->base.swap_data, 1);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+/* Move messages of threads pending in k_msgq_put() into freed slots */
+static bool wake_writers(struct k_msgq *msgq)
+{
+	struct k_thread *thread;
+	bool woken = false;
+
+	while (msgq->used_msgs < msgq->max_msgs) {
+		thread = z_unpend_first_thread(&msgq->wait_q);
+		if (thread == NULL) {
+			break;
+		}
+		ring_put(msgq, thread->base.swap_data, 1);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+/* Deliver up to @a num_msgs messages without blocking, first directly to
+ * waiting receivers and then into the ring. Called with the lock held.
+ */
+static uint32_t put_many(struct k_msgq *msgq, const char *src,
+			 uint32_t num_msgs, bool *woken)
+{
+	struct k_thread *thread;
+	uint32_t count = 0U;
+	uint32_t n;
+
+	if (msgq->used_msgs == 0U) {
+		while (count < num_msgs) {
+			thread = z_unpend_first_thread(&msgq->wait_q);
+			if (thread == NULL) {
+				break;
+			}
+			(void)memcpy(thread->base.swap_data, src,
+				     msgq->msg_size);
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+			src += msgq->msg_size;
+			count++;
+			*woken = true;
+		}
+	}
+
+	n = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+	if (n > 0U) {
+		ring_put(msgq, src, n);
+		count += n;
+	}
+
+	return count;
+}
+
+/* Receive up to @a num_msgs messages without blocking, refilling the ring
+ * from waiting senders as slots free up. Called with the lock held.
+ */
+static uint32_t get_many(struct k_msgq *msgq, char *dst, uint32_t num_msgs,
+			 bool *woken)
+{
+	uint32_t count = 0U;
+	uint32_t n;
+
+	while (count < num_msgs && msgq->used_msgs > 0U) {
+		n = MIN(num_msgs - count, msgq->used_msgs);
+		ring_get(msgq, dst, n);
+		dst += n * msgq->msg_size;
+		count += n;
+
+		if (!wake_writers(msgq)) {
+			break;
+		}
+		*woken = true;
+	}
+
+	return count;
+}
+
+int z_impl_k_msgq_put_batch(struct k_msgq *msgq, const void *data,
+			    uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t count;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	count = put_many(msgq, src, num_msgs, &woken);
+
+	if (count == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for room for the first message, then send whatever
+		 * else fits without waiting again
+		 */
+		_current->base.swap_data = (void *)src;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result != 0) {
+			return result;
+		}
+
+		count = 1U;
+		key = k_spin_lock(&msgq->lock);
+		count += put_many(msgq, src + msgq->msg_size, num_msgs - 1U,
+				  &woken);
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_batch(struct k_msgq *q, const void *data,
+					  uint32_t num_msgs,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_put_batch(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_batch_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_batch(struct k_msgq *msgq, void *data,
+			    uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t count;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	count = get_many(msgq, dst, num_msgs, &woken);
+
+	if (count == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		/* wait for the first message, then drain whatever else
+		 * arrived alongside it without waiting again
+		 */
+		_current->base.swap_data = dst;
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		if (result != 0) {
+			return result;
+		}
+
+		count = 1U;
+		key = k_spin_lock(&msgq->lock);
+		count += get_many(msgq, dst + msgq->msg_size, num_msgs - 1U,
+				  &woken);
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_batch(struct k_msgq *q, void *data,
+					  uint32_t num_msgs,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(q, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, q->msg_size));
+
+	return z_impl_k_msgq_get_batch(q, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_batch_mrsh.c>
+#endif
+
+/* Number of free slots following the write pointer before the ring wraps */
+static uint32_t contig_free(struct k_msgq *msgq)
+{
+	if (msgq->used_msgs == msgq->max_msgs) {
+		return 0U;
+	}
+	if (msgq->write_ptr < msgq->read_ptr) {
+		return (msgq->read_ptr - msgq->write_ptr) / msgq->msg_size;
+	}
+	return (msgq->buffer_end - msgq->write_ptr) / msgq->msg_size;
+}
+
+/* Number of queued messages following the read pointer before the wrap */
+static uint32_t contig_used(struct k_msgq *msgq)
+{
+	if (msgq->used_msgs == 0U) {
+		return 0U;
+	}
+	if (msgq->read_ptr < msgq->write_ptr) {
+		return (msgq->write_ptr - msgq->read_ptr) / msgq->msg_size;
+	}
+	return (msgq->buffer_end - msgq->read_ptr) / msgq->msg_size;
+}
+
+uint32_t k_msgq_put_claim(struct k_msgq *msgq, void **data, uint32_t num_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	uint32_t n = MIN(num_msgs, contig_free(msgq));
+
+	*data = msgq->write_ptr;
+	k_spin_unlock(&msgq->lock, key);
+
+	return n;
+}
+
+int k_msgq_put_commit(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	CHECKIF(num_msgs > contig_free(msgq)) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->write_ptr += num_msgs * msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs += num_msgs;
+
+	if (wake_readers(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+uint32_t k_msgq_get_claim(struct k_msgq *msgq, void **data, uint32_t num_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	uint32_t n = MIN(num_msgs, contig_used(msgq));
+
+	*data = msgq->read_ptr;
+	k_spin_unlock(&msgq->lock, key);
+
+	return n;
+}
+
+int k_msgq_get_commit(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	CHECKIF(num_msgs > contig_used(msgq)) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->read_ptr += num_msgs * msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs -= num_msgs;
+
+	if (wake_writers(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -116,6 +116,83 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+/* must be called with the lock held */
+static bool try_take(struct k_mutex *mutex)
+{
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current)) {
+		return false;
+	}
+
+	mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+				_current->base.prio :
+				mutex->owner_orig_prio;
+
+	mutex->lock_count++;
+	mutex->owner = _current;
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+
+	return true;
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static bool owner_is_running(struct k_thread *owner)
+{
+	/* Racy by design: the answer is only a hint for how long to
+	 * keep spinning, the mutex state is re-checked under the lock.
+	 */
+	return _kernel.cpus[owner->base.cpu].current == owner;
+}
+
+/*
+ * Spin while the owner runs on another CPU, in the hope that it
+ * releases the mutex before a context switch would have completed.
+ *
+ * Spinning stops as soon as the owner is switched out (it may then
+ * need priority inheritance, which only the pend path provides), when
+ * ownership is handed to a pended waiter, or after
+ * CONFIG_MUTEX_ADAPTIVE_SPIN_US. Threads already waiting are never
+ * overtaken: unlock hands the mutex to them directly, so only an
+ * uncontended wait queue is worth spinning on.
+ *
+ * Called and returns with the lock held; true if the mutex was taken.
+ */
+static bool spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	struct k_thread *owner = mutex->owner;
+	uint32_t start, limit;
+
+	if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+	    !owner_is_running(owner)) {
+		return false;
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	start = k_cycle_get_32();
+	limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+
+	while ((*(struct k_thread * volatile *)&mutex->owner == owner) &&
+	       owner_is_running(owner) &&
+	       ((k_cycle_get_32() - start) < limit)) {
+		arch_nop();
+		compiler_barrier();
+	}
+
+	*key = k_spin_lock(&lock);
+
+	return try_take(mutex);
+}
+#else
+static inline bool spin_on_owner(struct k_mutex *mutex,
+				 k_spinlock_key_t *key)
+{
+	return false;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -127,19 +204,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	sys_trace_mutex_lock(mutex);
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
-
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
-
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
-
+	if (likely(try_take(mutex))) {
 		k_spin_unlock(&lock, key);
 		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
 
@@ -152,6 +217,13 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+	if (spin_on_owner(mutex, &key)) {
+		k_spin_unlock(&lock, key);
+		sys_trace_end_call(SYS_TRACE_ID_MUTEX_LOCK);
+
+		return 0;
+	}
+
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
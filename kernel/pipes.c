@@ -875,3 +875,140 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+/**
+ * @brief Number of free bytes following the write index before the wrap
+ */
+static size_t pipe_contig_free(struct k_pipe *pipe)
+{
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+/**
+ * @brief Number of used bytes following the read index before the wrap
+ */
+static size_t pipe_contig_used(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t claimed = MIN(size, pipe_contig_free(pipe));
+
+	*data = pipe->buffer + pipe->write_index;
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                woken = false;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(size > pipe_contig_free(pipe)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait while the buffer is empty, so hand the new data
+	 * to them in order. A reader that is not fully satisfied stays on
+	 * the wait_q, as it would with k_pipe_put().
+	 */
+	while ((pipe->bytes_used > 0) &&
+	       ((reader = z_waitq_head(&pipe->wait_q.readers)) != NULL)) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(reader);
+		z_ready_thread(reader);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, uint8_t **data, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t claimed = MIN(size, pipe_contig_used(pipe));
+
+	*data = pipe->buffer + pipe->read_index;
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                woken = false;
+	k_spinlock_key_t    key = k_spin_lock(&pipe->lock);
+
+	CHECKIF(size > pipe_contig_used(pipe)) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/* Writers only wait while the buffer is full; refill it from them */
+	while ((pipe->bytes_used < pipe->size) &&
+	       ((writer = z_waitq_head(&pipe->wait_q.writers)) != NULL)) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0) {
+			break;
+		}
+
+		z_unpend_thread(writer);
+		pipe_thread_ready(writer);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -93,6 +94,22 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Persistent poll sets have no thread of their own: they queue behind
+ * every thread polling the same object, in registration order.
+ */
+static bool poller_is_before(struct z_poller *p1, struct z_poller *p2)
+{
+	if (p2->mode == MODE_SET) {
+		return p1->mode != MODE_SET;
+	}
+	if (p1->mode == MODE_SET) {
+		return false;
+	}
+
+	return z_is_t1_higher_prio_than_t2(poller_thread(p1),
+					   poller_thread(p2));
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
@@ -100,15 +117,13 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
 	if ((pending == NULL) ||
-	    z_is_t1_higher_prio_than_t2(poller_thread(pending->poller),
-					poller_thread(poller))) {
+	    !poller_is_before(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_is_t1_higher_prio_than_t2(poller_thread(poller),
-					poller_thread(pending->poller))) {
+		if (poller_is_before(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -128,6 +143,10 @@ static inline int register_event(struct k_poll_event *event,
 		break;
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
+#ifdef CONFIG_QUEUE_MPSC
+		__ASSERT(event->queue->mpsc_mode == Z_QUEUE_MPSC_NONE,
+			 "lock-free queues cannot be polled\n");
+#endif
 		add_event(&event->queue->poll_events, event, poller);
 		break;
 	case K_POLL_TYPE_SIGNAL:
@@ -394,6 +413,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller) {
+		if (poller->mode == MODE_SET) {
+			signal_set(event, state);
+			return 0;
+		}
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
@@ -413,12 +437,22 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
-	struct k_poll_event *poll_event;
+	struct k_poll_event *poll_event, *next;
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
 		(void) signal_poll_event(poll_event, state);
 	}
+
+	/* Poll sets never consume the object, so all of them are told and
+	 * not only the first poller. They queue behind the threads.
+	 */
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(events, poll_event, next, _node) {
+		if (poll_event->poller->mode == MODE_SET) {
+			sys_dlist_remove(&poll_event->_node);
+			signal_set(poll_event, state);
+		}
+	}
 }
 
 void z_impl_k_poll_signal_init(struct k_poll_signal *signal)
@@ -465,13 +499,27 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *signal, int result)
 	signal->result = result;
 	signal->signaled = 1U;
 
+	/* The signal stays raised until it is reset, so every poller is
+	 * told, threads and poll sets alike.
+	 */
 	poll_event = (struct k_poll_event *)sys_dlist_get(&signal->poll_events);
 	if (poll_event == NULL) {
 		k_spin_unlock(&lock, key);
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	int rc = 0;
+
+	do {
+		int ret = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+
+		if (rc == 0) {
+			rc = ret;
+		}
+
+		poll_event = (struct k_poll_event *)
+			sys_dlist_get(&signal->poll_events);
+	} while (poll_event != NULL);
 
 	z_reschedule(&lock, key);
 	return rc;
@@ -702,3 +750,175 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* must be called with interrupts locked */
+static void signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+	struct k_thread *thread;
+
+	/* The object already unlinked the event from its own list */
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	while ((thread = z_unpend_first_thread(&set->wait_q)) != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/* must be called with interrupts locked */
+static void set_arm_event(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->state = state;
+		sys_dlist_append(&set->ready, &event->_node);
+	} else {
+		(void)register_event(event, &set->poller);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->rearm);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	event->poller = &set->poller;
+	set_arm_event(set, event);
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* Whichever list it is on: the object's, ready or rearm */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+void k_poll_set_refresh(struct k_poll_set *set, struct k_poll_event *events,
+			int num_events)
+{
+	k_spinlock_key_t key;
+	uint32_t state;
+
+	for (int i = 0; i < num_events; i++) {
+		struct k_poll_event *event = &events[i];
+
+		key = k_spin_lock(&lock);
+
+		/* Events on the ready or rearm list are not NOT_READY, the
+		 * others wait on their object's list.
+		 */
+		if (event->poller == &set->poller &&
+		    event->state == K_POLL_STATE_NOT_READY &&
+		    is_condition_met(event, &state)) {
+			if (sys_dnode_is_linked(&event->_node)) {
+				sys_dlist_remove(&event->_node);
+			}
+			event->state = state;
+			sys_dlist_append(&set->ready, &event->_node);
+		}
+
+		k_spin_unlock(&lock, key);
+	}
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout)
+{
+	uint64_t end = z_timeout_end_calc(timeout);
+	struct k_poll_event *event;
+	k_spinlock_key_t key;
+	uint32_t state;
+	int64_t left;
+	int count = 0;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	key = k_spin_lock(&lock);
+
+	/* Only the events handed out last time need checking again; all
+	 * the others are still registered with their objects.
+	 */
+	while ((event = (struct k_poll_event *)
+			sys_dlist_get(&set->rearm)) != NULL) {
+		set_arm_event(set, event);
+	}
+
+	while (true) {
+		while (count < max_events) {
+			event = (struct k_poll_event *)
+				sys_dlist_get(&set->ready);
+			if (event == NULL) {
+				break;
+			}
+
+			/* The object may have been drained since it
+			 * signaled; cancellations are always reported.
+			 */
+			if (((event->state & K_POLL_STATE_CANCELLED) == 0U) &&
+			    !is_condition_met(event, &state)) {
+				event->state = K_POLL_STATE_NOT_READY;
+				(void)register_event(event, &set->poller);
+				continue;
+			}
+
+			sys_dlist_append(&set->rearm, &event->_node);
+			ready[count++] = event;
+		}
+
+		if (count > 0 || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			left = (int64_t)(end - z_tick_get());
+			if (left <= 0) {
+				break;
+			}
+			timeout = K_TICKS(left);
+		}
+
+		(void)z_pend_curr(&lock, key, &set->wait_q, timeout);
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return (count > 0) ? count : -EAGAIN;
+}
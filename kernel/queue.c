@@ -81,6 +81,11 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_MPSC
+	atomic_ptr_clear(&queue->mpsc_inbox);
+	atomic_clear(&queue->mpsc_waiters);
+	queue->mpsc_mode = Z_QUEUE_MPSC_NONE;
+#endif
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -104,6 +109,111 @@ static void prepare_thread_to_run(struct k_thread *thread, void *data)
 	z_ready_thread(thread);
 }
 
+#ifdef CONFIG_QUEUE_MPSC
+void z_queue_mpsc_init(struct k_queue *queue, uint8_t mode)
+{
+	k_queue_init(queue);
+	queue->mpsc_mode = mode;
+}
+
+/* Moves the items published by lock-free producers onto data_q, in
+ * queue order.  Returns false if there were none.  Queue lock must be
+ * held.
+ */
+static bool mpsc_drain(struct k_queue *queue)
+{
+	sys_sfnode_t *node = atomic_ptr_set(&queue->mpsc_inbox, NULL);
+
+	if (node == NULL) {
+		return false;
+	}
+
+	if (queue->mpsc_mode == Z_QUEUE_MPSC_LIFO) {
+		/* The inbox is newest first, which is LIFO order
+		 * already: splice it in front of the older items.
+		 */
+		sys_sfnode_t *prev = NULL;
+
+		while (node != NULL) {
+			sys_sfnode_t *next = *(sys_sfnode_t **)node;
+
+			sys_sfnode_init(node, 0x0);
+			sys_sflist_insert(&queue->data_q, prev, node);
+			prev = node;
+			node = next;
+		}
+	} else {
+		/* Reverse into arrival order and append */
+		sys_sfnode_t *head = NULL, *tail = node;
+
+		while (node != NULL) {
+			sys_sfnode_t *next = *(sys_sfnode_t **)node;
+
+			*(sys_sfnode_t **)node = head;
+			head = node;
+			node = next;
+		}
+		sys_sflist_append_list(&queue->data_q, head, tail);
+	}
+
+	return true;
+}
+
+void z_queue_mpsc_flush(struct k_queue *queue)
+{
+	if (atomic_ptr_get(&queue->mpsc_inbox) != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+		(void)mpsc_drain(queue);
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+
+/* Lock-free put.  The consumer registers in mpsc_waiters before its
+ * last look at the inbox and pending, and we check it after our push,
+ * so (both being sequentially consistent) either it sees our item or
+ * we see it waiting and take the lock to wake it.
+ */
+static void mpsc_push(struct k_queue *queue, void *data)
+{
+	void *head;
+
+	do {
+		head = atomic_ptr_get(&queue->mpsc_inbox);
+		*(void **)data = head;
+	} while (!atomic_ptr_cas(&queue->mpsc_inbox, head, data));
+
+	if (atomic_get(&queue->mpsc_waiters) != 0) {
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
+		struct k_thread *thread;
+
+		(void)mpsc_drain(queue);
+		while (!sys_sflist_is_empty(&queue->data_q)) {
+			thread = z_unpend_first_thread(&queue->wait_q);
+			if (thread == NULL) {
+				break;
+			}
+			prepare_thread_to_run(thread, z_queue_node_peek(
+				sys_sflist_get_not_empty(&queue->data_q),
+				true));
+		}
+		z_reschedule(&queue->lock, key);
+	}
+}
+
+static inline bool mpsc_push_ok(struct k_queue *queue, void *prev,
+				bool alloc, bool is_append)
+{
+	if (alloc) {
+		return false;
+	}
+
+	return (is_append && queue->mpsc_mode == Z_QUEUE_MPSC_FIFO) ||
+	       (!is_append && prev == NULL &&
+		queue->mpsc_mode == Z_QUEUE_MPSC_LIFO);
+}
+#endif /* CONFIG_QUEUE_MPSC */
+
 static inline void handle_poll_events(struct k_queue *queue, uint32_t state)
 {
 #ifdef CONFIG_POLL
@@ -139,7 +249,20 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 			    bool alloc, bool is_append)
 {
 	struct k_thread *first_pending_thread;
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_QUEUE_MPSC
+	if (mpsc_push_ok(queue, prev, alloc, is_append)) {
+		mpsc_push(queue, data);
+		return 0;
+	}
+#endif
+
+	key = k_spin_lock(&queue->lock);
+
+#ifdef CONFIG_QUEUE_MPSC
+	(void)mpsc_drain(queue);
+#endif
 
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
@@ -230,6 +353,10 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+#ifdef CONFIG_QUEUE_MPSC
+	(void)mpsc_drain(queue);
+#endif
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -281,6 +408,10 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	void *data;
 
+#ifdef CONFIG_QUEUE_MPSC
+	(void)mpsc_drain(queue);
+#endif
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -295,6 +426,29 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_MPSC
+	if (queue->mpsc_mode != Z_QUEUE_MPSC_NONE) {
+		/* Make lock-free producers take the lock from now on,
+		 * then look once more for anything pushed before they
+		 * could notice.
+		 */
+		atomic_inc(&queue->mpsc_waiters);
+		if (mpsc_drain(queue)) {
+			atomic_dec(&queue->mpsc_waiters);
+			data = z_queue_node_peek(
+				sys_sflist_get_not_empty(&queue->data_q), true);
+			k_spin_unlock(&queue->lock, key);
+			return data;
+		}
+
+		int ret = z_pend_curr(&queue->lock, key, &queue->wait_q,
+				      timeout);
+
+		atomic_dec(&queue->mpsc_waiters);
+		return (ret != 0) ? NULL : _current->base.swap_data;
+	}
+#endif
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
 	return (ret != 0) ? NULL : _current->base.swap_data;
@@ -19,7 +19,33 @@
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+/* Hierarchical timing wheel.  A pending timeout stores its absolute
+ * expiry tick in dticks and lives in the slot of the highest level at
+ * which that tick differs from curr_tick, indexed by the expiry's
+ * digit at that level.  A slot is "visited" when curr_tick reaches
+ * its start (the expiry with all lower-level digits cleared), at
+ * which point its timeouts either expire (level 0) or are re-hashed
+ * into a lower level.  The occupied bitmaps are cleared lazily: an
+ * abort only unlinks the node and the bit is dropped the next time
+ * the slot is found empty.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+static struct {
+	uint64_t occupied[WHEEL_LEVELS];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+} wheel;
+
+/* Timeouts whose expiry has been reached by z_clock_announce() but
+ * whose handlers have not been called yet
+ */
+static sys_dlist_t expired_list = SYS_DLIST_STATIC_INIT(&expired_list);
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -41,6 +67,134 @@ static inline int z_vrfy_z_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	return announce_remaining == 0 ? z_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static inline int wheel_digit(uint64_t tick, int level)
+{
+	return (tick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+}
+
+/* First tick after curr_tick at which a slot is visited */
+static uint64_t wheel_visit(int level, int slot)
+{
+	uint64_t span = BIT64(WHEEL_BITS * level);
+	uint64_t cycle = span << WHEEL_BITS;
+	uint64_t t = (curr_tick & ~(cycle - 1)) + slot * span;
+
+	return t <= curr_tick ? t + cycle : t;
+}
+
+/* Hashes a timeout into the wheel relative to curr_tick, returning
+ * the tick at which its slot will be visited
+ */
+static uint64_t wheel_insert(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+
+	if (expiry <= curr_tick) {
+		sys_dlist_append(&expired_list, &t->node);
+		return curr_tick;
+	}
+
+	int level = MIN((63 - __builtin_clzll(expiry ^ curr_tick)) / WHEEL_BITS,
+			WHEEL_LEVELS - 1);
+	int slot = wheel_digit(expiry, level);
+	sys_dlist_t *list = &wheel.slots[level][slot];
+
+	if ((wheel.occupied[level] & BIT64(slot)) == 0U) {
+		sys_dlist_init(list);
+		wheel.occupied[level] |= BIT64(slot);
+	}
+	sys_dlist_append(list, &t->node);
+
+	return wheel_visit(level, slot);
+}
+
+/* Tick at which the next occupied slot is visited, UINT64_MAX if the
+ * wheel is empty
+ */
+static uint64_t wheel_next(void)
+{
+	uint64_t ret = UINT64_MAX;
+
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		uint64_t later = ~0ULL << wheel_digit(curr_tick, level) << 1;
+
+		while (wheel.occupied[level] != 0U) {
+			uint64_t occ = wheel.occupied[level];
+			int slot = __builtin_ctzll((occ & later) != 0U ?
+						   (occ & later) : occ);
+
+			if (sys_dlist_is_empty(&wheel.slots[level][slot])) {
+				wheel.occupied[level] &= ~BIT64(slot);
+				continue;
+			}
+
+			ret = MIN(ret, wheel_visit(level, slot));
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/* Visits every slot that starts at curr_tick, highest level first.
+ * The timeouts of a visited slot expire within its span, so they
+ * cascade down into the lower level slots still to be visited, or
+ * onto expired_list if due now.  Only top level timeouts that are
+ * still out of range stay at their level.
+ */
+static void wheel_cascade(void)
+{
+	for (int level = WHEEL_LEVELS - 1; level >= 0; level--) {
+		uint64_t span = BIT64(WHEEL_BITS * level);
+		int slot = wheel_digit(curr_tick, level);
+		sys_dlist_t due;
+		sys_dnode_t *node;
+
+		if ((curr_tick & (span - 1U)) != 0U ||
+		    (wheel.occupied[level] & BIT64(slot)) == 0U) {
+			continue;
+		}
+
+		/* Detach the slot first: top level timeouts that are still
+		 * out of range hash right back into it
+		 */
+		sys_dlist_init(&due);
+		while ((node = sys_dlist_get(&wheel.slots[level][slot])) != NULL) {
+			sys_dlist_append(&due, node);
+		}
+		wheel.occupied[level] &= ~BIT64(slot);
+
+		while ((node = sys_dlist_get(&due)) != NULL) {
+			uint64_t visit = wheel_insert(CONTAINER_OF(node,
+						struct _timeout, node));
+
+			__ASSERT(level == WHEEL_LEVELS - 1 ||
+				 visit < curr_tick + span,
+				 "timeout outside of its slot");
+			ARG_UNUSED(visit);
+		}
+	}
+}
+
+static struct _timeout *first_expired(void)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&expired_list);
+
+	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_remove(&t->node);
+}
+
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -64,17 +218,22 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
-{
-	return announce_remaining == 0 ? z_clock_elapsed() : 0U;
-}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t next = wheel_next();
+	int32_t ret = !sys_dlist_is_empty(&expired_list) ? 0
+		: next == UINT64_MAX ? MAX_WAIT
+		: CLAMP((int64_t)(next - curr_tick) - ticks_elapsed,
+			0, MAX_WAIT);
+#else
+	struct _timeout *to = first();
 	int32_t ret = to == NULL ? MAX_WAIT
 		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+#endif
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -110,6 +269,13 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	ticks = MAX(1, ticks);
 
 	LOCKED(&timeout_lock) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		to->dticks = curr_tick + elapsed() + ticks;
+
+		if (wheel_insert(to) == wheel_next()) {
+			z_clock_set_timeout(next_timeout(), false);
+		}
+#else
 		struct _timeout *t;
 
 		to->dticks = ticks + elapsed();
@@ -129,6 +295,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			z_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -155,12 +322,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -231,6 +402,35 @@ void z_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t target = curr_tick + ticks;
+
+	while (true) {
+		struct _timeout *t = first_expired();
+
+		if (t == NULL) {
+			uint64_t next = wheel_next();
+
+			if (next > target) {
+				break;
+			}
+
+			curr_tick = next;
+			announce_remaining = target - next;
+			wheel_cascade();
+			continue;
+		}
+
+		t->dticks = 0;
+		remove_timeout(t);
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+	}
+
+	curr_tick = target;
+#else
 	while (first() != NULL && first()->dticks <= announce_remaining) {
 		struct _timeout *t = first();
 		int dt = t->dticks;
@@ -250,6 +450,7 @@ void z_clock_announce(int32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif
 	announce_remaining = 0;
 
 	z_clock_set_timeout(next_timeout(), false);
@@ -167,6 +167,17 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	free_chunk(h, c);
 }
 
+size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+	chunkid_t c = mem_to_chunkid(h, mem);
+	size_t addr = (size_t)mem;
+	size_t chunk_base = (size_t)&chunk_buf(h)[c];
+	size_t chunk_sz = chunk_size(h, c) * CHUNK_UNIT;
+
+	return chunk_sz - (addr - chunk_base);
+}
+
 static chunkid_t alloc_chunk(struct z_heap *h, size_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -244,6 +255,43 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	return chunk_mem(h, c);
 }
 
+/* Looks for a free chunk whose memory already has the requested
+ * alignment, so that nothing needs to be over-allocated and split
+ * off again.  Like alloc_chunk(), the search is bounded: at most
+ * CONFIG_SYS_HEAP_ALLOC_LOOPS candidates are examined, starting with
+ * the smallest bucket that might fit.
+ */
+static chunkid_t alloc_chunk_aligned(struct z_heap *h, size_t sz,
+				     size_t align)
+{
+	int bi = bucket_idx(h, sz);
+	size_t bmask = h->avail_buckets & ~((1 << bi) - 1);
+	int i = CONFIG_SYS_HEAP_ALLOC_LOOPS;
+
+	if (bi > bucket_idx(h, h->len)) {
+		return 0;
+	}
+
+	while (bmask != 0U && i > 0) {
+		int b = __builtin_ctz(bmask);
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+
+		do {
+			if (chunk_size(h, c) >= sz &&
+			    ((uintptr_t)chunk_mem(h, c) & (align - 1)) == 0U) {
+				free_list_remove_bidx(h, c, b);
+				return c;
+			}
+			c = next_free_chunk(h, c);
+		} while (--i > 0 && c != first);
+
+		bmask &= bmask - 1;
+	}
+
+	return 0;
+}
+
 void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -257,6 +305,20 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		return NULL;
 	}
 
+	/* Fast path: use a free chunk that happens to be aligned */
+	size_t chunk_sz = bytes_to_chunksz(h, bytes);
+	chunkid_t c = alloc_chunk_aligned(h, chunk_sz, align);
+
+	if (c != 0) {
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
+
+		set_chunk_used(h, c, true);
+		return chunk_mem(h, c);
+	}
+
 	/*
 	 * Find a free block that is guaranteed to fit.
 	 * We over-allocate to account for alignment and then free
@@ -275,7 +337,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunk_unit_t *end = (chunk_unit_t *) ROUND_UP(mem + bytes, CHUNK_UNIT);
 
 	/* Get corresponding chunks */
-	chunkid_t c = mem_to_chunkid(h, mem);
+	c = mem_to_chunkid(h, mem);
 	chunkid_t c_end = end - chunk_buf(h);
 	CHECK(c >= c0 && c  < c_end && c_end <= c0 + padded_sz);
 
@@ -335,6 +397,38 @@ void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 		merge_chunks(h, c, rc);
 		set_chunk_used(h, c, true);
 		return ptr;
+	}
+
+	/* Only the old contents need to survive a move */
+	size_t copy_bytes = MIN(bytes, sys_heap_usable_size(heap, ptr));
+	chunkid_t lc = left_chunk(h, c);
+
+	if (!chunk_used(h, lc) &&
+	    (chunk_size(h, lc) + chunk_size(h, c) +
+	     (chunk_used(h, rc) ? 0 : chunk_size(h, rc)) >= chunks_need)) {
+		/* Expand: absorb the free left (and right) neighbors and
+		 * slide the data down, which avoids searching for a new
+		 * block and leaves the heap less fragmented than a copy
+		 * elsewhere would.
+		 */
+		free_list_remove(h, lc);
+		if (!chunk_used(h, rc)) {
+			free_list_remove(h, rc);
+			merge_chunks(h, c, rc);
+		}
+		merge_chunks(h, lc, c);
+
+		void *ptr2 = chunk_mem(h, lc);
+
+		memmove(ptr2, ptr, copy_bytes);
+
+		if (chunk_size(h, lc) > chunks_need) {
+			split_chunks(h, lc, lc + chunks_need);
+			free_list_add(h, lc + chunks_need);
+		}
+
+		set_chunk_used(h, lc, true);
+		return ptr2;
 	} else {
 		/* Reallocate and copy */
 		void *ptr2 = sys_heap_alloc(heap, bytes);
@@ -343,12 +437,59 @@ void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 			return NULL;
 		}
 
-		memcpy(ptr2, ptr, bytes);
+		memcpy(ptr2, ptr, copy_bytes);
 		sys_heap_free(heap, ptr);
 		return ptr2;
 	}
 }
 
+int sys_heap_runtime_stats_get(struct sys_heap *heap,
+			       struct sys_heap_runtime_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	size_t max_chunk = 0;
+
+	*stats = (struct sys_heap_runtime_stats) {
+		.nb_buckets = bucket_idx(h, h->len) + 1,
+	};
+
+	for (int b = 0; b < stats->nb_buckets; b++) {
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+
+		if (first == 0U) {
+			continue;
+		}
+
+		do {
+			size_t sz = chunk_size(h, c);
+
+			stats->bucket_free_bytes[b] += sz * CHUNK_UNIT;
+			stats->free_chunks++;
+			max_chunk = MAX(max_chunk, sz);
+			c = next_free_chunk(h, c);
+		} while (c != first);
+
+		stats->free_bytes += stats->bucket_free_bytes[b];
+	}
+
+	/* Everything but chunk0 (the heap metadata) and the free
+	 * chunks is allocated
+	 */
+	stats->allocated_bytes = (h->len - chunk_size(h, 0)) * CHUNK_UNIT
+				 - stats->free_bytes;
+	if (max_chunk != 0U) {
+		stats->max_free_bytes = max_chunk * CHUNK_UNIT
+					- chunk_header_bytes(h);
+	}
+
+	return 0;
+}
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	/* Must fit in a 32 bit count of HUNK_UNIT */
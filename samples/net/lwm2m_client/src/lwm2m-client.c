@@ -186,6 +186,9 @@ static int firmware_update_cb(uint16_t obj_inst_id,
 #endif
 
 
+/* Sensor Value resource of the temperature object, resolved once */
+static struct lwm2m_res_handle temperature_handle;
+
 static void *temperature_get_buf(uint16_t obj_inst_id, uint16_t res_id,
 				 uint16_t res_inst_id, size_t *data_len)
 {
@@ -208,7 +211,7 @@ static void *temperature_get_buf(uint16_t obj_inst_id, uint16_t res_id,
 	}
 
 	/* echo the value back through the engine to update min/max values */
-	lwm2m_engine_set_float32("3303/0/5700", &v);
+	lwm2m_engine_set_by_handle(&temperature_handle, &v, sizeof(v));
 	*data_len = sizeof(v);
 	return &v;
 }
@@ -351,6 +354,12 @@ static int lwm2m_setup(void)
 
 	/* setup TEMP SENSOR object */
 	lwm2m_engine_create_obj_inst("3303/0");
+	ret = lwm2m_engine_resolve_path("3303/0/5700", &temperature_handle);
+	if (ret < 0) {
+		LOG_ERR("Cannot resolve temperature value (%d)", ret);
+		return ret;
+	}
+
 	lwm2m_engine_register_read_callback("3303/0/5700", temperature_get_buf);
 
 	/* IPSO: Light Control object */
@@ -1295,23 +1295,8 @@ static struct coap_resource resources[] = {
 	{ },
 };
 
-static struct coap_resource *find_resouce_by_observer(
-		struct coap_resource *resources, struct coap_observer *o)
-{
-	struct coap_resource *r;
-
-	for (r = resources; r && r->path; r++) {
-		sys_snode_t *node;
-
-		SYS_SLIST_FOR_EACH_NODE(&r->observers, node) {
-			if (&o->list == node) {
-				return r;
-			}
-		}
-	}
-
-	return NULL;
-}
+/* One node for the root and one per distinct path prefix above */
+COAP_RESOURCE_TREE_DEFINE(resource_tree, 24);
 
 static void process_coap_request(uint8_t *data, uint16_t data_len,
 				 struct sockaddr *client_addr,
@@ -1324,7 +1309,8 @@ static void process_coap_request(uint8_t *data, uint16_t data_len,
 	uint8_t type;
 	int r;
 
-	r = coap_packet_parse(&request, data, data_len, options, opt_num);
+	r = coap_packet_parse_indexed(&request, data, data_len, options,
+				      opt_num);
 	if (r < 0) {
 		LOG_ERR("Invalid data received (%d)\n", r);
 		return;
@@ -1358,7 +1344,7 @@ not_found:
 			goto end;
 		}
 
-		r = find_resouce_by_observer(resources, o);
+		r = o->resource;
 		if (!r) {
 			LOG_ERR("Observer found but Resource not found\n");
 			goto end;
@@ -1370,8 +1356,8 @@ not_found:
 	}
 
 end:
-	r = coap_handle_request(&request, resources, options, opt_num,
-				client_addr, client_addr_len);
+	r = coap_handle_request_tree(&request, &resource_tree, options,
+				     opt_num, client_addr, client_addr_len);
 	if (r < 0) {
 		LOG_WRN("No handler for such request (%d)\n", r);
 	}
@@ -1415,6 +1401,12 @@ void main(void)
 	}
 #endif
 
+	r = coap_resource_tree_build(&resource_tree, resources);
+	if (r < 0) {
+		LOG_ERR("Failed to build resource tree (%d)", r);
+		goto quit;
+	}
+
 	r = start_coap_server();
 	if (r < 0) {
 		goto quit;
@@ -59,6 +59,78 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connections with remote address and both ports specified are also
+ * kept in a hash table keyed by those, the rest in conn_wildcard.
+ * Unicast UDP/TCP packets are looked up in the table first and only
+ * the wildcard handlers are scanned if that fails.
+ */
+#define NET_CONN_HASHED (NET_CONN_REMOTE_ADDR_SPEC | \
+			 NET_CONN_REMOTE_PORT_SPEC | \
+			 NET_CONN_LOCAL_PORT_SPEC)
+
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+
+/* Ports are in network byte order, the address may be unaligned */
+static sys_slist_t *conn_hash_bucket(uint16_t proto, sa_family_t family,
+				     const void *remote_addr,
+				     uint16_t remote_port,
+				     uint16_t local_port)
+{
+	uint32_t hash = proto ^ ((uint32_t)remote_port << 16) ^ local_port;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		const struct in6_addr *addr6 = remote_addr;
+
+		for (int i = 0; i < 4; i++) {
+			hash ^= UNALIGNED_GET(&addr6->s6_addr32[i]);
+		}
+	} else {
+		const struct in_addr *addr4 = remote_addr;
+
+		hash ^= UNALIGNED_GET(&addr4->s_addr);
+	}
+
+	/* Fibonacci hashing spreads the low entropy bits of the key */
+	hash *= 0x9e3779b1U;
+
+	return &conn_hash[(hash >> 16) % CONFIG_NET_CONN_HASH_BUCKETS];
+}
+
+static sys_slist_t *conn_lookup_list(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_HASHED) != NET_CONN_HASHED ||
+	    (conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) ||
+	    (conn->family != AF_INET && conn->family != AF_INET6)) {
+		return &conn_wildcard;
+	}
+
+	if (conn->family == AF_INET6) {
+		return conn_hash_bucket(conn->proto, conn->family,
+					&net_sin6(&conn->remote_addr)->sin6_addr,
+					net_sin(&conn->remote_addr)->sin_port,
+					net_sin(&conn->local_addr)->sin_port);
+	}
+
+	return conn_hash_bucket(conn->proto, conn->family,
+				&net_sin(&conn->remote_addr)->sin_addr,
+				net_sin(&conn->remote_addr)->sin_port,
+				net_sin(&conn->local_addr)->sin_port);
+}
+
+static struct net_conn *conn_from_node(sys_slist_t *list, sys_snode_t *node)
+{
+	if (list == &conn_wildcard) {
+		return CONTAINER_OF(node, struct net_conn, lookup_node);
+	}
+
+	return CONTAINER_OF(node, struct net_conn, node);
+}
+#else
+#define conn_from_node(list, _node) CONTAINER_OF(_node, struct net_conn, node)
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -132,6 +204,10 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_prepend(conn_lookup_list(conn), &conn->lookup_node);
+#endif
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -379,6 +455,10 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_find_and_remove(conn_lookup_list(conn), &conn->lookup_node);
+#endif
+
 	conn_set_unused(conn);
 
 	return 0;
@@ -457,6 +537,56 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* The most recently registered matching handler wins, as it would if
+ * conn_used was scanned: all of these have the remote port specified.
+ */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port,
+				       uint16_t dst_port)
+{
+	sa_family_t family = net_pkt_family(pkt);
+	struct net_conn *conn;
+	sys_slist_t *bucket;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		bucket = conn_hash_bucket(proto, family, &ip_hdr->ipv6->src,
+					  src_port, dst_port);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		bucket = conn_hash_bucket(proto, family, &ip_hdr->ipv4->src,
+					  src_port, dst_port);
+	} else {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, lookup_node) {
+		if (conn->proto != proto || conn->family != family) {
+			continue;
+		}
+
+		if (net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port) {
+			continue;
+		}
+
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			continue;
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			continue;
+		}
+
+		return conn;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
@@ -516,7 +646,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	int16_t best_rank = -1;
+	sys_slist_t *candidates = &conn_used;
 	struct net_conn *conn;
+	sys_snode_t *node;
 	uint16_t src_port;
 	uint16_t dst_port;
 
@@ -580,7 +712,22 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+#if defined(CONFIG_NET_CONN_HASH)
+	if (!is_mcast_pkt && !is_bcast_pkt &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP)) {
+		best_match = conn_hash_find(pkt, ip_hdr, proto, src_port,
+					    dst_port);
+		if (best_match) {
+			goto deliver;
+		}
+
+		candidates = &conn_wildcard;
+	}
+#endif
+
+	SYS_SLIST_FOR_EACH_NODE(candidates, node) {
+		conn = conn_from_node(candidates, node);
+
 		/* For packet socket data, the proto is set to ETH_P_ALL but
 		 * the listener might have a specific protocol set. This is ok
 		 * and let the packet pass this check in this case.
@@ -730,6 +877,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+deliver:
+#endif
 	conn = best_match;
 	if (conn) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x",
@@ -790,6 +940,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
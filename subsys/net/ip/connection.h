@@ -50,6 +50,11 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Node in the hash bucket or the wildcard list */
+	sys_snode_t lookup_node;
+#endif
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
@@ -30,7 +30,8 @@ struct net_icmpv4_hdr_opts_data {
 	const struct in_addr *src;
 };
 
-static int icmpv4_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_code)
+static int icmpv4_create_chksum(struct net_pkt *pkt, uint8_t icmp_type,
+				uint8_t icmp_code, uint16_t chksum)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmpv4_access,
 					      struct net_icmp_hdr);
@@ -43,11 +44,16 @@ static int icmpv4_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_co
 
 	icmp_hdr->type   = icmp_type;
 	icmp_hdr->code   = icmp_code;
-	icmp_hdr->chksum = 0U;
+	icmp_hdr->chksum = chksum;
 
 	return net_pkt_set_data(pkt, &icmpv4_access);
 }
 
+static int icmpv4_create(struct net_pkt *pkt, uint8_t icmp_type, uint8_t icmp_code)
+{
+	return icmpv4_create_chksum(pkt, icmp_type, icmp_code, 0U);
+}
+
 int net_icmpv4_finalize(struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmpv4_access,
@@ -414,6 +420,7 @@ static enum net_verdict icmpv4_handle_echo_request(struct net_pkt *pkt,
 	struct net_pkt *reply = NULL;
 	const struct in_addr *src;
 	int16_t payload_len;
+	uint16_t chksum;
 
 	/* If interface can not select src address based on dst addr
 	 * and src address is unspecified, drop the echo request.
@@ -463,13 +470,20 @@ static enum net_verdict icmpv4_handle_echo_request(struct net_pkt *pkt,
 		}
 	}
 
-	if (icmpv4_create(reply, NET_ICMPV4_ECHO_REPLY, 0) ||
+	/* Only the type differs from the request, so update its checksum
+	 * (RFC 1624) instead of summing the payload again.
+	 */
+	chksum = net_chksum_update16(icmp_hdr->chksum,
+				     htons(icmp_hdr->type << 8 | icmp_hdr->code),
+				     htons(NET_ICMPV4_ECHO_REPLY << 8));
+
+	if (icmpv4_create_chksum(reply, NET_ICMPV4_ECHO_REPLY, 0, chksum) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		goto drop;
 	}
 
 	net_pkt_cursor_init(reply);
-	net_ipv4_finalize(reply, IPPROTO_ICMP);
+	net_ipv4_finalize_hdr(reply, IPPROTO_ICMP);
 
 	NET_DBG("Sending Echo Reply from %s to %s",
 		log_strdup(net_sprint_ipv4_addr(src)),
@@ -107,11 +107,13 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 					    struct net_ipv6_hdr *ip_hdr,
 					    struct net_icmp_hdr *icmp_hdr)
 {
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(icmp_access,
+					      struct net_icmp_hdr);
 	struct net_pkt *reply = NULL;
+	struct net_icmp_hdr *reply_hdr;
 	const struct in6_addr *src;
 	int16_t payload_len;
-
-	ARG_UNUSED(icmp_hdr);
+	uint16_t chksum;
 
 	NET_DBG("Received Echo Request from %s to %s",
 		log_strdup(net_sprint_ipv6_addr(&ip_hdr->src)),
@@ -151,14 +153,38 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	if (net_icmpv6_create(reply, NET_ICMPV6_ECHO_REPLY, 0) ||
+	/* Payload and pseudo header length are the same as in the request,
+	 * so its checksum is updated (RFC 1624) for the new type and, when
+	 * the request was sent to a multicast group, the new source address
+	 * instead of summing the payload again.
+	 */
+	chksum = net_chksum_update16(icmp_hdr->chksum,
+				     htons(icmp_hdr->type << 8 | icmp_hdr->code),
+				     htons(NET_ICMPV6_ECHO_REPLY << 8));
+	if (!net_ipv6_addr_cmp(src, &ip_hdr->dst)) {
+		chksum = net_chksum_update(chksum, &ip_hdr->dst, src,
+					   sizeof(struct in6_addr));
+	}
+
+	reply_hdr = (struct net_icmp_hdr *)net_pkt_get_data(reply,
+							     &icmp_access);
+	if (!reply_hdr) {
+		NET_DBG("DROP: wrong buffer");
+		goto drop;
+	}
+
+	reply_hdr->type = NET_ICMPV6_ECHO_REPLY;
+	reply_hdr->code = 0U;
+	reply_hdr->chksum = chksum;
+
+	if (net_pkt_set_data(reply, &icmp_access) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		NET_DBG("DROP: wrong buffer");
 		goto drop;
 	}
 
 	net_pkt_cursor_init(reply);
-	net_ipv6_finalize(reply, IPPROTO_ICMPV6);
+	net_ipv6_finalize_hdr(reply, IPPROTO_ICMPV6);
 
 	NET_DBG("Sending Echo Reply from %s to %s",
 		log_strdup(net_sprint_ipv6_addr(src)),
@@ -63,7 +63,7 @@ int net_ipv4_create(struct net_pkt *pkt,
 	return net_pkt_set_data(pkt, &ipv4_access);
 }
 
-int net_ipv4_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
+int net_ipv4_finalize_hdr(struct net_pkt *pkt, uint8_t next_header_proto)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
 	struct net_ipv4_hdr *ipv4_hdr;
@@ -86,11 +86,23 @@ int net_ipv4_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
 	ipv4_hdr->len   = htons(net_pkt_get_len(pkt));
 	ipv4_hdr->proto = next_header_proto;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* GSO packets are checksummed per segment */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
 	}
 
-	net_pkt_set_data(pkt, &ipv4_access);
+	return net_pkt_set_data(pkt, &ipv4_access);
+}
+
+int net_ipv4_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
+{
+	int ret;
+
+	ret = net_ipv4_finalize_hdr(pkt, next_header_proto);
+	if (ret < 0) {
+		return ret;
+	}
 
 	if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    next_header_proto == IPPROTO_UDP) {
@@ -85,6 +85,29 @@ static inline int net_ipv4_finalize(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Finalize only the IPv4 header, leaving the higher protocol header
+ * untouched. This is for callers that already computed the higher
+ * protocol checksum, e.g. incrementally from a received packet.
+ *
+ * @param pkt Network packet
+ * @param next_header_proto Protocol type of the next header after IPv4 header.
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_NATIVE_IPV4)
+int net_ipv4_finalize_hdr(struct net_pkt *pkt, uint8_t next_header_proto);
+#else
+static inline int net_ipv4_finalize_hdr(struct net_pkt *pkt,
+					uint8_t next_header_proto)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(next_header_proto);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @typedef net_ipv4_parse_hdr_options_cb_t
  * @brief IPv4 header options handle callback
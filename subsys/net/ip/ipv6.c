@@ -81,7 +81,7 @@ int net_ipv6_create(struct net_pkt *pkt,
 	return net_pkt_set_data(pkt, &ipv6_access);
 }
 
-int net_ipv6_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
+int net_ipv6_finalize_hdr(struct net_pkt *pkt, uint8_t next_header_proto)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access, struct net_ipv6_hdr);
 	struct net_ipv6_hdr *ipv6_hdr;
@@ -102,7 +102,17 @@ int net_ipv6_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
 		ipv6_hdr->nexthdr = next_header_proto;
 	}
 
-	net_pkt_set_data(pkt, &ipv6_access);
+	return net_pkt_set_data(pkt, &ipv6_access);
+}
+
+int net_ipv6_finalize(struct net_pkt *pkt, uint8_t next_header_proto)
+{
+	int ret;
+
+	ret = net_ipv6_finalize_hdr(pkt, next_header_proto);
+	if (ret < 0) {
+		return ret;
+	}
 
 	if (net_pkt_ipv6_next_hdr(pkt) != 255U &&
 	    net_pkt_skip(pkt, net_pkt_ipv6_ext_len(pkt))) {
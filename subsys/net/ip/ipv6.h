@@ -192,6 +192,29 @@ static inline int net_ipv6_finalize(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Finalize only the IPv6 header, leaving the higher protocol header
+ * untouched. This is for callers that already computed the higher
+ * protocol checksum, e.g. incrementally from a received packet.
+ *
+ * @param pkt Network packet
+ * @param next_header_proto Protocol type of the next header after IPv6 header.
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_NATIVE_IPV6)
+int net_ipv6_finalize_hdr(struct net_pkt *pkt, uint8_t next_header_proto);
+#else
+static inline int net_ipv6_finalize_hdr(struct net_pkt *pkt,
+					uint8_t next_header_proto)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(next_header_proto);
+
+	return -ENOTSUP;
+}
+#endif
+
 /**
  * @brief Join a given multicast group.
  *
@@ -137,6 +137,57 @@ static inline struct net_nbr *get_nbr_from_data(struct net_ipv6_nbr_data *data)
 	return NULL;
 }
 
+#if defined(CONFIG_NET_IPV6_NBR_HASH)
+/* Neighbors are chained per hash bucket by their pool index + 1, so that
+ * 0 ends a chain.
+ */
+static uint8_t nbr_hash_head[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+static uint8_t nbr_hash_next[CONFIG_NET_IPV6_MAX_NEIGHBORS];
+
+static inline uint8_t nbr_hash(const struct in6_addr *addr)
+{
+	uint32_t hash = UNALIGNED_GET(&addr->s6_addr32[0]) ^
+			UNALIGNED_GET(&addr->s6_addr32[1]) ^
+			UNALIGNED_GET(&addr->s6_addr32[2]) ^
+			UNALIGNED_GET(&addr->s6_addr32[3]);
+
+	return ((hash * 2654435761U) >> 16) % CONFIG_NET_IPV6_MAX_NEIGHBORS;
+}
+
+static inline uint8_t nbr_hash_idx(struct net_nbr *nbr)
+{
+	return ((uint8_t *)nbr - (uint8_t *)net_neighbor_pool) /
+		sizeof(net_neighbor_pool[0]);
+}
+
+static void nbr_hash_del(struct net_nbr *nbr)
+{
+	uint8_t idx = nbr_hash_idx(nbr);
+	uint8_t *link = &nbr_hash_head[nbr_hash(&net_ipv6_nbr_data(nbr)->addr)];
+
+	while (*link) {
+		if (*link == idx + 1) {
+			*link = nbr_hash_next[idx];
+			return;
+		}
+
+		link = &nbr_hash_next[*link - 1];
+	}
+}
+
+static void nbr_hash_add(struct net_nbr *nbr)
+{
+	uint8_t idx = nbr_hash_idx(nbr);
+	uint8_t bucket = nbr_hash(&net_ipv6_nbr_data(nbr)->addr);
+
+	nbr_hash_next[idx] = nbr_hash_head[bucket];
+	nbr_hash_head[bucket] = idx + 1;
+}
+#else
+#define nbr_hash_del(...)
+#define nbr_hash_add(...)
+#endif /* CONFIG_NET_IPV6_NBR_HASH */
+
 static void ipv6_nbr_set_state(struct net_nbr *nbr,
 			       enum net_ipv6_nbr_state new_state)
 {
@@ -259,10 +310,17 @@ static struct net_nbr *nbr_lookup(struct net_nbr_table *table,
 				  struct net_if *iface,
 				  const struct in6_addr *addr)
 {
+#if defined(CONFIG_NET_IPV6_NBR_HASH)
+	uint8_t idx = nbr_hash_head[nbr_hash(addr)];
+
+	for (; idx; idx = nbr_hash_next[idx - 1]) {
+		struct net_nbr *nbr = get_nbr(idx - 1);
+#else
 	int i;
 
 	for (i = 0; i < CONFIG_NET_IPV6_MAX_NEIGHBORS; i++) {
 		struct net_nbr *nbr = get_nbr(i);
+#endif
 
 		if (!nbr->ref) {
 			continue;
@@ -408,6 +466,7 @@ static void nbr_init(struct net_nbr *nbr, struct net_if *iface,
 	nbr->iface = iface;
 
 	net_ipaddr_copy(&net_ipv6_nbr_data(nbr)->addr, addr);
+	nbr_hash_add(nbr);
 	ipv6_nbr_set_state(nbr, state);
 	net_ipv6_nbr_data(nbr)->is_router = is_router;
 	net_ipv6_nbr_data(nbr)->pending = NULL;
@@ -653,6 +712,8 @@ void net_neighbor_data_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Neighbor %p removed", nbr);
 
+	nbr_hash_del(nbr);
+
 	return;
 }
 
@@ -794,7 +855,7 @@ enum net_verdict net_ipv6_prepare_for_send(struct net_pkt *pkt)
 		size_t pkt_len = net_pkt_get_len(pkt);
 
 		mtu = MAX(NET_IPV6_MTU, mtu);
-		if (mtu < pkt_len) {
+		if (mtu < pkt_len && !net_pkt_gso_size(pkt)) {
 			ret = net_ipv6_send_fragmented_pkt(net_pkt_iface(pkt),
 							   pkt, pkt_len);
 			if (ret < 0) {
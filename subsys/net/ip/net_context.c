@@ -1215,13 +1215,39 @@ static int get_context_txtime(struct net_context *context,
 }
 
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. With ext_done, the msghdr data is referenced
+ * instead of copied.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      struct net_pkt_ext_done *ext_done)
 {
 	int ret = 0;
 
+#if defined(CONFIG_NET_PKT_EXT_DATA)
+	if (ext_done) {
+		int i;
+
+		for (i = 0; i < msghdr->msg_iovlen; i++) {
+			if (msghdr->msg_iov[i].iov_len == 0) {
+				continue;
+			}
+
+			ret = net_pkt_append_ext_data(pkt,
+						      msghdr->msg_iov[i].iov_base,
+						      msghdr->msg_iov[i].iov_len,
+						      ext_done, PKT_WAIT_TIME);
+			if (ret < 0) {
+				break;
+			}
+		}
+
+		return ret;
+	}
+#else
+	ARG_UNUSED(ext_done);
+#endif
+
 	if (msghdr) {
 		int i;
 
@@ -1244,6 +1270,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_pkt_ext_done *ext_done,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1285,7 +1312,7 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	ret = context_write_data(pkt, buf, len, msg, ext_done);
 	if (ret) {
 		return ret;
 	}
@@ -1373,7 +1400,8 @@ static int context_sendto(struct net_context *context,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
-			  bool sendto)
+			  bool sendto,
+			  struct net_pkt_ext_done *ext_done)
 {
 	const struct msghdr *msghdr = NULL;
 	struct net_pkt *pkt;
@@ -1550,15 +1578,40 @@ static int context_sendto(struct net_context *context,
 		}
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
-	if (!pkt) {
-		return -ENOBUFS;
-	}
+	if (ext_done) {
+		/* Only datagrams can go out as they are, the stream
+		 * sockets keep their data for retransmission.
+		 */
+		if (!IS_ENABLED(CONFIG_NET_UDP) ||
+		    net_context_get_ip_proto(context) != IPPROTO_UDP ||
+		    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+		     net_if_is_ip_offloaded(net_context_get_iface(context)))) {
+			return -EOPNOTSUPP;
+		}
+
+		tmp_len = net_if_get_mtu(net_context_get_iface(context));
+		tmp_len -= net_context_get_family(context) == AF_INET6 ?
+			NET_IPV6UDPH_LEN : NET_IPV4UDPH_LEN;
+		if (len > tmp_len) {
+			return -EMSGSIZE;
+		}
+
+		/* Only the headers go to the TX buffers */
+		pkt = context_alloc_pkt(context, 0, PKT_WAIT_TIME);
+		if (!pkt) {
+			return -ENOBUFS;
+		}
+	} else {
+		pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+		if (!pkt) {
+			return -ENOBUFS;
+		}
 
-	tmp_len = net_pkt_available_payload_buffer(
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
-		len = tmp_len;
+		if (tmp_len < len) {
+			len = tmp_len;
+		}
 	}
 
 	context->send_cb = cb;
@@ -1617,7 +1670,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1635,7 +1688,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       ext_done, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1646,7 +1699,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1660,7 +1713,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1671,7 +1724,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1732,7 +1785,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, cb, timeout, user_data, false, NULL);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1751,12 +1804,34 @@ int net_context_sendmsg(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, msghdr, 0, NULL, 0,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
+#if defined(CONFIG_NET_PKT_EXT_DATA)
+int net_context_sendmsg_ext(struct net_context *context,
+			    const struct msghdr *msghdr,
+			    int flags,
+			    struct net_pkt_ext_done *done,
+			    net_context_send_cb_t cb,
+			    k_timeout_t timeout,
+			    void *user_data)
+{
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = context_sendto(context, msghdr, 0, NULL, 0,
+			     cb, timeout, user_data, true, done);
 
 	k_mutex_unlock(&context->lock);
 
 	return ret;
 }
+#endif /* CONFIG_NET_PKT_EXT_DATA */
 
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
@@ -1772,7 +1847,7 @@ int net_context_sendto(struct net_context *context,
 	k_mutex_lock(&context->lock, K_FOREVER);
 
 	ret = context_sendto(context, buf, len, dst_addr, addrlen,
-			     cb, timeout, user_data, true);
+			     cb, timeout, user_data, true, NULL);
 
 	k_mutex_unlock(&context->lock);
 
@@ -274,6 +274,39 @@ static inline int check_ip_addr(struct net_pkt *pkt)
 #endif
 
 /* Called when data needs to be sent to network */
+#if defined(CONFIG_NET_TCP_GSO)
+/* Split a packet carrying several TCP segments and send them one by
+ * one, either to the interface or back to us.
+ */
+static int send_gso_segments(struct net_pkt *pkt, bool loopback)
+{
+	struct net_pkt *seg;
+	sys_snode_t *node;
+	sys_slist_t segs;
+	int ret;
+
+	ret = net_tcp_gso_segment(pkt, &segs);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while ((node = sys_slist_get(&segs)) != NULL) {
+		seg = CONTAINER_OF(node, struct net_pkt, next);
+
+		if (loopback) {
+			processing_data(seg, true);
+		} else if (net_if_send_data(net_pkt_iface(seg), seg) ==
+			   NET_DROP) {
+			net_pkt_unref(seg);
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 int net_send_data(struct net_pkt *pkt)
 {
 	int status;
@@ -303,7 +336,18 @@ int net_send_data(struct net_pkt *pkt)
 	status = check_ip_addr(pkt);
 	if (status < 0) {
 		return status;
-	} else if (status > 0) {
+	}
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Looped back packets are split too as they have no checksum */
+	if (net_pkt_gso_size(pkt) &&
+	    (status > 0 ||
+	     net_if_need_tcp_segmentation(net_pkt_iface(pkt)))) {
+		return send_gso_segments(pkt, status > 0);
+	}
+#endif
+
+	if (status > 0) {
 		/* Packet is destined back to us so send it directly
 		 * to RX processing.
 		 */
@@ -3410,6 +3410,11 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_need_tcp_segmentation(struct net_if *iface)
+{
+	return need_calc_checksum(iface, ETHERNET_HW_TSO);
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
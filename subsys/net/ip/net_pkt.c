@@ -128,6 +128,43 @@ NET_BUF_POOL_VAR_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
 
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
+#if defined(CONFIG_NET_PKT_EXT_DATA)
+static void ext_buf_destroy(struct net_buf *buf);
+
+/* The data of these buffers belongs to the caller, the pool holds none.
+ * They are only handed out by net_buf_alloc_with_data(), which never
+ * allocates data, and the stack never frees external data.
+ */
+static uint8_t *ext_buf_data_alloc(struct net_buf *buf, size_t *size,
+				   k_timeout_t timeout)
+{
+	return NULL;
+}
+
+static void ext_buf_data_unref(struct net_buf *buf, uint8_t *data)
+{
+}
+
+static const struct net_buf_data_cb ext_buf_data_cb = {
+	.alloc = ext_buf_data_alloc,
+	.unref = ext_buf_data_unref,
+};
+
+static const struct net_buf_data_alloc ext_buf_data = {
+	.cb = &ext_buf_data_cb,
+};
+
+static struct net_buf net_buf_ext_bufs[CONFIG_NET_PKT_EXT_DATA_COUNT]
+	__noinit;
+static struct net_buf_pool ext_bufs __net_buf_align
+	__in_section(_net_buf_pool, static, ext_bufs) =
+	NET_BUF_POOL_INITIALIZER(ext_bufs, &ext_buf_data, net_buf_ext_bufs,
+				 CONFIG_NET_PKT_EXT_DATA_COUNT,
+				 ext_buf_destroy);
+
+static struct net_pkt_ext_done *ext_buf_done[CONFIG_NET_PKT_EXT_DATA_COUNT];
+#endif /* CONFIG_NET_PKT_EXT_DATA */
+
 /* Allocation tracking is only available if separately enabled */
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 struct net_pkt_alloc {
@@ -1479,6 +1516,53 @@ void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 	}
 }
 
+#if defined(CONFIG_NET_PKT_EXT_DATA)
+void net_pkt_ext_done_put(struct net_pkt_ext_done *done)
+{
+	if (atomic_dec(&done->refs) == 1) {
+		done->cb(done);
+	}
+}
+
+static void ext_buf_destroy(struct net_buf *buf)
+{
+	int id = net_buf_id(buf);
+	struct net_pkt_ext_done *done = ext_buf_done[id];
+
+	ext_buf_done[id] = NULL;
+	net_buf_destroy(buf);
+
+	net_pkt_ext_done_put(done);
+}
+
+int net_pkt_append_ext_data(struct net_pkt *pkt, const void *data,
+			    size_t len, struct net_pkt_ext_done *done,
+			    k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	if (len > UINT16_MAX) {
+		return -EMSGSIZE;
+	}
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	buf = net_buf_alloc_with_data(&ext_bufs, (void *)data, len, timeout);
+	if (!buf) {
+		return -ENOBUFS;
+	}
+
+	atomic_inc(&done->refs);
+	ext_buf_done[net_buf_id(buf)] = done;
+
+	net_pkt_append_buffer(pkt, buf);
+
+	return 0;
+}
+#endif /* CONFIG_NET_PKT_EXT_DATA */
+
 void net_pkt_cursor_init(struct net_pkt *pkt)
 {
 	pkt->cursor.buf = pkt->buffer;
@@ -1736,6 +1820,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_vlan_tag(clone_pkt, net_pkt_vlan_tag(pkt));
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
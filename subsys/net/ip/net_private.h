@@ -182,6 +182,46 @@ enum net_verdict net_context_packet_received(struct net_conn *conn,
 extern uint16_t net_calc_chksum_ipv4(struct net_pkt *pkt);
 #endif /* CONFIG_NET_IPV4 */
 
+#if defined(CONFIG_ARCH_HAS_NET_CHKSUM)
+/**
+ * @brief Architecture specific one's complement sum
+ *
+ * @param data Data to sum, no alignment requirement
+ * @param len Length of the data, an odd last byte is zero padded
+ *
+ * @return Folded, non complemented sum of the big-endian 16-bit words
+ *         of the data, in host byte order.
+ */
+uint16_t arch_net_chksum(const uint8_t *data, size_t len);
+#endif
+
+/**
+ * @brief Update a checksum after rewriting part of the data it covers
+ *
+ * Applies RFC 1624 eqn. 3 so that the rest of the data does not need to
+ * be summed again. All values are in network byte order.
+ *
+ * @param chksum Checksum field before the change
+ * @param old_data Data before the change
+ * @param new_data Data after the change
+ * @param len Length of the changed data, must be even
+ *
+ * @return Checksum field after the change
+ */
+extern uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+				  const void *new_data, size_t len);
+
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum >> 16) + (sum & 0xffff);
+	sum += sum >> 16;
+
+	return ~sum;
+}
+
 static inline uint16_t net_calc_chksum_icmpv6(struct net_pkt *pkt)
 {
 	return net_calc_chksum(pkt, IPPROTO_ICMPV6);
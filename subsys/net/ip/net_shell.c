@@ -1131,6 +1131,10 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	PR("TCP conn drop  %d\tconnrst\t%d\n",
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
+	PR("TCP fast rexmit %d\trecovery %d\trto\t%d\n",
+	   GET_STAT(iface, tcp.fast_rexmit),
+	   GET_STAT(iface, tcp.recovery),
+	   GET_STAT(iface, tcp.rexmit_timeout));
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
 #endif
 
@@ -1976,6 +1980,84 @@ static int cmd_net_dns_query(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void dns_cache_cb(const char *query, enum dns_query_type type,
+			 const struct dns_addrinfo *info, uint32_t ttl,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	char addr[NET_IPV6_ADDR_LEN];
+
+	if (!info) {
+		strcpy(addr, "<none>");
+	} else if (info->ai_family == AF_INET) {
+		net_addr_ntop(AF_INET, &net_sin(&info->ai_addr)->sin_addr,
+			      addr, sizeof(addr));
+	} else {
+		net_addr_ntop(AF_INET6, &net_sin6(&info->ai_addr)->sin6_addr,
+			      addr, sizeof(addr));
+	}
+
+	PR("%-4s %-6u %-*s %s\n",
+	   type == DNS_QUERY_TYPE_A ? "A" : "AAAA", ttl,
+	   NET_IPV6_ADDR_LEN, addr, query);
+
+	(*(int *)data->user_data)++;
+}
+#endif
+
+static int cmd_net_dns_cache(const struct shell *shell, size_t argc,
+			     char *argv[])
+{
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	struct net_shell_user_data user_data;
+	uint32_t hits, misses;
+	int count = 0;
+#endif
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	user_data.shell = shell;
+	user_data.user_data = &count;
+
+	PR("Type TTL    %-*s Name\n", NET_IPV6_ADDR_LEN, "Address");
+
+	dns_cache_foreach(dns_cache_cb, &user_data);
+
+	if (count == 0) {
+		PR("DNS cache is empty.\n");
+	}
+
+	dns_cache_get_stats(&hits, &misses);
+	PR("Hits %u misses %u\n", hits, misses);
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_DNS_RESOLVER_CACHE", "DNS cache");
+#endif
+
+	return 0;
+}
+
+static int cmd_net_dns_cache_flush(const struct shell *shell, size_t argc,
+				   char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	dns_cache_flush();
+	PR("DNS cache flushed.\n");
+#else
+	PR_INFO("Set %s to enable %s support.\n",
+		"CONFIG_DNS_RESOLVER_CACHE", "DNS cache");
+#endif
+
+	return 0;
+}
+
 static int cmd_net_dns(const struct shell *shell, size_t argc, char *argv[])
 {
 #if defined(CONFIG_DNS_RESOLVER)
@@ -4984,7 +5066,16 @@ SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_arp,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns_cache,
+	SHELL_CMD(flush, NULL, "Remove all entries from DNS cache.",
+		  cmd_net_dns_cache_flush),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(net_cmd_dns,
+	SHELL_CMD(cache, &net_cmd_dns_cache,
+		  "Print information about cached DNS answers.",
+		  cmd_net_dns_cache),
 	SHELL_CMD(cancel, NULL, "Cancel all pending requests.",
 		  cmd_net_dns_cancel),
 	SHELL_CMD(query, NULL,
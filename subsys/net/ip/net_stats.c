@@ -152,6 +152,10 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+		NET_INFO("TCP fast rexmit %d\trecovery %d\trto\t%d",
+			 GET_STAT(iface, tcp.fast_rexmit),
+			 GET_STAT(iface, tcp.recovery),
+			 GET_STAT(iface, tcp.rexmit_timeout));
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
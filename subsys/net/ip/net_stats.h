@@ -258,6 +258,21 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_seg_fast_rexmit(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.fast_rexmit++);
+}
+
+static inline void net_stats_update_tcp_recovery(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.recovery++);
+}
+
+static inline void net_stats_update_tcp_rexmit_timeout(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.rexmit_timeout++);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -273,6 +288,9 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_seg_fast_rexmit(iface)
+#define net_stats_update_tcp_recovery(iface)
+#define net_stats_update_tcp_rexmit_timeout(iface)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
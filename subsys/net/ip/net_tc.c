@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -28,12 +29,31 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
+static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
+
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/* "rx_q[y.z]" where z is the flow queue of traffic class y */
+#define MAX_FLOW_NAME_LEN sizeof("rx_q[y.z]")
+
+#define RX_FLOW_QUEUES CONFIG_NET_TC_RX_FLOW_QUEUES
+
+struct rx_flow_queue {
+	struct k_fifo fifo;
+	struct k_thread thread;
+};
+
+/* Stacks for RX flow threads, RX_FLOW_QUEUES per traffic class */
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT * RX_FLOW_QUEUES,
+			    CONFIG_NET_RX_STACK_SIZE);
+
+static struct rx_flow_queue rx_queues[NET_TC_RX_COUNT][RX_FLOW_QUEUES];
+#else
 /* Stacks for RX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
-static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+#endif
 
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 {
@@ -48,12 +68,181 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 	return true;
 }
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/* Enough for an Ethernet VLAN header, an IPv6 header and the ports */
+#define RX_FLOW_HDR_LEN (sizeof(struct net_eth_vlan_hdr) + \
+			 sizeof(struct net_ipv6_hdr) + 2 * sizeof(uint16_t))
+
+/* IPv6 addresses and the ports */
+#define RX_FLOW_KEY_WORDS (2 * sizeof(struct in6_addr) / sizeof(uint32_t) + 1)
+
+#define rx_flow_rol32(_x, _k) (((_x) << (_k)) | ((_x) >> (32 - (_k))))
+
+#define rx_flow_mix(_a, _b, _c)						\
+	do {								\
+		_a -= _c; _a ^= rx_flow_rol32(_c, 4);  _c += _b;	\
+		_b -= _a; _b ^= rx_flow_rol32(_a, 6);  _a += _c;	\
+		_c -= _b; _c ^= rx_flow_rol32(_b, 8);  _b += _a;	\
+		_a -= _c; _a ^= rx_flow_rol32(_c, 16); _c += _b;	\
+		_b -= _a; _b ^= rx_flow_rol32(_a, 19); _a += _c;	\
+		_c -= _b; _c ^= rx_flow_rol32(_b, 4);  _b += _a;	\
+	} while (false)
+
+#define rx_flow_final(_a, _b, _c)					\
+	do {								\
+		_c ^= _b; _c -= rx_flow_rol32(_b, 14);			\
+		_a ^= _c; _a -= rx_flow_rol32(_c, 11);			\
+		_b ^= _a; _b -= rx_flow_rol32(_a, 25);			\
+		_c ^= _b; _c -= rx_flow_rol32(_b, 16);			\
+		_a ^= _c; _a -= rx_flow_rol32(_c, 4);			\
+		_b ^= _a; _b -= rx_flow_rol32(_a, 14);			\
+		_c ^= _b; _c -= rx_flow_rol32(_b, 24);			\
+	} while (false)
+
+/* Bob Jenkins' lookup3 hashword(), known as jhash2() in Linux. Every
+ * bit of the key changes about half of the bits of the result, so
+ * flows that differ in a single port bit still land on any queue.
+ */
+static uint32_t rx_flow_jhash(const uint32_t *key, size_t words)
+{
+	uint32_t a, b, c;
+
+	a = b = c = 0xdeadbeefU + (words << 2);
+
+	while (words > 3) {
+		a += key[0];
+		b += key[1];
+		c += key[2];
+		rx_flow_mix(a, b, c);
+		words -= 3;
+		key += 3;
+	}
+
+	switch (words) {
+	case 3:
+		c += key[2];
+		__fallthrough;
+	case 2:
+		b += key[1];
+		__fallthrough;
+	case 1:
+		a += key[0];
+		rx_flow_final(a, b, c);
+		break;
+	default:
+		break;
+	}
+
+	return c;
+}
+
+/* Hash of the IP addresses, and of the TCP or UDP ports if they are in
+ * the headers read.
+ */
+static uint32_t rx_flow_hash(struct net_pkt *pkt)
+{
+	uint8_t hdr[RX_FLOW_HDR_LEN];
+	uint32_t key[RX_FLOW_KEY_WORDS];
+	struct net_pkt_cursor backup;
+	size_t len = MIN(net_pkt_get_len(pkt), sizeof(hdr));
+	size_t ip = 0, addr_len, l4 = 0;
+	size_t words = 0;
+	uint8_t proto;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, hdr, len)) {
+		len = 0;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr *eth_hdr = (struct net_eth_hdr *)hdr;
+
+		if (len >= sizeof(struct net_eth_hdr) &&
+		    UNALIGNED_GET(&eth_hdr->type) == htons(NET_ETH_PTYPE_VLAN)) {
+			ip = sizeof(struct net_eth_vlan_hdr);
+		} else {
+			ip = sizeof(struct net_eth_hdr);
+		}
+	}
+#endif
+
+	if (len >= ip + sizeof(struct net_ipv4_hdr) &&
+	    (hdr[ip] & 0xf0) == 0x40) {
+		struct net_ipv4_hdr *ipv4_hdr = (struct net_ipv4_hdr *)&hdr[ip];
+
+		addr_len = 2 * sizeof(struct in_addr);
+		proto = ipv4_hdr->proto;
+		l4 = ip + (ipv4_hdr->vhl & 0x0f) * 4U;
+
+		ip += offsetof(struct net_ipv4_hdr, src);
+	} else if (len >= ip + sizeof(struct net_ipv6_hdr) &&
+		   (hdr[ip] & 0xf0) == 0x60) {
+		struct net_ipv6_hdr *ipv6_hdr = (struct net_ipv6_hdr *)&hdr[ip];
+
+		addr_len = 2 * sizeof(struct in6_addr);
+		proto = ipv6_hdr->nexthdr;
+		l4 = ip + sizeof(struct net_ipv6_hdr);
+
+		ip += offsetof(struct net_ipv6_hdr, src);
+	} else {
+		return 0U;
+	}
+
+	for (; addr_len; addr_len -= sizeof(uint32_t), ip += sizeof(uint32_t)) {
+		key[words++] = UNALIGNED_GET((uint32_t *)&hdr[ip]);
+	}
+
+	if (l4 && l4 + sizeof(uint32_t) <= len &&
+	    (proto == IPPROTO_TCP || proto == IPPROTO_UDP)) {
+		key[words++] = UNALIGNED_GET((uint32_t *)&hdr[l4]);
+	}
+
+	return rx_flow_jhash(key, words);
+}
+
+void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
+{
+	uint32_t hash = net_pkt_rx_hash(pkt);
+
+	if (!hash) {
+		hash = rx_flow_hash(pkt);
+	}
+
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+	k_fifo_put(&rx_queues[tc][hash % RX_FLOW_QUEUES].fifo, pkt);
+}
+
+static void rx_flow_thread(void *p1, void *p2, void *p3)
+{
+	struct k_fifo *fifo = p1;
+	struct net_pkt *pkt;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		pkt = k_fifo_get(fifo, K_FOREVER);
+
+		/* The handler was set up by the caller of
+		 * net_tc_submit_to_rx_queue(), like for a work queue.
+		 */
+		net_pkt_work(pkt)->handler(net_pkt_work(pkt));
+	}
+}
+#else
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
 	k_work_submit_to_queue(&rx_classes[tc].work_q, net_pkt_work(pkt));
 }
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
 
 int net_tx_priority2tc(enum net_priority prio)
 {
@@ -242,6 +431,45 @@ void net_tc_tx_init(void)
 	}
 }
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+/* Start the flow threads of a traffic class, each pinned to one CPU */
+static void rx_flow_queues_start(int tc, int priority)
+{
+	int i;
+
+	for (i = 0; i < RX_FLOW_QUEUES; i++) {
+		struct rx_flow_queue *queue = &rx_queues[tc][i];
+		k_thread_stack_t *stack = rx_stack[tc * RX_FLOW_QUEUES + i];
+		int cpu = i % CONFIG_MP_NUM_CPUS;
+		k_tid_t tid;
+
+		NET_DBG("[%d.%d] Starting RX flow queue %p stack size %zd "
+			"prio %d cpu %d", tc, i, queue,
+			K_KERNEL_STACK_SIZEOF(rx_stack[0]), priority, cpu);
+
+		k_fifo_init(&queue->fifo);
+
+		tid = k_thread_create(&queue->thread, stack,
+				      K_KERNEL_STACK_SIZEOF(rx_stack[0]),
+				      rx_flow_thread, &queue->fifo, NULL, NULL,
+				      priority, 0, K_FOREVER);
+
+		/* Pinning is only possible before the thread starts */
+		(void)k_thread_cpu_mask_clear(tid);
+		(void)k_thread_cpu_mask_enable(tid, cpu);
+
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			char name[MAX_FLOW_NAME_LEN];
+
+			snprintk(name, sizeof(name), "rx_q[%d.%d]", tc, i);
+			k_thread_name_set(tid, name);
+		}
+
+		k_thread_start(tid);
+	}
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_STEERING */
+
 void net_tc_rx_init(void)
 {
 	int i;
@@ -262,6 +490,9 @@ void net_tc_rx_init(void)
 			K_PRIO_COOP(thread_priority) :
 			K_PRIO_PREEMPT(thread_priority);
 
+#if defined(CONFIG_NET_TC_RX_FLOW_STEERING)
+		rx_flow_queues_start(i, priority);
+#else
 		NET_DBG("[%d] Starting RX queue %p stack size %zd "
 			"prio %d %s(%d)", i,
 			&rx_classes[i].work_q,
@@ -282,5 +513,6 @@ void net_tc_rx_init(void)
 			snprintk(name, sizeof(name), "rx_q[%d]", i);
 			k_thread_name_set(&rx_classes[i].work_q.thread, name);
 		}
+#endif
 	}
 }
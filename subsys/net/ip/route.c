@@ -257,10 +257,215 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+/* Path compressed binary trie of the route prefixes. A node either holds
+ * the routes of its prefix, or has no routes and two children whose
+ * prefixes first differ at bit prefix_len. So there are never more than
+ * 2 * CONFIG_NET_MAX_ROUTES - 1 nodes in the trie.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+
+	/** Routes to this prefix, linked by trie_next */
+	struct net_route_entry *routes;
+
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+};
+
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_free;
+static struct route_trie_node *trie_root;
+
+static inline int trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7 - pos % 8U)) & 1;
+}
+
+/* Number of leading bits, up to max, that are the same in a and b */
+static uint8_t trie_common_len(const struct in6_addr *a,
+			       const struct in6_addr *b, uint8_t max)
+{
+	int i;
+
+	for (i = 0; i < sizeof(a->s6_addr) && i * 8 < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff) {
+			return MIN(max, i * 8 + __builtin_clz(diff) - 24);
+		}
+	}
+
+	return max;
+}
+
+static struct route_trie_node *trie_node_alloc(const struct in6_addr *prefix,
+					       uint8_t prefix_len)
+{
+	struct route_trie_node *node = trie_free;
+
+	NET_ASSERT(node, "Route trie out of nodes");
+
+	trie_free = node->child[0];
+
+	(void)memset(node, 0, sizeof(*node));
+	net_ipaddr_copy(&node->prefix, prefix);
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = trie_free;
+	trie_free = node;
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node *node, *branch;
+	uint8_t len = route->prefix_len;
+	uint8_t common;
+
+	while ((node = *link) != NULL) {
+		common = trie_common_len(&route->addr, &node->prefix,
+					 MIN(len, node->prefix_len));
+
+		if (common == node->prefix_len) {
+			if (common == len) {
+				break;
+			}
+
+			link = &node->child[trie_bit(&route->addr, common)];
+			continue;
+		}
+
+		if (common == len) {
+			/* The new prefix covers the node */
+			branch = trie_node_alloc(&route->addr, len);
+			branch->child[trie_bit(&node->prefix, len)] = node;
+			*link = branch;
+			node = branch;
+			break;
+		}
+
+		/* The prefixes part ways at bit common */
+		branch = trie_node_alloc(&route->addr, common);
+		branch->child[trie_bit(&node->prefix, common)] = node;
+		node = trie_node_alloc(&route->addr, len);
+		branch->child[trie_bit(&route->addr, common)] = node;
+		*link = branch;
+		break;
+	}
+
+	if (!node) {
+		node = trie_node_alloc(&route->addr, len);
+		*link = node;
+	}
+
+	route->trie_next = node->routes;
+	node->routes = route;
+}
+
+static inline struct route_trie_node *trie_only_child(
+					struct route_trie_node *node)
+{
+	return node->child[0] ? node->child[0] : node->child[1];
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **parent_link = NULL;
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node *node, *parent;
+	struct net_route_entry **prev;
+
+	while ((node = *link) != NULL && node->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &node->child[trie_bit(&route->addr, node->prefix_len)];
+	}
+
+	if (!node || node->prefix_len != route->prefix_len) {
+		return;
+	}
+
+	for (prev = &node->routes; *prev; prev = &(*prev)->trie_next) {
+		if (*prev == route) {
+			*prev = route->trie_next;
+			break;
+		}
+	}
+
+	if (node->routes || (node->child[0] && node->child[1])) {
+		return;
+	}
+
+	*link = trie_only_child(node);
+	trie_node_free(node);
+
+	/* A parent without routes must keep branching to two children */
+	if (*link || !parent_link) {
+		return;
+	}
+
+	parent = *parent_link;
+	if (!parent->routes) {
+		*parent_link = trie_only_child(parent);
+		trie_node_free(parent);
+	}
+}
+
+static struct net_route_entry *route_trie_lookup(struct net_if *iface,
+						 struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node && net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+					  node->prefix_len)) {
+		for (route = node->routes; route; route = route->trie_next) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[trie_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+
+static void route_trie_init(void)
+{
+	int i;
+
+	trie_root = NULL;
+	trie_free = NULL;
+
+	for (i = 0; i < ARRAY_SIZE(trie_nodes); i++) {
+		trie_node_free(&trie_nodes[i]);
+	}
+}
+#else
+#define route_trie_insert(...)
+#define route_trie_remove(...)
+#define route_trie_init(...)
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
+
 struct net_route_entry *net_route_lookup(struct net_if *iface,
 					 struct in6_addr *dst)
 {
-	struct net_route_entry *route, *found = NULL;
+	struct net_route_entry *found = NULL;
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	found = route_trie_lookup(iface, dst);
+#else
+	struct net_route_entry *route;
 	uint8_t longest_match = 0U;
 	int i;
 
@@ -285,6 +490,7 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 			longest_match = route->prefix_len;
 		}
 	}
+#endif /* CONFIG_NET_ROUTE_LPM_TRIE */
 
 	if (found) {
 		net_route_info("Found", found, dst);
@@ -412,6 +618,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	route_trie_insert(route);
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -463,6 +671,8 @@ int net_route_del(struct net_route_entry *route)
 
 	net_route_info("Deleted", route, &route->addr);
 
+	route_trie_remove(route);
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
 		if (!nexthop_route->nbr) {
 			continue;
@@ -910,6 +1120,8 @@ int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface)
 
 void net_route_init(void)
 {
+	route_trie_init();
+
 	NET_DBG("Allocated %d routing entries (%zu bytes)",
 		CONFIG_NET_MAX_ROUTES, sizeof(net_route_entries_pool));
 
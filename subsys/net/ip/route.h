@@ -59,6 +59,11 @@ struct net_route_entry {
 
 	/** IPv6 address/prefix length. */
 	uint8_t prefix_len;
+
+#if defined(CONFIG_NET_ROUTE_LPM_TRIE)
+	/** Next route with the same prefix in the route trie. */
+	struct net_route_entry *trie_next;
+#endif
 };
 
 /**
@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdlib.h>
 #include <zephyr.h>
 #include <random/rand32.h>
+#include <sys/byteorder.h>
 #include <net/net_pkt.h>
 #include <net/net_context.h>
 #include <net/udp.h>
@@ -20,6 +21,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include "connection.h"
 #include "net_stats.h"
 #include "net_private.h"
+#include "tcp_internal.h"
 #include "tcp2_priv.h"
 
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
@@ -29,6 +31,12 @@ static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_window = NET_IPV6_MTU;
 
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define TCP_RX_POOL_SIZE (CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE)
+#else
+#define TCP_RX_POOL_SIZE CONFIG_NET_BUF_DATA_POOL_SIZE
+#endif
+
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
@@ -327,6 +335,40 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+static void tcp_ooo_flush(struct tcp *conn)
+{
+	while (conn->ooo_count > 0) {
+		tcp_pkt_unref(conn->ooo[--conn->ooo_count].pkt);
+	}
+}
+#else
+#define tcp_ooo_flush(...)
+#endif
+
+#if defined(CONFIG_NET_TCP_GRO)
+/* Queue the coalesced data for the application */
+static void tcp_gro_flush(struct tcp *conn)
+{
+	struct net_pkt *pkt = conn->gro_pkt;
+
+	k_delayed_work_cancel(&conn->gro_timer);
+
+	if (!pkt) {
+		return;
+	}
+
+	conn->gro_pkt = NULL;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	k_fifo_put(&conn->recv_data, pkt);
+}
+#else
+#define tcp_gro_flush(...)
+#endif
+
 static int tcp_conn_unref(struct tcp *conn)
 {
 	int ref_count = atomic_get(&conn->ref_count);
@@ -352,6 +394,8 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
+	tcp_gro_flush(conn);
+
 	/* If there is any pending data, pass that to application */
 	while ((pkt = k_fifo_get(&conn->recv_data, K_NO_WAIT)) != NULL) {
 		net_context_packet_received(
@@ -374,6 +418,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	net_context_unref(conn->context);
 
 	tcp_send_queue_flush(conn);
+	tcp_ooo_flush(conn);
 
 	k_delayed_work_cancel(&conn->send_data_timer);
 	tcp_pkt_unref(conn->send_data);
@@ -569,6 +614,7 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+	recv_options->ts_found = false;
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -612,9 +658,27 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
 			break;
+		case TCPOPT_TIMESTAMP:
+			if (opt_len != 10) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = sys_get_be32(options + 2);
+			recv_options->tsecr = sys_get_be32(options + 6);
+			recv_options->ts_found = true;
+			break;
+		case TCPOPT_SACK_PERM:
+			if (opt_len != 2) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm = true;
+			break;
 		default:
 			continue;
 		}
@@ -647,6 +711,20 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t len)
 		net_pkt_cursor_init(up);
 		net_pkt_set_overwrite(up, true);
 
+#if defined(CONFIG_NET_TCP_GRO)
+		/* Only the data is kept, chained to the data of the previous
+		 * segments until tcp_gro_flush() queues it.
+		 */
+		net_pkt_pull(up, net_pkt_get_len(up) - len);
+
+		if (conn->gro_pkt) {
+			net_pkt_append_buffer(conn->gro_pkt, up->buffer);
+			up->buffer = NULL;
+			net_pkt_unref(up);
+		} else {
+			conn->gro_pkt = up;
+		}
+#else
 		net_pkt_skip(up, net_pkt_get_len(up) - len);
 
 		/* Do not pass data to application with TCP conn
@@ -656,11 +734,324 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t len)
 		 * after unlocking the conn
 		 */
 		k_fifo_put(&conn->recv_data, up);
+#endif
 	}
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+/* Keep a segment received beyond conn->ack, sorted by sequence number */
+static void tcp_ooo_queue(struct tcp *conn, struct net_pkt *pkt,
+			  uint32_t seq, size_t len)
+{
+	struct net_pkt *clone;
+	int i;
+
+	if (net_tcp_seq_cmp(seq + len, conn->ack + conn->recv_win) > 0) {
+		NET_DBG("conn: %p seq %u outside of the window", conn, seq);
+		return;
+	}
+
+	for (i = 0; i < conn->ooo_count; i++) {
+		if (conn->ooo[i].seq == seq && conn->ooo[i].len >= len) {
+			return; /* Already queued */
+		}
+
+		if (net_tcp_seq_cmp(seq, conn->ooo[i].seq) < 0) {
+			break;
+		}
+	}
+
+	if (conn->ooo_count == ARRAY_SIZE(conn->ooo)) {
+		/* The segment furthest from the hole is the least useful */
+		if (i == conn->ooo_count) {
+			return;
+		}
+
+		tcp_pkt_unref(conn->ooo[--conn->ooo_count].pkt);
+	}
+
+	clone = tcp_pkt_clone(pkt);
+	if (!clone) {
+		return;
+	}
+
+	memmove(&conn->ooo[i + 1], &conn->ooo[i],
+		(conn->ooo_count - i) * sizeof(conn->ooo[0]));
+
+	conn->ooo[i].pkt = clone;
+	conn->ooo[i].seq = seq;
+	conn->ooo[i].len = len;
+	conn->ooo_count++;
+	conn->ooo_last_seq = seq;
+
+	NET_DBG("conn: %p queued seq %u len %zu (%hu segments)", conn, seq,
+		len, (uint16_t)conn->ooo_count);
+}
+
+/* Pass on the queued segments the last in-order segment has reached */
+static void tcp_ooo_drain(struct tcp *conn)
+{
+	while (conn->ooo_count > 0 &&
+	       net_tcp_seq_cmp(conn->ooo[0].seq, conn->ack) <= 0) {
+		struct tcp_ooo_seg *seg = &conn->ooo[0];
+		int32_t len = seg->seq + seg->len - conn->ack;
+
+		if (len > 0 && tcp_data_get(conn, seg->pkt, len) == 0) {
+			conn_ack(conn, + len);
+		}
+
+		tcp_pkt_unref(seg->pkt);
+
+		conn->ooo_count--;
+		memmove(&conn->ooo[0], &conn->ooo[1],
+			conn->ooo_count * sizeof(conn->ooo[0]));
+	}
+}
+
+#define tcp_ooo_count(_conn) ((_conn)->ooo_count)
+#else
+#define tcp_ooo_queue(...)
+#define tcp_ooo_drain(...)
+#define tcp_ooo_count(_conn) 0
+#endif /* CONFIG_NET_TCP_OOO_QUEUE */
+
+#if defined(CONFIG_NET_TCP_GRO)
+/* Hold back the data and the ACK of a full sized segment, more are
+ * likely to follow. Returns false if they have to go out now, i.e. the
+ * segment is short, pushed, filled a hole or enough segments are held
+ * already.
+ */
+static bool tcp_gro_hold(struct tcp *conn, size_t len, bool push,
+			 bool filled_hole)
+{
+	if (push || filled_hole ||
+	    conn->gro_segs + 1 >= CONFIG_NET_TCP_GRO_MAX_SEGS ||
+	    len + TCP_OPTIONS_MAX_LEN < net_tcp_get_recv_mss(conn)) {
+		return false;
+	}
+
+	if (!conn->ack_pending) {
+		conn->ack_pending = true;
+		k_delayed_work_submit(&conn->gro_timer,
+				      K_MSEC(CONFIG_NET_TCP_GRO_TIMEOUT));
+	}
+
+	conn->gro_segs++;
+
+	return true;
+}
+#else
+static inline bool tcp_gro_hold(struct tcp *conn, size_t len, bool push,
+				bool filled_hole)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(len);
+	ARG_UNUSED(push);
+	ARG_UNUSED(filled_hole);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* SACK option (RFC 2018) describing the out-of-order queue. The block
+ * holding the most recently received segment goes first.
+ */
+static size_t tcp_sack_add(struct tcp *conn, uint8_t *buf, int max_blocks)
+{
+	uint32_t left[CONFIG_NET_TCP_OOO_QUEUE_SEGMENTS];
+	uint32_t right[CONFIG_NET_TCP_OOO_QUEUE_SEGMENTS];
+	int blocks = 0, first = 0, n = 0;
+	size_t len = 0;
+
+	for (int i = 0; i < conn->ooo_count; i++) {
+		uint32_t seq = conn->ooo[i].seq;
+		uint32_t end = seq + conn->ooo[i].len;
+
+		if (blocks > 0 && net_tcp_seq_cmp(seq, right[blocks - 1]) <= 0) {
+			if (net_tcp_seq_cmp(end, right[blocks - 1]) > 0) {
+				right[blocks - 1] = end;
+			}
+		} else {
+			left[blocks] = seq;
+			right[blocks] = end;
+			blocks++;
+		}
+
+		if (seq == conn->ooo_last_seq) {
+			first = blocks - 1;
+		}
+	}
+
+	if (blocks == 0) {
+		return 0;
+	}
+
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_NOP;
+	buf[len++] = TCPOPT_SACK;
+	buf[len++] = 2 + 8 * MIN(blocks, max_blocks);
+
+	for (int i = -1; i < blocks && n < max_blocks; i++) {
+		int b = i < 0 ? first : i;
+
+		if (i == first) {
+			continue;
+		}
+
+		sys_put_be32(left[b], buf + len);
+		sys_put_be32(right[b], buf + len + 4);
+		len += 8;
+		n++;
+	}
+
+	return len;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Options of an outgoing segment, a multiple of 4 bytes long. A SYN
+ * offers every option, a SYN-ACK only echoes the ones the peer offered.
+ */
+static size_t tcp_options_add(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	bool syn = flags & SYN;
+	bool offer = syn && !(flags & ACK);
+	size_t len = 0;
+
+	ARG_UNUSED(offer);
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (offer || (syn && conn->wscale_ok)) {
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_WINDOW;
+		buf[len++] = 3;
+		buf[len++] = conn->recv_wscale;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (offer || conn->ts_ok) {
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_TIMESTAMP;
+		buf[len++] = 10;
+		sys_put_be32(k_uptime_get_32(), buf + len);
+		sys_put_be32(conn->ts_recent, buf + len + 4);
+		len += 8;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (offer || (syn && conn->recv_options.sack_perm)) {
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_NOP;
+		buf[len++] = TCPOPT_SACK_PERM;
+		buf[len++] = 2;
+	} else if (!syn && (flags & ACK) && conn->recv_options.sack_perm) {
+		/* Timestamps leave room for three blocks only */
+		len += tcp_sack_add(conn, buf + len, conn->ts_ok ?
+				    TCP_SACK_BLOCKS_MAX - 1 :
+				    TCP_SACK_BLOCKS_MAX);
+	}
+#endif
+
+	return len;
+}
+
+/* Payload that fits in a data segment: the peer's MSS covers the TCP
+ * options too (RFC 6691), and timestamps and SACK blocks take up to 40
+ * bytes of it.
+ */
+static int tcp_send_mss(struct tcp *conn)
+{
+	uint8_t options[TCP_OPTIONS_MAX_LEN];
+
+	return conn_mss(conn) - tcp_options_add(conn, PSH | ACK, options);
+}
+
+/* The peer's SYN tells which of the offered options are in use */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->wscale_ok = conn->recv_options.wnd_found;
+	conn->send_wscale = MIN(conn->recv_options.window, TCP_WSCALE_MAX);
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	conn->ts_ok = conn->recv_options.ts_found;
+#endif
+
+	if (!conn->wscale_ok) {
+		conn->recv_win = MIN(conn->recv_win, UINT16_MAX);
+	}
+}
+
+static uint32_t tcp_recv_win_max(void)
+{
+	uint32_t win;
+
+	if (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE) {
+		win = CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE;
+	} else {
+		/* Leave a third of the RX buffers to other traffic */
+		win = (TCP_RX_POOL_SIZE * 2) / 3;
+	}
+
+	return MAX(win, (uint32_t)tcp_window);
+}
+
+/* Share of the RX buffers a connection can fill with in-flight data */
+static uint32_t tcp_recv_win_auto(void)
+{
+	uint32_t conns = MAX(1U, k_mem_slab_num_used_get(&tcp_conns_slab));
+
+	return MAX(tcp_recv_win_max() / conns, (uint32_t)tcp_window);
+}
+
+/* Grow the window as connections close, never shrink it (RFC 7323, 2.4) */
+static void tcp_recv_win_update(struct tcp *conn)
+{
+	uint32_t win = tcp_recv_win_auto();
+
+	if (!conn->wscale_ok) {
+		win = MIN(win, UINT16_MAX);
+	}
+
+	if (win > conn->recv_win) {
+		NET_DBG("conn: %p recv_win %u -> %u", conn, conn->recv_win,
+			win);
+		conn->recv_win = win;
+	}
+}
+
+/* What is left of the window once the data the application has not
+ * read yet is taken out, so that a slow reader stops the peer before
+ * the RX buffers run out.
+ */
+static uint32_t tcp_recv_win_avail(struct tcp *conn)
+{
+	if (conn->recv_queued >= conn->recv_win) {
+		return 0U;
+	}
+
+	return conn->recv_win - conn->recv_queued;
+}
+
+static uint16_t tcp_recv_win_field(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = tcp_recv_win_avail(conn);
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* The window of a SYN segment is never scaled */
+	if (conn->wscale_ok && !(flags & SYN)) {
+		win >>= conn->recv_wscale;
+	}
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_finalize_pkt(struct net_pkt *pkt)
 {
 	net_pkt_cursor_init(pkt);
@@ -677,7 +1068,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, uint8_t *options, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -691,16 +1082,20 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + options_len / 4;
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_recv_win_field(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
 		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
 	}
 
-	return net_pkt_set_data(pkt, &tcp_access);
+	if (net_pkt_set_data(pkt, &tcp_access) < 0) {
+		return -ENOBUFS;
+	}
+
+	return options_len ? net_pkt_write(pkt, options, options_len) : 0;
 }
 
 static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
@@ -723,16 +1118,28 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
+	uint8_t options[TCP_OPTIONS_MAX_LEN];
+	size_t options_len = tcp_options_add(conn, flags, options);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr));
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + options_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
 	}
 
 	if (data) {
+		size_t mss = conn_mss(conn) - options_len;
+
+		/* More than one segment of data is split after routing,
+		 * each one carrying the same options.
+		 */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) &&
+		    net_pkt_get_len(data) > mss) {
+			net_pkt_set_gso_size(pkt, mss);
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -744,7 +1151,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -758,6 +1165,13 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 
 	NET_DBG("%s", log_strdup(tcp_th(pkt)));
 
+#if defined(CONFIG_NET_TCP_GRO)
+	if (flags & ACK) {
+		conn->ack_pending = false;
+		conn->gro_segs = 0U;
+	}
+#endif
+
 	if (tcp_send_cb) {
 		ret = tcp_send_cb(pkt);
 		goto out;
@@ -777,6 +1191,47 @@ static void tcp_out(struct tcp *conn, uint8_t flags)
 	(void)tcp_out_ext(conn, flags, NULL /* no data */, conn->seq);
 }
 
+/* Pass the received data to the application, without the conn locked */
+static void tcp_recv_data_deliver(struct tcp *conn,
+				  struct net_conn *conn_handler,
+				  void *recv_user_data)
+{
+	struct net_pkt *pkt;
+
+	while (conn_handler && atomic_get(&conn->ref_count) > 0 &&
+	       (pkt = k_fifo_get(&conn->recv_data, K_NO_WAIT)) != NULL) {
+		net_context_packet_received(conn_handler, pkt, NULL, NULL,
+					    recv_user_data);
+	}
+}
+
+#if defined(CONFIG_NET_TCP_GRO)
+static void tcp_gro_timeout(struct k_work *work)
+{
+	struct tcp *conn = CONTAINER_OF(work, struct tcp, gro_timer);
+	struct net_conn *conn_handler = NULL;
+	void *recv_user_data;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending) {
+		tcp_out(conn, ACK);
+	}
+
+	tcp_gro_flush(conn);
+
+	if (conn->context) {
+		conn_handler = (struct net_conn *)conn->context->conn_handler;
+	}
+
+	recv_user_data = conn->recv_user_data;
+
+	k_mutex_unlock(&conn->lock);
+
+	tcp_recv_data_deliver(conn, conn_handler, recv_user_data);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 {
 	int total = net_pkt_get_len(pkt);
@@ -809,9 +1264,19 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* The peer's receive window, further limited by the congestion window */
+static int tcp_send_win(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN((uint32_t)conn->send_win, conn->cc.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_win(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -836,36 +1301,68 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Copy len bytes of send_data starting at pos to a new packet. Data
+ * for several segments is gathered one MSS at a time as an allocation
+ * does not go beyond the MTU.
+ */
+static struct net_pkt *tcp_send_data_copy(struct tcp *conn, int pos, int len)
 {
-	int ret = 0;
-	int pos, len;
-	struct net_pkt *pkt;
+	struct net_pkt *pkt = NULL;
+	int mss = tcp_send_mss(conn);
 
-	pos = conn->unacked_len;
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+	while (len > 0) {
+		int part_len = MIN(len, mss);
+		struct net_pkt *part;
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		part = tcp_pkt_alloc(conn, part_len);
+		if (!part) {
+			goto fail;
+		}
+
+		if (tcp_pkt_peek(part, conn->send_data, pos, part_len) < 0) {
+			tcp_pkt_unref(part);
+			goto fail;
+		}
+
+		if (!pkt) {
+			pkt = part;
+		} else {
+			net_pkt_append_buffer(pkt, part->buffer);
+			part->buffer = NULL;
+			tcp_pkt_unref(part);
+		}
+
+		pos += part_len;
+		len -= part_len;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
-	if (ret < 0) {
+	return pkt;
+fail:
+	if (pkt) {
 		tcp_pkt_unref(pkt);
+	}
+
+	return NULL;
+}
+
+/* Send len bytes of send_data starting at pos as one segment, or as
+ * several ones with GSO.
+ */
+static int tcp_send_segment(struct tcp *conn, int pos, int len, bool resend)
+{
+	int ret = 0;
+	struct net_pkt *pkt;
+
+	pkt = tcp_send_data_copy(conn, pos, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
 		goto out;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(net_pkt_iface(pkt), len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -879,10 +1376,38 @@ static int tcp_send_data(struct tcp *conn)
 	 * the packet anyway.
 	 */
 	tcp_pkt_unref(pkt);
+ out:
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret;
+	int len;
+
+	len = MIN3(conn->send_data_total - conn->unacked_len,
+		   tcp_send_win(conn) - conn->unacked_len,
+		   tcp_send_mss(conn) * TCP_GSO_SEGS);
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* Time one segment per RTT, never a retransmitted one
+		 * (Karn's algorithm).
+		 */
+		if (!conn->cc.rtt_timing &&
+		    conn->data_mode == TCP_DATA_MODE_SEND) {
+			conn->cc.rtt_timing = true;
+			conn->cc.rtt_seq = conn->seq + conn->unacked_len + len;
+			conn->cc.rtt_start = k_uptime_get_32();
+		}
+#endif
+		conn->unacked_len += len;
+	}
 
 	conn_send_data_dump(conn);
 
- out:
 	return ret;
 }
 
@@ -928,12 +1453,181 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+		k_delayed_work_submit(&conn->send_data_timer,
+				      K_MSEC(conn_rto(conn)));
 	}
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#define TCP_RTO_MAX_MS (60 * MSEC_PER_SEC)
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define TCP_CWND_MAX ((uint32_t)UINT16_MAX << TCP_WSCALE_MAX)
+#else
+#define TCP_CWND_MAX UINT16_MAX
+#endif
+#define TCP_DUP_ACK_THRESHOLD 3
+
+static void tcp_cc_init(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	conn->cc.ops = &tcp_cc_cubic;
+#else
+	conn->cc.ops = &tcp_cc_newreno;
+#endif
+	conn->rto = tcp_rto;
+	conn->cc.ssthresh = UINT32_MAX;
+	conn->cc.cwnd = TCP_CWND_MAX;
+}
+
+/* Called once the MSS is known, RFC 6928 initial window */
+static void tcp_cc_established(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cc.cwnd = MIN(10U * mss, MAX(2U * mss, 14600U));
+	conn->cc.recover = conn->seq;
+	conn->cc.ops->init(conn);
+
+	NET_DBG("conn: %p %s cwnd=%u", conn, conn->cc.ops->name,
+		conn->cc.cwnd);
+}
+
+/* RFC 6298, with times in ms and the lower bound set to the initial
+ * RTO, which is already well below the RFC's one second.
+ */
+static void tcp_rtt_update(struct tcp *conn, int32_t rtt)
+{
+	if (!conn->cc.rtt_sampled) {
+		conn->cc.srtt = rtt << 3;
+		conn->cc.rttvar = rtt << 1;
+		conn->cc.rtt_sampled = true;
+	} else {
+		int32_t delta = rtt - (conn->cc.srtt >> 3);
+
+		conn->cc.srtt += delta;
+		delta = (delta < 0 ? -delta : delta) - (conn->cc.rttvar >> 2);
+		conn->cc.rttvar += delta;
+	}
+
+	conn->rto = (conn->cc.srtt >> 3) + MAX(1, conn->cc.rttvar);
+	conn->rto = CLAMP(conn->rto, (uint32_t)tcp_rto, TCP_RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt=%d srtt=%d rttvar=%d rto=%u", conn, rtt,
+		conn->cc.srtt >> 3, conn->cc.rttvar >> 2, conn->rto);
+}
+
+/* Retransmit the first unacknowledged segment */
+static void tcp_cc_retransmit(struct tcp *conn)
+{
+	int len = MIN(conn->unacked_len, tcp_send_mss(conn));
+
+	conn->cc.rtt_timing = false;
+
+	if (tcp_send_segment(conn, 0, len, true) == 0) {
+		net_stats_update_tcp_seg_fast_rexmit(conn->iface);
+	}
+
+	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn_rto(conn)));
+}
+
+/* New data was acknowledged, conn->seq is already advanced */
+static void tcp_cc_ack(struct tcp *conn, uint32_t len_acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* The echoed timestamp also times retransmitted segments */
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    conn->recv_options.tsecr) {
+		conn->cc.rtt_timing = false;
+		tcp_rtt_update(conn, k_uptime_get_32() -
+			       conn->recv_options.tsecr);
+	} else
+#endif
+	if (conn->cc.rtt_timing &&
+	    net_tcp_seq_cmp(conn->seq, conn->cc.rtt_seq) >= 0) {
+		conn->cc.rtt_timing = false;
+		tcp_rtt_update(conn, k_uptime_get_32() - conn->cc.rtt_start);
+	}
+
+	conn->cc.dup_acks = 0U;
+
+	if (!conn->cc.in_recovery) {
+		conn->cc.ops->ack(conn, len_acked);
+		conn->cc.cwnd = MIN(conn->cc.cwnd, TCP_CWND_MAX);
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->cc.recover) >= 0) {
+		/* Full acknowledgment, deflate the window (RFC 6582) */
+		conn->cc.in_recovery = false;
+		conn->cc.cwnd = MIN(conn->cc.ssthresh,
+				    MAX((uint32_t)conn->unacked_len, mss) + mss);
+		return;
+	}
+
+	/* Partial acknowledgment: the next hole is lost as well */
+	conn->cc.cwnd -= MIN(conn->cc.cwnd - mss, len_acked);
+	conn->cc.cwnd += mss;
+
+	if (conn->unacked_len > 0) {
+		tcp_cc_retransmit(conn);
+	}
+}
+
+static void tcp_cc_dup_ack(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->unacked_len == 0 ||
+	    conn->data_mode == TCP_DATA_MODE_RESEND) {
+		return;
+	}
+
+	if (conn->cc.in_recovery) {
+		/* Each duplicate ACK means a segment has left the network */
+		conn->cc.cwnd = MIN(conn->cc.cwnd + mss, TCP_CWND_MAX);
+		(void)tcp_send_queued_data(conn);
+		return;
+	}
+
+	if (++conn->cc.dup_acks < TCP_DUP_ACK_THRESHOLD ||
+	    net_tcp_seq_cmp(conn->seq, conn->cc.recover) < 0) {
+		return;
+	}
+
+	NET_DBG("conn: %p fast retransmit, seq=%u", conn, conn->seq);
+
+	conn->cc.ops->loss(conn);
+	conn->cc.cwnd = conn->cc.ssthresh + TCP_DUP_ACK_THRESHOLD * mss;
+	conn->cc.recover = conn->seq + conn->unacked_len;
+	conn->cc.in_recovery = true;
+
+	net_stats_update_tcp_recovery(conn->iface);
+
+	tcp_cc_retransmit(conn);
+}
+
+static void tcp_cc_timeout(struct tcp *conn)
+{
+	/* Only the first timeout of a series reduces ssthresh */
+	if (conn->send_data_retries == 0) {
+		conn->cc.ops->loss(conn);
+	}
+
+	conn->cc.cwnd = conn_mss(conn);
+	conn->cc.recover = conn->seq + conn->unacked_len;
+	conn->cc.in_recovery = false;
+	conn->cc.rtt_timing = false;
+	conn->cc.dup_acks = 0U;
+	conn->rto = MIN(conn->rto * 2U, TCP_RTO_MAX_MS);
+
+	net_stats_update_tcp_rexmit_timeout(conn->iface);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 static void tcp_resend_data(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, send_data_timer);
@@ -950,6 +1644,10 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_timeout(conn);
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -975,7 +1673,7 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
-	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(tcp_rto));
+	k_delayed_work_submit(&conn->send_data_timer, K_MSEC(conn_rto(conn)));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1030,7 +1728,18 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->state = TCP_LISTEN;
 
-	conn->recv_win = tcp_window;
+	conn->recv_win = tcp_recv_win_auto();
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	while (conn->recv_wscale < TCP_WSCALE_MAX &&
+	       (tcp_recv_win_max() >> conn->recv_wscale) > UINT16_MAX) {
+		conn->recv_wscale++;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_init(conn);
+#endif
 
 	conn->seq = (IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 		     IS_ENABLED(CONFIG_NET_TEST)) ? 0 : sys_rand32_get();
@@ -1045,6 +1754,10 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	k_delayed_work_init(&conn->send_data_timer, tcp_resend_data);
 
+#if defined(CONFIG_NET_TCP_GRO)
+	k_delayed_work_init(&conn->gro_timer, tcp_gro_timeout);
+#endif
+
 	k_sem_init(&conn->connect_sem, 0, UINT_MAX);
 	conn->in_connect = false;
 
@@ -1267,11 +1980,12 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	bool do_close = false;
 	size_t tcp_options_len = th ? (th_off(th) - 5) * 4 : 0;
 	struct net_conn *conn_handler = NULL;
-	struct net_pkt *recv_pkt;
 	void *recv_user_data;
-	struct k_fifo *recv_data_fifo;
 	size_t len;
 	int ret;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	bool win_update = false;
+#endif
 
 	if (th) {
 		/* Currently we ignore ECN and CWR flags */
@@ -1301,6 +2015,10 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+	if (!tcp_options_len) {
+		conn->recv_options.ts_found = false;
+	}
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -1314,6 +2032,23 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 		conn->send_win = ntohs(th_win(th));
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->send_wscale;
+		}
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		win_update = conn->send_win != conn->cc.last_win;
+		conn->cc.last_win = conn->send_win;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		if (conn->recv_options.ts_found &&
+		    ((th_flags(th) & SYN) ||
+		     net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0)) {
+			conn->ts_recent = conn->recv_options.tsval;
+		}
+#endif
+
 #if IS_ENABLED(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
 		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
 			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
@@ -1343,6 +2078,7 @@ next_state:
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_options_negotiate(conn);
 			tcp_out(conn, SYN | ACK);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
@@ -1359,6 +2095,9 @@ next_state:
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_established(conn);
+#endif
 
 			if (conn->accepted_conn) {
 				conn->accepted_conn->accept_cb(
@@ -1389,6 +2128,7 @@ next_state:
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			tcp_options_negotiate(conn);
 			if (len) {
 				if (tcp_data_get(conn, pkt, len) < 0) {
 					break;
@@ -1399,6 +2139,9 @@ next_state:
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_established(conn);
+#endif
 			tcp_out(conn, ACK);
 		}
 		break;
@@ -1434,6 +2177,17 @@ next_state:
 			break;
 		}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* A duplicate ACK as in RFC 5681, 2: no data, no SYN or FIN,
+		 * nothing new acked and the window unchanged. Whether data
+		 * is outstanding is checked by tcp_cc_dup_ack().
+		 */
+		if (th && len == 0 && (fl & ACK) && !(fl & (SYN | FIN)) &&
+		    th_ack(th) == conn->seq && !win_update) {
+			tcp_cc_dup_ack(conn);
+		}
+#endif
+
 		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
 			uint32_t len_acked = th_ack(th) - conn->seq;
 
@@ -1456,6 +2210,10 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_ack(conn, len_acked);
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_delayed_work_remaining_get(&conn->send_data_timer)) {
@@ -1490,17 +2248,33 @@ next_state:
 
 		if (th && len) {
 			if (th_seq(th) == conn->ack) {
+				bool filled_hole = tcp_ooo_count(conn) > 0;
+
 				if (tcp_data_get(conn, pkt, len) < 0) {
 					break;
 				}
 
 				net_stats_update_tcp_seg_recv(conn->iface);
 				conn_ack(conn, + len);
-				tcp_out(conn, ACK);
+				tcp_ooo_drain(conn);
+				tcp_recv_win_update(conn);
+
+				if (!tcp_gro_hold(conn, len, fl & PSH,
+						  filled_hole)) {
+					tcp_out(conn, ACK);
+				}
 			} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
 				tcp_out(conn, ACK); /* peer has resent */
 
 				net_stats_update_tcp_seg_ackerr(conn->iface);
+			} else {
+				/* A segment is missing: keep this one for
+				 * when the hole is filled and send a
+				 * duplicate ACK right away so that the peer
+				 * can retransmit without waiting for its RTO.
+				 */
+				tcp_ooo_queue(conn, pkt, th_seq(th), len);
+				tcp_out(conn, ACK);
 			}
 		}
 		break;
@@ -1575,7 +2349,13 @@ next_state:
 	}
 
 	recv_user_data = conn->recv_user_data;
-	recv_data_fifo = &conn->recv_data;
+
+#if defined(CONFIG_NET_TCP_GRO)
+	/* Data held for coalescing goes along with its ACK */
+	if (!conn->ack_pending) {
+		tcp_gro_flush(conn);
+	}
+#endif
 
 	k_mutex_unlock(&conn->lock);
 
@@ -1583,11 +2363,7 @@ next_state:
 	 * This is done like this so that we do not have any connection lock
 	 * held.
 	 */
-	while (conn_handler && atomic_get(&conn->ref_count) > 0 &&
-	       (recv_pkt = k_fifo_get(recv_data_fifo, K_NO_WAIT)) != NULL) {
-		net_context_packet_received(conn_handler, recv_pkt, NULL, NULL,
-					    recv_user_data);
-	}
+	tcp_recv_data_deliver(conn, conn_handler, recv_user_data);
 
 	/* We must not try to unref the connection while having a connection
 	 * lock because the unref will try to acquire net_context lock and the
@@ -1663,12 +2439,41 @@ int net_tcp_listen(struct net_context *context)
 	return 0;
 }
 
+/* The socket layer reports the data it queues (delta < 0) and the data
+ * the application reads (delta > 0).
+ */
 int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 {
-	ARG_UNUSED(context);
-	ARG_UNUSED(delta);
+	struct tcp *conn = context->tcp;
+	uint32_t old_win, mss;
+
+	if (!conn) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	old_win = tcp_recv_win_avail(conn);
+
+	if (delta < 0) {
+		conn->recv_queued += -delta;
+	} else {
+		conn->recv_queued -= MIN(conn->recv_queued, (uint32_t)delta);
+	}
+
+	/* Tell the peer once a window it may be waiting on has reopened
+	 * by at least a segment, not on every read (RFC 1122, 4.2.3.3).
+	 */
+	mss = net_tcp_get_recv_mss(conn);
+
+	if (conn->state == TCP_ESTABLISHED && old_win < mss &&
+	    tcp_recv_win_avail(conn) >= mss) {
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
 
-	return -EPROTONOSUPPORT;
+	return 0;
 }
 
 /* net_context queues the outgoing data for the TCP connection */
@@ -1967,13 +2772,171 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* GSO packets are checksummed per segment */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Whether the headers and every segment but the last end on a fragment
+ * boundary, so that the fragments can be handed over to the segments.
+ */
+static bool tcp_gso_aligned(struct net_pkt *pkt, size_t hdr_len,
+			    uint16_t gso_size)
+{
+	size_t boundary = hdr_len;
+	size_t off = 0;
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf; buf = buf->frags) {
+		off += buf->len;
+
+		if (off > boundary) {
+			return false;
+		}
+
+		if (off == boundary) {
+			boundary += gso_size;
+		}
+	}
+
+	return true;
+}
+
+/* Unlink the fragments holding the first len bytes of the chain */
+static struct net_buf *tcp_gso_detach(struct net_buf **chain, size_t len)
+{
+	struct net_buf *head = *chain;
+	struct net_buf *last = head;
+
+	len -= last->len;
+
+	while (len) {
+		last = last->frags;
+		len -= last->len;
+	}
+
+	*chain = last->frags;
+	last->frags = NULL;
+
+	return head;
+}
+
+int net_tcp_gso_segment(struct net_pkt *pkt, sys_slist_t *segs)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t gso_size = net_pkt_gso_size(pkt);
+	struct net_buf *hdr_tail = NULL;
+	struct net_buf *data = NULL;
+	struct tcphdr *th;
+	size_t hdr_len, data_len, off;
+	uint32_t seq;
+	uint8_t flags;
+	int ret = -ENOBUFS;
+
+	sys_slist_init(segs);
+
+	th = th_get(pkt);
+	if (!th) {
+		return -EINVAL;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	if (tcp_gso_aligned(pkt, hdr_len, gso_size)) {
+		data = pkt->buffer;
+		hdr_tail = net_buf_frag_last(tcp_gso_detach(&data, hdr_len));
+	}
+
+	for (off = 0; off < data_len; off += gso_size) {
+		size_t len = MIN(data_len - off, gso_size);
+		struct net_pkt *seg;
+
+		seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+						hdr_len + (hdr_tail ? 0 : len),
+						AF_UNSPEC, 0,
+						TCP_PKT_ALLOC_TIMEOUT);
+		if (!seg) {
+			goto fail;
+		}
+
+		sys_slist_append(segs, &seg->next);
+
+		net_pkt_set_family(seg, net_pkt_family(pkt));
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+		net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+		net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(pkt) == AF_INET) {
+			net_pkt_set_ipv4_opts_len(seg,
+						  net_pkt_ipv4_opts_len(pkt));
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			   net_pkt_family(pkt) == AF_INET6) {
+			net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+			net_pkt_set_ipv6_next_hdr(seg,
+						  net_pkt_ipv6_next_hdr(pkt));
+		}
+
+		net_pkt_cursor_init(pkt);
+		net_pkt_set_overwrite(pkt, true);
+
+		if (net_pkt_copy(seg, pkt, hdr_len)) {
+			goto fail;
+		}
+
+		if (hdr_tail) {
+			net_pkt_append_buffer(seg, tcp_gso_detach(&data, len));
+		} else if (net_pkt_skip(pkt, off) ||
+			   net_pkt_copy(seg, pkt, len)) {
+			goto fail;
+		}
+
+		th = th_get(seg);
+		if (!th) {
+			goto fail;
+		}
+
+		UNALIGNED_PUT(htonl(seq + off), &th->th_seq);
+
+		if (off + len < data_len) {
+			UNALIGNED_PUT(flags & ~(PSH | FIN), &th->th_flags);
+		}
+
+		ret = tcp_finalize_pkt(seg);
+		if (ret < 0) {
+			goto fail;
+		}
+	}
+
+	NET_DBG("pkt %p split into %zu segments (%s)", pkt,
+		(data_len + gso_size - 1) / gso_size,
+		hdr_tail ? "moved" : "copied");
+
+	return 0;
+
+fail:
+	/* Leave what was not moved yet to be freed with the packet */
+	if (hdr_tail) {
+		hdr_tail->frags = data;
+	}
+
+	while (!sys_slist_is_empty(segs)) {
+		net_pkt_unref(CONTAINER_OF(sys_slist_get(segs),
+					   struct net_pkt, next));
+	}
+
+	return ret < 0 ? ret : -ENOBUFS;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 				  struct net_pkt_data_access *tcp_access)
 {
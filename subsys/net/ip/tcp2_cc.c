@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* TCP congestion control algorithms (RFC 5681, RFC 8312).
+ *
+ * Only the window arithmetic lives here; detecting losses and
+ * recovering from them is done by tcp2.c for all algorithms.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "tcp2_priv.h"
+
+/* RFC 3465 with L = 1 SMSS */
+static void tcp_cc_slow_start(struct tcp *conn, uint32_t acked)
+{
+	conn->cc.cwnd += MIN(acked, conn_mss(conn));
+}
+
+static void newreno_init(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static void newreno_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->cc.cwnd < conn->cc.ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	conn->cc.cwnd += MAX(1U, mss * mss / conn->cc.cwnd);
+}
+
+static void newreno_loss(struct tcp *conn)
+{
+	conn->cc.ssthresh = MAX((uint32_t)conn->unacked_len / 2,
+				2U * conn_mss(conn));
+}
+
+const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.init = newreno_init,
+	.ack = newreno_ack,
+	.loss = newreno_loss,
+};
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* C = 0.4 and beta = 0.7 as in RFC 8312. The cubic term C * t^3 is
+ * computed with t in ms, i.e. 4 * t^3 / 10^10 segments.
+ */
+#define CUBIC_C_NUM 4LL
+#define CUBIC_C_DEN 10000000000LL
+#define CUBIC_BETA_NUM 7U
+#define CUBIC_BETA_DEN 10U
+
+/* Keeps t^3 * C_NUM * mss within 64 bits */
+#define CUBIC_T_MAX_MS 100000LL
+
+static uint32_t cubic_root(uint64_t a)
+{
+	uint64_t x = 0;
+
+	/* 21 bits of result keep x^3 within 64 bits */
+	for (int bit = 20; bit >= 0; bit--) {
+		uint64_t y = x | BIT64(bit);
+
+		if (y * y * y <= a) {
+			x = y;
+		}
+	}
+
+	return (uint32_t)x;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	conn->cc.w_max = 0U;
+	conn->cc.epoch_start = 0U;
+}
+
+static void cubic_epoch_start(struct tcp *conn, uint32_t now)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->cc.epoch_start = now ? now : 1U;
+	conn->cc.w_est = conn->cc.cwnd;
+
+	if (conn->cc.cwnd < conn->cc.w_max) {
+		uint64_t deficit = conn->cc.w_max - conn->cc.cwnd;
+
+		/* K = cbrt((W_max - cwnd) / C), in ms */
+		conn->cc.k = cubic_root(deficit * CUBIC_C_DEN /
+					(CUBIC_C_NUM * mss));
+		conn->cc.origin = conn->cc.w_max;
+	} else {
+		conn->cc.k = 0U;
+		conn->cc.origin = conn->cc.cwnd;
+	}
+}
+
+static void cubic_ack(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t cwnd = conn->cc.cwnd;
+	int64_t t, target;
+
+	if (cwnd < conn->cc.ssthresh) {
+		tcp_cc_slow_start(conn, acked);
+		return;
+	}
+
+	if (conn->cc.epoch_start == 0U) {
+		cubic_epoch_start(conn, now);
+	}
+
+	/* Aim for the window one RTT from now */
+	t = (int64_t)(now - conn->cc.epoch_start) + (conn->cc.srtt >> 3) -
+		conn->cc.k;
+	t = CLAMP(t, -CUBIC_T_MAX_MS, CUBIC_T_MAX_MS);
+
+	target = (int64_t)conn->cc.origin +
+		CUBIC_C_NUM * t * t * t * mss / CUBIC_C_DEN;
+	target = CLAMP(target, (int64_t)mss, (int64_t)cwnd * 3 / 2);
+
+	if (target > cwnd) {
+		conn->cc.cwnd += MAX(1U, (uint32_t)((target - cwnd) * acked /
+						       cwnd));
+	}
+
+	/* Reno-friendly region: 3 * (1 - beta) / (1 + beta) = 9 / 17 */
+	conn->cc.w_est += MAX(1U, (uint32_t)(9ULL * acked * mss /
+					     (17ULL * cwnd)));
+	if (conn->cc.w_est > conn->cc.cwnd) {
+		conn->cc.cwnd = conn->cc.w_est;
+	}
+}
+
+static void cubic_loss(struct tcp *conn)
+{
+	uint32_t cwnd = conn->cc.cwnd;
+
+	conn->cc.epoch_start = 0U;
+
+	/* Fast convergence: release bandwidth to newer flows */
+	if (cwnd < conn->cc.w_max) {
+		conn->cc.w_max = cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			(2U * CUBIC_BETA_DEN);
+	} else {
+		conn->cc.w_max = cwnd;
+	}
+
+	conn->cc.ssthresh = MAX(cwnd * CUBIC_BETA_NUM / CUBIC_BETA_DEN,
+				2U * conn_mss(conn));
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.ack = cubic_ack,
+	.loss = cubic_loss,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -90,6 +90,19 @@
 	((_conn)->recv_options.mss_found ?		\
 	 (_conn)->recv_options.mss : (uint16_t)NET_IPV6_MTU)
 
+/* Segments of data sent at once, split by net_tcp_gso_segment() or TSO */
+#if defined(CONFIG_NET_TCP_GSO)
+#define TCP_GSO_SEGS CONFIG_NET_TCP_GSO_MAX_SEGS
+#else
+#define TCP_GSO_SEGS 1
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#define conn_rto(_conn) ((_conn)->rto)
+#else
+#define conn_rto(_conn) tcp_rto
+#endif
+
 #define conn_state(_conn, _s)						\
 ({									\
 	NET_DBG("%s->%s",						\
@@ -101,7 +114,7 @@
 #define conn_send_data_dump(_conn)					\
 ({									\
 	NET_DBG("conn: %p total=%zd, unacked_len=%d, "			\
-		"send_win=%hu, mss=%hu",				\
+		"send_win=%u, mss=%hu",				\
 		(_conn), net_pkt_get_len((_conn)->send_data),		\
 		conn->unacked_len, conn->send_win,			\
 		(uint16_t)conn_mss((_conn)));				\
@@ -115,6 +128,13 @@
 #define TCPOPT_NOP	1
 #define TCPOPT_MAXSEG	2
 #define TCPOPT_WINDOW	3
+#define TCPOPT_SACK_PERM	4
+#define TCPOPT_SACK	5
+#define TCPOPT_TIMESTAMP	8
+
+#define TCP_OPTIONS_MAX_LEN	40
+#define TCP_SACK_BLOCKS_MAX	4
+#define TCP_WSCALE_MAX	14	/* RFC 7323, 2.3 */
 
 enum pkt_addr {
 	TCP_EP_SRC = 1,
@@ -177,12 +197,70 @@ union tcp_endpoint {
 };
 
 struct tcp_options {
+	uint32_t tsval;
+	uint32_t tsecr;
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool ts_found : 1;
+	bool sack_perm : 1;
 };
 
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+struct tcp_ooo_seg { /* Segment received ahead of a hole */
+	struct net_pkt *pkt;
+	uint32_t seq;
+	uint16_t len;
+};
+#endif
+
+struct tcp;
+
+/* Congestion control algorithm. The window arithmetic is done in bytes;
+ * loss recovery itself (fast retransmit, NewReno fast recovery, RTO
+ * backoff) is common to all algorithms and lives in tcp2.c.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	/* Connection established, cwnd and ssthresh are initialized */
+	void (*init)(struct tcp *conn);
+	/* New data acknowledged outside of fast recovery */
+	void (*ack)(struct tcp *conn, uint32_t acked);
+	/* Loss detected, set ssthresh (cwnd is set by the caller) */
+	void (*loss)(struct tcp *conn);
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+extern const struct tcp_cc_ops tcp_cc_newreno;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+extern const struct tcp_cc_ops tcp_cc_cubic;
+#endif
+
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover;	/* highest seq sent when loss was detected */
+	uint32_t rtt_seq;	/* ack that completes the timed segment */
+	uint32_t rtt_start;	/* k_uptime_get_32() when it was sent */
+	int32_t srtt;		/* smoothed RTT in 1/8 ms */
+	int32_t rttvar;		/* RTT variation in 1/4 ms */
+	uint32_t last_win;	/* peer's window before send_win clamping */
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	uint32_t w_max;		/* cwnd before the last reduction */
+	uint32_t w_est;		/* Reno-friendly window estimate */
+	uint32_t epoch_start;	/* start of the current growth epoch */
+	uint32_t origin;	/* plateau of the cubic function */
+	uint32_t k;		/* time to reach origin, in ms */
+#endif
+	uint8_t dup_acks;
+	bool in_recovery : 1;
+	bool rtt_timing : 1;
+	bool rtt_sampled : 1;	/* srtt and rttvar hold a measurement */
+};
+#endif
+
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
@@ -198,6 +276,20 @@ struct tcp { /* TCP connection */
 	struct k_sem connect_sem; /* semaphore for blocking connect */
 	struct k_fifo recv_data;  /* temp queue before passing data to app */
 	struct tcp_options recv_options;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct tcp_cc cc;
+	uint32_t rto;
+#endif
+#if defined(CONFIG_NET_TCP_OOO_QUEUE)
+	struct tcp_ooo_seg ooo[CONFIG_NET_TCP_OOO_QUEUE_SEGMENTS];
+	uint32_t ooo_last_seq;
+	uint8_t ooo_count;
+#endif
+#if defined(CONFIG_NET_TCP_GRO)
+	struct net_pkt *gro_pkt;	/* in-order data not passed on yet */
+	struct k_delayed_work gro_timer;
+	uint8_t gro_segs;		/* segments whose ACK is held */
+#endif
 	struct k_delayed_work send_timer;
 	struct k_delayed_work send_data_timer;
 	struct k_delayed_work timewait_timer;
@@ -212,12 +304,25 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t recv_win;
+	uint32_t recv_queued;	/* passed up but not read yet */
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent;	/* peer's TSval to echo */
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t recv_wscale;
+	uint8_t send_wscale;
+#endif
 	uint8_t send_data_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool wscale_ok : 1;
+	bool ts_ok : 1;
+#if defined(CONFIG_NET_TCP_GRO)
+	bool ack_pending : 1;	/* coalesced data not acknowledged yet */
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
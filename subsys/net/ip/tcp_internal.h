@@ -786,6 +786,25 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_TCP_GSO)
+/**
+ * @brief Split a packet carrying several TCP segments
+ *
+ * Each segment gets a copy of the IP and TCP headers with its own
+ * length, sequence number and checksums. The data is moved, not
+ * copied, when it is laid out in fragments that end on segment
+ * boundaries, which is how TCP builds such packets.
+ *
+ * @param pkt Network packet, with net_pkt_gso_size() set
+ * @param segs Initialized by the function, gets the segments linked
+ *        by their next field
+ *
+ * @return 0 on success, negative errno otherwise. The packet itself is
+ *         not released.
+ */
+int net_tcp_gso_segment(struct net_pkt *pkt, sys_slist_t *segs);
+#endif
+
 /**
  * @brief Enqueue a single packet for transmission
  *
@@ -489,29 +489,79 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+#if defined(CONFIG_ARCH_HAS_NET_CHKSUM)
+#define chksum_words arch_net_chksum
+#else
+static inline uint64_t chksum_add64(uint64_t acc, uint64_t val)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	acc += val;
 
-	end = data + len - 1;
+	return acc + (acc < val);
+}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+/* The one's complement sum does not depend on byte order (RFC 1071), so
+ * the data is summed in native order a 64-bit word at a time and only the
+ * folded result is swapped back to the big-endian view.
+ */
+static uint16_t chksum_words(const uint8_t *data, size_t len)
+{
+	uint64_t acc = 0U;
+	uint32_t sum;
+
+	while (len >= 32U) {
+		acc = chksum_add64(acc, UNALIGNED_GET((const uint64_t *)data));
+		acc = chksum_add64(acc,
+				   UNALIGNED_GET((const uint64_t *)(data + 8)));
+		acc = chksum_add64(acc,
+				   UNALIGNED_GET((const uint64_t *)(data + 16)));
+		acc = chksum_add64(acc,
+				   UNALIGNED_GET((const uint64_t *)(data + 24)));
+		data += 32;
+		len -= 32U;
+	}
+
+	while (len >= 8U) {
+		acc = chksum_add64(acc, UNALIGNED_GET((const uint64_t *)data));
+		data += 8;
+		len -= 8U;
+	}
 
+	if (len >= 4U) {
+		acc = chksum_add64(acc, UNALIGNED_GET((const uint32_t *)data));
+		data += 4;
+		len -= 4U;
+	}
+
+	if (len >= 2U) {
+		acc = chksum_add64(acc, UNALIGNED_GET((const uint16_t *)data));
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (len) {
+		/* Odd byte is the high byte of a zero padded word */
+		uint8_t last[2] = { data[0], 0U };
+
+		acc = chksum_add64(acc, UNALIGNED_GET((const uint16_t *)last));
+	}
+
+	acc = (acc >> 32) + (acc & 0xffffffffU);
+	acc = (acc >> 32) + (acc & 0xffffffffU);
+	sum = (uint32_t)acc;
+	sum = (sum >> 16) + (sum & 0xffffU);
+	sum = (sum >> 16) + (sum & 0xffffU);
+
+	return sys_be16_to_cpu((uint16_t)sum);
+}
+#endif /* CONFIG_ARCH_HAS_NET_CHKSUM */
+
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint16_t tmp = chksum_words(data, len);
+
+	sum += tmp;
+	if (sum < tmp) {
+		sum++;
 	}
 
 	return sum;
@@ -617,6 +667,20 @@ uint16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
 }
 #endif /* CONFIG_NET_IPV4 */
 
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	uint16_t sum;
+
+	/* ~HC + ~m == ~(HC + m) in one's complement arithmetic */
+	sum = calc_chksum(ntohs(chksum), old_data, len);
+	sum = ~sum;
+	sum = calc_chksum(sum, new_data, len);
+	sum = ~sum;
+
+	return htons(sum);
+}
+
 #if defined(CONFIG_NET_IPV6) || defined(CONFIG_NET_IPV4)
 static bool convert_port(const char *buf, uint16_t *port)
 {
@@ -532,16 +532,24 @@ static int parse_option(uint8_t *data, uint16_t offset, uint16_t *pos,
 	return r;
 }
 
-int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
-		      struct coap_option *options, uint8_t opt_num)
+/* Parses the packet into cpkt, filling up to opt_num entries of options.
+ * opt_count is set to the number of options found in the packet, which
+ * may be larger than opt_num.
+ */
+static int packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+			struct coap_option *options, uint8_t opt_num,
+			uint16_t *opt_count)
 {
 	uint16_t opt_len;
 	uint16_t offset;
 	uint16_t delta;
+	uint16_t count;
 	uint8_t num;
 	uint8_t tkl;
 	int ret;
 
+	*opt_count = 0U;
+
 	if (!cpkt || !data) {
 		return -EINVAL;
 	}
@@ -560,6 +568,8 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	cpkt->opt_len = 0U;
 	cpkt->hdr_len = 0U;
 	cpkt->delta = 0U;
+	cpkt->opt_index = NULL;
+	cpkt->opt_index_num = 0U;
 
 	/* Token lengths 9-15 are reserved. */
 	tkl = cpkt->data[0] & 0x0f;
@@ -580,6 +590,7 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 	offset = cpkt->offset;
 	opt_len = 0U;
 	delta = 0U;
+	count = 0U;
 	num = 0U;
 
 	while (1) {
@@ -590,15 +601,59 @@ int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
 				   &delta, &opt_len, option);
 		if (ret < 0) {
 			return ret;
-		} else if (ret == 0) {
+		}
+
+		count++;
+
+		if (ret == 0) {
 			break;
 		}
 	}
 
+	/* The payload marker went through parse_option() as well */
+	if (offset < cpkt->max_len) {
+		count--;
+	}
+
 	cpkt->opt_len = opt_len;
 	cpkt->delta = delta;
 	cpkt->offset = offset;
 
+	*opt_count = count;
+
+	return 0;
+}
+
+int coap_packet_parse(struct coap_packet *cpkt, uint8_t *data, uint16_t len,
+		      struct coap_option *options, uint8_t opt_num)
+{
+	uint16_t count;
+
+	return packet_parse(cpkt, data, len, options, opt_num, &count);
+}
+
+int coap_packet_parse_indexed(struct coap_packet *cpkt, uint8_t *data,
+			      uint16_t len, struct coap_option *options,
+			      uint8_t opt_num)
+{
+	uint16_t count;
+	int r;
+
+	if (!options) {
+		return -EINVAL;
+	}
+
+	r = packet_parse(cpkt, data, len, options, opt_num, &count);
+	if (r < 0) {
+		return r;
+	}
+
+	/* A partial index would hide the options that did not fit */
+	if (count <= opt_num) {
+		cpkt->opt_index = options;
+		cpkt->opt_index_num = count;
+	}
+
 	return 0;
 }
 
@@ -611,6 +666,25 @@ int coap_find_options(const struct coap_packet *cpkt, uint16_t code,
 	uint8_t num;
 	int r;
 
+	if (cpkt->opt_index) {
+		uint8_t i;
+
+		num = 0U;
+
+		/* Options are kept in ascending order of their number */
+		for (i = 0U; i < cpkt->opt_index_num && num < veclen; i++) {
+			if (cpkt->opt_index[i].delta > code) {
+				break;
+			}
+
+			if (cpkt->opt_index[i].delta == code) {
+				options[num++] = cpkt->opt_index[i];
+			}
+		}
+
+		return num;
+	}
+
 	offset = cpkt->hdr_len;
 	opt_len = 0U;
 	delta = 0U;
@@ -822,6 +896,20 @@ static bool is_request(const struct coap_packet *cpkt)
 	return !(code & ~COAP_REQUEST_MASK);
 }
 
+static int call_method(struct coap_resource *resource,
+		       struct coap_packet *cpkt,
+		       struct sockaddr *addr, socklen_t addr_len)
+{
+	coap_method_t method;
+
+	method = method_from_code(resource, coap_header_get_code(cpkt));
+	if (!method) {
+		return -EPERM;
+	}
+
+	return method(resource, cpkt, addr, addr_len);
+}
+
 int coap_handle_request(struct coap_packet *cpkt,
 			struct coap_resource *resources,
 			struct coap_option *options,
@@ -836,26 +924,179 @@ int coap_handle_request(struct coap_packet *cpkt,
 
 	/* FIXME: deal with hierarchical resources */
 	for (resource = resources; resource && resource->path; resource++) {
-		coap_method_t method;
-		uint8_t code;
-
 		if (!uri_path_eq(cpkt, resource->path, options, opt_num)) {
 			continue;
 		}
 
-		code = coap_header_get_code(cpkt);
-		method = method_from_code(resource, code);
-		if (!method) {
-			return -EPERM;
-		}
-
-		return method(resource, cpkt, addr, addr_len);
+		return call_method(resource, cpkt, addr, addr_len);
 	}
 
 	NET_DBG("%d", __LINE__);
 	return -ENOENT;
 }
 
+static bool node_is_wildcard(const struct coap_resource_node *node, char c)
+{
+	return IS_ENABLED(CONFIG_COAP_URI_WILDCARD) &&
+		node->len == 1U && *node->segment == c;
+}
+
+static struct coap_resource_node *tree_node_get(
+	struct coap_resource_tree *tree, struct coap_resource_node *parent,
+	const char *segment, uint8_t len)
+{
+	struct coap_resource_node *node, **last;
+
+	for (last = &parent->child; *last; last = &(*last)->next) {
+		node = *last;
+
+		if (node->len == len && !memcmp(node->segment, segment, len)) {
+			return node;
+		}
+	}
+
+	if (tree->used == tree->max_nodes) {
+		return NULL;
+	}
+
+	node = &tree->nodes[tree->used++];
+	memset(node, 0, sizeof(*node));
+	node->segment = segment;
+	node->len = len;
+
+	*last = node;
+
+	return node;
+}
+
+int coap_resource_tree_build(struct coap_resource_tree *tree,
+			     struct coap_resource *resources)
+{
+	struct coap_resource *resource;
+	struct coap_resource_node *node;
+	const char * const *path;
+
+	tree->resources = resources;
+	tree->used = 0U;
+
+	if (!tree->max_nodes) {
+		return -ENOMEM;
+	}
+
+	/* The root node stands for the empty path */
+	node = &tree->nodes[tree->used++];
+	memset(node, 0, sizeof(*node));
+
+	for (resource = resources; resource && resource->path; resource++) {
+		node = &tree->nodes[0];
+
+		for (path = resource->path; *path; path++) {
+			size_t len = strlen(*path);
+
+			if (len > UINT8_MAX) {
+				return -EINVAL;
+			}
+
+			node = tree_node_get(tree, node, *path, len);
+			if (!node) {
+				return -ENOMEM;
+			}
+
+			/* Nothing after a multi-level wildcard can match */
+			if (node_is_wildcard(node, '#')) {
+				break;
+			}
+		}
+
+		/* As with coap_handle_request(), the first resource wins */
+		if (!node->resource) {
+			node->resource = resource;
+		}
+	}
+
+	return 0;
+}
+
+static uint8_t next_uri_path(const struct coap_option *options,
+			     uint8_t opt_num, uint8_t i)
+{
+	while (i < opt_num && options[i].delta != COAP_OPTION_URI_PATH) {
+		i++;
+	}
+
+	return i;
+}
+
+/* Returns the resource matching the path left after options[i], out of
+ * the ones below node. When wildcards let several resources match, the
+ * one that comes first in the resource array is returned, so that the
+ * outcome is the same as with coap_handle_request().
+ */
+static struct coap_resource *tree_match(const struct coap_resource_node *node,
+					const struct coap_option *options,
+					uint8_t opt_num, uint8_t i)
+{
+	const struct coap_resource_node *child;
+	struct coap_resource *found = NULL;
+	struct coap_resource *resource;
+
+	i = next_uri_path(options, opt_num, i);
+	if (i == opt_num) {
+		return node->resource;
+	}
+
+	for (child = node->child; child; child = child->next) {
+		if (node_is_wildcard(child, '#')) {
+			resource = child->resource;
+		} else if (node_is_wildcard(child, '+') ||
+			   (child->len == options[i].len &&
+			    !memcmp(child->segment, options[i].value,
+				    child->len))) {
+			resource = tree_match(child, options, opt_num, i + 1);
+		} else {
+			continue;
+		}
+
+		if (resource && (!found || resource < found)) {
+			found = resource;
+		}
+	}
+
+	return found;
+}
+
+struct coap_resource *coap_resource_tree_find(
+	const struct coap_resource_tree *tree,
+	const struct coap_option *options, uint8_t opt_num)
+{
+	if (!tree->used) {
+		return NULL;
+	}
+
+	return tree_match(&tree->nodes[0], options, opt_num, 0U);
+}
+
+int coap_handle_request_tree(struct coap_packet *cpkt,
+			     const struct coap_resource_tree *tree,
+			     struct coap_option *options,
+			     uint8_t opt_num,
+			     struct sockaddr *addr, socklen_t addr_len)
+{
+	struct coap_resource *resource;
+
+	if (!is_request(cpkt)) {
+		return 0;
+	}
+
+	resource = coap_resource_tree_find(tree, options, opt_num);
+	if (!resource) {
+		NET_DBG("%d", __LINE__);
+		return -ENOENT;
+	}
+
+	return call_method(resource, cpkt, addr, addr_len);
+}
+
 int coap_block_transfer_init(struct coap_block_context *ctx,
 			      enum coap_block_size block_size,
 			      size_t total_size)
@@ -1368,6 +1609,7 @@ bool coap_register_observer(struct coap_resource *resource,
 	bool first;
 
 	sys_slist_append(&resource->observers, &observer->list);
+	observer->resource = resource;
 
 	first = resource->age == 0;
 	if (first) {
@@ -1380,7 +1622,9 @@ bool coap_register_observer(struct coap_resource *resource,
 void coap_remove_observer(struct coap_resource *resource,
 			  struct coap_observer *observer)
 {
-	sys_slist_find_and_remove(&resource->observers, &observer->list);
+	if (sys_slist_find_and_remove(&resource->observers, &observer->list)) {
+		observer->resource = NULL;
+	}
 }
 
 static bool sockaddr_equal(const struct sockaddr *a,
@@ -0,0 +1,266 @@
+/** @file
+ * @brief DNS answer cache
+ *
+ * Keeps the answers received by the resolver until their TTL expires
+ * so that repeated lookups of the same name do not hit the network.
+ */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_dns_resolve, CONFIG_DNS_RESOLVER_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <strings.h>
+
+#include <net/net_core.h>
+#include <net/net_ip.h>
+#include <net/dns_resolve.h>
+#include "dns_internal.h"
+
+#define NAME_LEN CONFIG_DNS_RESOLVER_CACHE_NAME_LEN
+
+struct dns_cache_entry {
+	/** Uptime in ms at which the entry goes stale, 0 if unused */
+	int64_t expiry;
+
+	/** Cached address, sa_family is AF_UNSPEC for a negative entry */
+	struct sockaddr addr;
+
+	/** Type of the query that the answer was received for */
+	enum dns_query_type type;
+
+	char query[NAME_LEN + 1];
+};
+
+static struct dns_cache_entry cache[CONFIG_DNS_RESOLVER_CACHE_MAX_ENTRIES];
+static uint32_t cache_hits;
+static uint32_t cache_misses;
+static K_MUTEX_DEFINE(cache_lock);
+
+static bool entry_is_valid(struct dns_cache_entry *entry, int64_t now)
+{
+	return entry->expiry > now;
+}
+
+static bool entry_matches(struct dns_cache_entry *entry, const char *query,
+			  enum dns_query_type type)
+{
+	return entry->type == type &&
+		strncasecmp(entry->query, query, sizeof(entry->query)) == 0;
+}
+
+static bool addr_matches(const struct sockaddr *a, const struct sockaddr *b)
+{
+	if (a->sa_family != b->sa_family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && a->sa_family == AF_INET6) {
+		return net_ipv6_addr_cmp(&net_sin6(a)->sin6_addr,
+					 &net_sin6(b)->sin6_addr);
+	}
+
+	if (a->sa_family == AF_INET) {
+		return net_ipv4_addr_cmp(&net_sin(a)->sin_addr,
+					 &net_sin(b)->sin_addr);
+	}
+
+	return true;
+}
+
+/* Returns a free or stale slot, or the entry that is closest to going
+ * stale if the cache is full.
+ */
+static struct dns_cache_entry *get_free_entry(int64_t now)
+{
+	struct dns_cache_entry *oldest = &cache[0];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!entry_is_valid(&cache[i], now)) {
+			return &cache[i];
+		}
+
+		if (cache[i].expiry < oldest->expiry) {
+			oldest = &cache[i];
+		}
+	}
+
+	NET_DBG("Evicting %s from DNS cache", log_strdup(oldest->query));
+
+	return oldest;
+}
+
+/* An address answer replaces the negative entry of the query and a
+ * negative answer replaces the addresses.
+ */
+static void remove_entries(const char *query, enum dns_query_type type,
+			   bool remove_negative)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		bool negative = cache[i].addr.sa_family == AF_UNSPEC;
+
+		if (!cache[i].expiry ||
+		    !entry_matches(&cache[i], query, type)) {
+			continue;
+		}
+
+		if (negative == remove_negative) {
+			cache[i].expiry = 0;
+		}
+	}
+}
+
+static void add_entry(const char *query, enum dns_query_type type,
+		      const struct sockaddr *addr, uint32_t ttl)
+{
+	struct dns_cache_entry *entry = NULL;
+	int64_t now = k_uptime_get();
+	int i;
+
+	if (strlen(query) > NAME_LEN) {
+		return;
+	}
+
+	ttl = MIN(ttl, CONFIG_DNS_RESOLVER_CACHE_MAX_TTL);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	remove_entries(query, type, addr->sa_family != AF_UNSPEC);
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (entry_is_valid(&cache[i], now) &&
+		    entry_matches(&cache[i], query, type) &&
+		    addr_matches(&cache[i].addr, addr)) {
+			entry = &cache[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		entry = get_free_entry(now);
+
+		strcpy(entry->query, query);
+		entry->type = type;
+		memcpy(&entry->addr, addr, sizeof(entry->addr));
+	}
+
+	entry->expiry = now + (int64_t)ttl * MSEC_PER_SEC;
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl)
+{
+	/* A zero TTL answer is only good for the transaction at hand */
+	if (ttl == 0U) {
+		return;
+	}
+
+	add_entry(query, type, &info->ai_addr, ttl);
+}
+
+void dns_cache_add_negative(const char *query, enum dns_query_type type)
+{
+	struct sockaddr addr = { .sa_family = AF_UNSPEC };
+
+	if (CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL == 0) {
+		return;
+	}
+
+	add_entry(query, type, &addr, CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+}
+
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, int count)
+{
+	int64_t now = k_uptime_get();
+	bool negative = false;
+	int found = 0;
+	int i;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(cache) && found < count; i++) {
+		if (!entry_is_valid(&cache[i], now) ||
+		    !entry_matches(&cache[i], query, type)) {
+			continue;
+		}
+
+		if (cache[i].addr.sa_family == AF_UNSPEC) {
+			negative = true;
+			continue;
+		}
+
+		memset(&info[found], 0, sizeof(info[found]));
+		memcpy(&info[found].ai_addr, &cache[i].addr,
+		       sizeof(info[found].ai_addr));
+		info[found].ai_family = cache[i].addr.sa_family;
+		info[found].ai_addrlen = cache[i].addr.sa_family == AF_INET ?
+			sizeof(struct sockaddr_in) :
+			sizeof(struct sockaddr_in6);
+		found++;
+	}
+
+	if (found || negative) {
+		cache_hits++;
+	} else {
+		cache_misses++;
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return (found || negative) ? found : -ENOENT;
+}
+
+void dns_cache_flush(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	memset(cache, 0, sizeof(cache));
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void dns_cache_foreach(dns_cache_cb_t cb, void *user_data)
+{
+	int64_t now = k_uptime_get();
+	struct dns_addrinfo info;
+	int i;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!entry_is_valid(&cache[i], now)) {
+			continue;
+		}
+
+		memset(&info, 0, sizeof(info));
+		memcpy(&info.ai_addr, &cache[i].addr, sizeof(info.ai_addr));
+		info.ai_family = cache[i].addr.sa_family;
+
+		cb(cache[i].query, cache[i].type,
+		   info.ai_family == AF_UNSPEC ? NULL : &info,
+		   (uint32_t)((cache[i].expiry - now) / MSEC_PER_SEC),
+		   user_data);
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+void dns_cache_get_stats(uint32_t *hits, uint32_t *misses)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	*hits = cache_hits;
+	*misses = cache_misses;
+
+	k_mutex_unlock(&cache_lock);
+}
@@ -16,3 +16,28 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     int *query_idx,
 		     struct net_buf *dns_cname,
 		     uint16_t *query_hash);
+
+/* At most this many cached addresses are returned for one query */
+#define DNS_CACHE_MAX_ADDRS 4
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+void dns_cache_add(const char *query, enum dns_query_type type,
+		   const struct dns_addrinfo *info, uint32_t ttl);
+void dns_cache_add_negative(const char *query, enum dns_query_type type);
+
+/* Returns the number of addresses copied to info, 0 if the name is known
+ * not to exist and -ENOENT if nothing is cached for it.
+ */
+int dns_cache_find(const char *query, enum dns_query_type type,
+		   struct dns_addrinfo *info, int count);
+#else
+static inline void dns_cache_add(const char *query, enum dns_query_type type,
+				 const struct dns_addrinfo *info, uint32_t ttl)
+{
+}
+
+static inline void dns_cache_add_negative(const char *query,
+					  enum dns_query_type type)
+{
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
@@ -369,7 +369,7 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		     uint16_t *query_hash)
 {
 	struct dns_addrinfo info = { 0 };
-	uint32_t ttl; /* RR ttl, so far it is not passed to caller */
+	uint32_t ttl; /* RR ttl, only used by the answer cache */
 	uint8_t *src, *addr;
 	const char *query_name;
 	int address_size;
@@ -531,6 +531,9 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 		query_known:
 			ctx->queries[*query_idx].cb(DNS_EAI_INPROGRESS, &info,
 					ctx->queries[*query_idx].user_data);
+			dns_cache_add(ctx->queries[*query_idx].query,
+				      ctx->queries[*query_idx].query_type,
+				      &info, ttl);
 			items++;
 			break;
 
@@ -597,6 +600,8 @@ int dns_validate_msg(struct dns_resolve_context *ctx,
 	}
 
 	if (items == 0) {
+		dns_cache_add_negative(ctx->queries[*query_idx].query,
+				       ctx->queries[*query_idx].query_type);
 		ret = DNS_EAI_NODATA;
 	} else {
 		ret = DNS_EAI_ALLDONE;
@@ -1006,6 +1011,28 @@ int dns_resolve_name(struct dns_resolve_context *ctx,
 	}
 
 try_resolve:
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+	{
+		struct dns_addrinfo cached[DNS_CACHE_MAX_ADDRS];
+
+		ret = dns_cache_find(query, type, cached, ARRAY_SIZE(cached));
+		if (ret >= 0) {
+			for (j = 0; j < ret; j++) {
+				cb(DNS_EAI_INPROGRESS, &cached[j], user_data);
+			}
+
+			cb(ret ? DNS_EAI_ALLDONE : DNS_EAI_NODATA, NULL,
+			   user_data);
+
+			if (dns_id) {
+				*dns_id = 0U;
+			}
+
+			return 0;
+		}
+	}
+#endif
+
 	i = get_cb_slot(ctx);
 	if (i < 0) {
 		return -EAGAIN;
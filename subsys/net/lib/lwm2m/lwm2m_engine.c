@@ -45,6 +45,9 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #ifdef CONFIG_LWM2M_RW_JSON_SUPPORT
 #include "lwm2m_rw_json.h"
 #endif
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+#include "lwm2m_rw_senml_cbor.h"
+#endif
 #ifdef CONFIG_LWM2M_RD_CLIENT_SUPPORT
 #include "lwm2m_rd_client.h"
 #endif
@@ -91,6 +94,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 
 struct observe_node {
 	sys_snode_t node;
+	sys_snode_t bucket_node;
 	struct lwm2m_ctx *ctx;
 	struct lwm2m_obj_path path;
 	uint8_t  token[MAX_TOKEN_LEN];
@@ -129,6 +133,10 @@ static struct service_node service_node_data[MAX_PERIODIC_SERVICE];
 static sys_slist_t engine_obj_list;
 static sys_slist_t engine_obj_inst_list;
 static sys_slist_t engine_observer_list;
+/* Observers hashed on the resource they watch, or on their object
+ * instance when they watch more than a single resource.
+ */
+static sys_slist_t observer_buckets[CONFIG_LWM2M_ENGINE_OBSERVER_BUCKETS];
 static sys_slist_t engine_service_list;
 
 static K_KERNEL_STACK_DEFINE(engine_thread_stack,
@@ -363,17 +371,48 @@ static void clear_attrs(void *ref)
 	}
 }
 
-int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
+static sys_slist_t *observer_bucket(uint16_t obj_id, uint16_t obj_inst_id,
+				    uint16_t res_id, bool any_res)
 {
+	uint32_t hash = obj_id;
+
+	hash = hash * 31U + obj_inst_id;
+	if (!any_res) {
+		hash = hash * 31U + res_id + 1U;
+	}
+
+	return &observer_buckets[hash % ARRAY_SIZE(observer_buckets)];
+}
+
+static sys_slist_t *observer_bucket_of(struct observe_node *obs)
+{
+	return observer_bucket(obs->path.obj_id, obs->path.obj_inst_id,
+			       obs->path.res_id, obs->path.level < 3);
+}
+
+static void engine_observer_list_remove(sys_snode_t *prev_node,
+					struct observe_node *obs)
+{
+	sys_slist_remove(&engine_observer_list, prev_node, &obs->node);
+	sys_slist_find_and_remove(observer_bucket_of(obs), &obs->bucket_node);
+	(void)memset(obs, 0, sizeof(*obs));
+}
+
+static int notify_observer_bucket(uint16_t obj_id, uint16_t obj_inst_id,
+				  uint16_t res_id, bool any_res)
+{
+	sys_slist_t *bucket;
 	struct observe_node *obs;
 	int ret = 0;
 
+	bucket = observer_bucket(obj_id, obj_inst_id, res_id, any_res);
+
 	/* look for observers which match our resource */
-	SYS_SLIST_FOR_EACH_CONTAINER(&engine_observer_list, obs, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, obs, bucket_node) {
 		if (obs->path.obj_id == obj_id &&
 		    obs->path.obj_inst_id == obj_inst_id &&
-		    (obs->path.level < 3 ||
-		     obs->path.res_id == res_id)) {
+		    (obs->path.level < 3) == any_res &&
+		    (any_res || obs->path.res_id == res_id)) {
 			/* update the event time for this observer */
 			obs->event_timestamp = k_uptime_get();
 
@@ -387,6 +426,13 @@ int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id
 	return ret;
 }
 
+int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
+{
+	/* observers of the resource, then of the whole object instance */
+	return notify_observer_bucket(obj_id, obj_inst_id, res_id, false) +
+	       notify_observer_bucket(obj_id, obj_inst_id, res_id, true);
+}
+
 int lwm2m_notify_observer_path(struct lwm2m_obj_path *path)
 {
 	return lwm2m_notify_observer(path->obj_id, path->obj_inst_id,
@@ -532,6 +578,8 @@ static int engine_add_observer(struct lwm2m_message *msg,
 	observe_node_data[i].counter = OBSERVE_COUNTER_START;
 	sys_slist_append(&engine_observer_list,
 			 &observe_node_data[i].node);
+	sys_slist_append(observer_bucket_of(&observe_node_data[i]),
+			 &observe_node_data[i].bucket_node);
 
 	LOG_DBG("OBSERVER ADDED %u/%u/%u(%u) token:'%s' addr:%s",
 		msg->path.obj_id, msg->path.obj_inst_id,
@@ -567,8 +615,7 @@ static int engine_remove_observer(const uint8_t *token, uint8_t tkl)
 		return -ENOENT;
 	}
 
-	sys_slist_remove(&engine_observer_list, prev_node, &found_obj->node);
-	(void)memset(found_obj, 0, sizeof(*found_obj));
+	engine_observer_list_remove(prev_node, found_obj);
 
 	LOG_DBG("observer '%s' removed", log_strdup(sprint_token(token, tkl)));
 
@@ -589,8 +636,7 @@ static void engine_remove_observer_by_id(uint16_t obj_id, int32_t obj_inst_id)
 			continue;
 		}
 
-		sys_slist_remove(&engine_observer_list, prev_node, &obs->node);
-		(void)memset(obs, 0, sizeof(*obs));
+		engine_observer_list_remove(prev_node, obs);
 	}
 }
 
@@ -640,6 +686,14 @@ lwm2m_get_engine_obj_field(struct lwm2m_engine_obj *obj, int res_id)
 
 static void engine_register_obj_inst(struct lwm2m_engine_obj_inst *obj_inst)
 {
+	static uint32_t generation;
+
+	/* 0 is left for instances which are not registered */
+	if (++generation == 0U) {
+		generation++;
+	}
+
+	obj_inst->generation = generation;
 	sys_slist_append(&engine_obj_inst_list, &obj_inst->node);
 }
 
@@ -1185,6 +1239,18 @@ static int select_writer(struct lwm2m_output_context *out, uint16_t accept)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		out->writer = &json_writer;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		out->writer = &senml_cbor_writer;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", accept);
 		return -ENOMSG;
@@ -1216,6 +1282,18 @@ static int select_reader(struct lwm2m_input_context *in, uint16_t format)
 		break;
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		in->reader = &json_reader;
+		break;
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		in->reader = &senml_cbor_reader;
+		break;
+#endif
+
 	default:
 		LOG_WRN("Unknown content type %u", format);
 		return -ENOMSG;
@@ -1425,19 +1503,10 @@ int lwm2m_engine_set_res_data(char *pathstr, void *data_ptr, uint16_t data_len,
 	return ret;
 }
 
-static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
+int lwm2m_engine_resolve_path(char *pathstr, struct lwm2m_res_handle *handle)
 {
 	struct lwm2m_obj_path path;
-	struct lwm2m_engine_obj_inst *obj_inst;
-	struct lwm2m_engine_obj_field *obj_field;
-	struct lwm2m_engine_res *res = NULL;
-	struct lwm2m_engine_res_inst *res_inst = NULL;
-	void *data_ptr = NULL;
-	size_t max_data_len = 0;
-	int ret = 0;
-	bool changed = false;
-
-	LOG_DBG("path:%s, value:%p, len:%d", log_strdup(pathstr), value, len);
+	int ret;
 
 	/* translate path -> path_obj */
 	ret = string_to_path(pathstr, &path, '/');
@@ -1450,21 +1519,59 @@ static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
 		return -EINVAL;
 	}
 
+	(void)memset(handle, 0, sizeof(*handle));
+
 	/* look up resource obj */
-	ret = path_to_objs(&path, &obj_inst, &obj_field, &res, &res_inst);
+	ret = path_to_objs(&path, &handle->obj_inst, &handle->obj_field,
+			   &handle->res, &handle->res_inst);
 	if (ret < 0) {
 		return ret;
 	}
 
-	if (!res_inst) {
+	if (!handle->res_inst) {
 		LOG_ERR("res instance %d not found", path.res_inst_id);
 		return -ENOENT;
 	}
 
+	handle->generation = handle->obj_inst->generation;
+
+	return 0;
+}
+
+/* The object instance of the handle, or the resource instance, may have
+ * been deleted since the path was resolved.
+ */
+static int handle_check(const struct lwm2m_res_handle *handle)
+{
+	if (!handle || !handle->res_inst) {
+		return -EINVAL;
+	}
+
+	if (handle->generation != handle->obj_inst->generation ||
+	    handle->res_inst->res_inst_id == RES_INSTANCE_NOT_CREATED) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+static int engine_set(const struct lwm2m_res_handle *handle, void *value,
+		      uint16_t len)
+{
+	struct lwm2m_engine_obj_inst *obj_inst = handle->obj_inst;
+	struct lwm2m_engine_obj_field *obj_field = handle->obj_field;
+	struct lwm2m_engine_res *res = handle->res;
+	struct lwm2m_engine_res_inst *res_inst = handle->res_inst;
+	void *data_ptr = NULL;
+	size_t max_data_len = 0;
+	int ret = 0;
+	bool changed = false;
+
 	if (LWM2M_HAS_RES_FLAG(res_inst, LWM2M_RES_DATA_FLAG_RO)) {
 		LOG_ERR("res instance data pointer is read-only "
-			"[%u/%u/%u/%u:%u]", path.obj_id, path.obj_inst_id,
-			path.res_id, path.res_inst_id, path.level);
+			"[%u/%u/%u/%u]", obj_inst->obj->obj_id,
+			obj_inst->obj_inst_id, res->res_id,
+			res_inst->res_inst_id);
 		return -EACCES;
 	}
 
@@ -1480,9 +1587,9 @@ static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
 	}
 
 	if (!data_ptr) {
-		LOG_ERR("res instance data pointer is NULL [%u/%u/%u/%u:%u]",
-			path.obj_id, path.obj_inst_id, path.res_id,
-			path.res_inst_id, path.level);
+		LOG_ERR("res instance data pointer is NULL [%u/%u/%u/%u]",
+			obj_inst->obj->obj_id, obj_inst->obj_inst_id,
+			res->res_id, res_inst->res_inst_id);
 		return -EINVAL;
 	}
 
@@ -1490,7 +1597,7 @@ static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
 	if (len > max_data_len -
 		(obj_field->data_type == LWM2M_RES_TYPE_STRING ? 1 : 0)) {
 		LOG_ERR("length %u is too long for res instance %d data",
-			len, path.res_id);
+			len, res->res_id);
 		return -ENOMEM;
 	}
 
@@ -1580,12 +1687,41 @@ static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
 	}
 
 	if (changed) {
-		NOTIFY_OBSERVER_PATH(&path);
+		NOTIFY_OBSERVER(obj_inst->obj->obj_id, obj_inst->obj_inst_id,
+				res->res_id);
 	}
 
 	return ret;
 }
 
+static int lwm2m_engine_set(char *pathstr, void *value, uint16_t len)
+{
+	struct lwm2m_res_handle handle;
+	int ret;
+
+	LOG_DBG("path:%s, value:%p, len:%d", log_strdup(pathstr), value, len);
+
+	ret = lwm2m_engine_resolve_path(pathstr, &handle);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return engine_set(&handle, value, len);
+}
+
+int lwm2m_engine_set_by_handle(const struct lwm2m_res_handle *handle,
+			       void *value, uint16_t len)
+{
+	int ret;
+
+	ret = handle_check(handle);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return engine_set(handle, value, len);
+}
+
 int lwm2m_engine_set_opaque(char *pathstr, char *data_ptr, uint16_t data_len)
 {
 	return lwm2m_engine_set(pathstr, data_ptr, data_len);
@@ -1696,41 +1832,16 @@ int lwm2m_engine_get_res_data(char *pathstr, void **data_ptr, uint16_t *data_len
 	return 0;
 }
 
-static int lwm2m_engine_get(char *pathstr, void *buf, uint16_t buflen)
+static int engine_get(const struct lwm2m_res_handle *handle, void *buf,
+		      uint16_t buflen)
 {
-	int ret = 0;
-	struct lwm2m_obj_path path;
-	struct lwm2m_engine_obj_inst *obj_inst;
-	struct lwm2m_engine_obj_field *obj_field;
-	struct lwm2m_engine_res *res = NULL;
-	struct lwm2m_engine_res_inst *res_inst = NULL;
+	struct lwm2m_engine_obj_inst *obj_inst = handle->obj_inst;
+	struct lwm2m_engine_obj_field *obj_field = handle->obj_field;
+	struct lwm2m_engine_res *res = handle->res;
+	struct lwm2m_engine_res_inst *res_inst = handle->res_inst;
 	void *data_ptr = NULL;
 	size_t data_len = 0;
 
-	LOG_DBG("path:%s, buf:%p, buflen:%d", log_strdup(pathstr), buf, buflen);
-
-	/* translate path -> path_obj */
-	ret = string_to_path(pathstr, &path, '/');
-	if (ret < 0) {
-		return ret;
-	}
-
-	if (path.level < 3) {
-		LOG_ERR("path must have at least 3 parts");
-		return -EINVAL;
-	}
-
-	/* look up resource obj */
-	ret = path_to_objs(&path, &obj_inst, &obj_field, &res, &res_inst);
-	if (ret < 0) {
-		return ret;
-	}
-
-	if (!res_inst) {
-		LOG_ERR("res instance %d not found", path.res_inst_id);
-		return -ENOENT;
-	}
-
 	/* setup initial data elements */
 	data_ptr = res_inst->data_ptr;
 	data_len = res_inst->data_len;
@@ -1826,6 +1937,34 @@ static int lwm2m_engine_get(char *pathstr, void *buf, uint16_t buflen)
 	return 0;
 }
 
+static int lwm2m_engine_get(char *pathstr, void *buf, uint16_t buflen)
+{
+	struct lwm2m_res_handle handle;
+	int ret;
+
+	LOG_DBG("path:%s, buf:%p, buflen:%d", log_strdup(pathstr), buf, buflen);
+
+	ret = lwm2m_engine_resolve_path(pathstr, &handle);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return engine_get(&handle, buf, buflen);
+}
+
+int lwm2m_engine_get_by_handle(const struct lwm2m_res_handle *handle,
+			       void *buf, uint16_t buflen)
+{
+	int ret;
+
+	ret = handle_check(handle);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return engine_get(handle, buf, buflen);
+}
+
 int lwm2m_engine_get_opaque(char *pathstr, void *buf, uint16_t buflen)
 {
 	return lwm2m_engine_get(pathstr, buf, buflen);
@@ -2906,6 +3045,16 @@ static int do_read_op(struct lwm2m_message *msg, uint16_t content_format)
 		return do_read_op_json(msg, content_format);
 #endif
 
+#if defined(CONFIG_LWM2M_RW_SENML_JSON_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return do_read_op_senml_json(msg, content_format);
+#endif
+
+#if defined(CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT)
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_read_op_senml_cbor(msg, content_format);
+#endif
+
 	default:
 		LOG_ERR("Unsupported content-format: %u", content_format);
 		return -ENOMSG;
@@ -3289,6 +3438,78 @@ int lwm2m_get_or_create_engine_obj(struct lwm2m_message *msg,
 	return ret;
 }
 
+/*
+ * Resolve the resource instance msg->path points to for a write, creating
+ * the object instance if needed. SenML records are handled one at a time:
+ * "bn" updates the base name, "n" selects the resource with this and a
+ * value field writes it. The name is expected ahead of the value in a
+ * record, as every known server does.
+ */
+int lwm2m_get_write_target(struct lwm2m_message *msg,
+			   struct lwm2m_engine_obj_inst **obj_inst,
+			   struct lwm2m_engine_obj_field **obj_field,
+			   struct lwm2m_engine_res **res,
+			   struct lwm2m_engine_res_inst **res_inst)
+{
+	int ret, index;
+
+	*res = NULL;
+	*res_inst = NULL;
+
+	ret = lwm2m_get_or_create_engine_obj(msg, obj_inst, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*obj_field = lwm2m_get_engine_obj_field((*obj_inst)->obj,
+						msg->path.res_id);
+	/*
+	 * if obj_field is not found,
+	 * treat as an optional resource
+	 */
+	if (!*obj_field) {
+		return -ENOENT;
+	}
+
+	/*
+	 * TODO: support BOOTSTRAP WRITE where optional
+	 * resources are ignored
+	 */
+
+	if (!LWM2M_HAS_PERM(*obj_field, LWM2M_PERM_W)) {
+		return -EPERM;
+	}
+
+	if (!(*obj_inst)->resources || (*obj_inst)->resource_count == 0U) {
+		return -EINVAL;
+	}
+
+	for (index = 0; index < (*obj_inst)->resource_count; index++) {
+		if ((*obj_inst)->resources[index].res_id == msg->path.res_id) {
+			*res = &(*obj_inst)->resources[index];
+			break;
+		}
+	}
+
+	if (!*res) {
+		return -ENOENT;
+	}
+
+	for (index = 0; index < (*res)->res_inst_count; index++) {
+		if ((*res)->res_instances[index].res_inst_id ==
+		    msg->path.res_inst_id) {
+			*res_inst = &(*res)->res_instances[index];
+			break;
+		}
+	}
+
+	if (!*res_inst) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
 static int do_write_op(struct lwm2m_message *msg,
 		       uint16_t format)
 {
@@ -3309,6 +3530,16 @@ static int do_write_op(struct lwm2m_message *msg,
 		return do_write_op_json(msg);
 #endif
 
+#ifdef CONFIG_LWM2M_RW_SENML_JSON_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_JSON:
+		return do_write_op_senml_json(msg);
+#endif
+
+#ifdef CONFIG_LWM2M_RW_SENML_CBOR_SUPPORT
+	case LWM2M_FORMAT_APP_SENML_CBOR:
+		return do_write_op_senml_cbor(msg);
+#endif
+
 	default:
 		LOG_ERR("Unsupported format: %u", format);
 		return -ENOMSG;
@@ -4282,9 +4513,7 @@ int lwm2m_engine_context_close(struct lwm2m_ctx *client_ctx)
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&engine_observer_list,
 					  obs, tmp, node) {
 		if (obs->ctx == client_ctx) {
-			sys_slist_remove(&engine_observer_list, prev_node,
-					 &obs->node);
-			(void)memset(obs, 0, sizeof(*obs));
+			engine_observer_list_remove(prev_node, obs);
 		} else {
 			prev_node = &obs->node;
 		}
@@ -18,6 +18,8 @@
 #define LWM2M_FORMAT_APP_OCTET_STREAM	42
 #define LWM2M_FORMAT_APP_EXI		47
 #define LWM2M_FORMAT_APP_JSON		50
+#define LWM2M_FORMAT_APP_SENML_JSON	110
+#define LWM2M_FORMAT_APP_SENML_CBOR	112
 #define LWM2M_FORMAT_OMA_PLAIN_TEXT	1541
 #define LWM2M_FORMAT_OMA_OLD_TLV	1542
 #define LWM2M_FORMAT_OMA_OLD_JSON	1543
@@ -64,6 +66,11 @@ int  lwm2m_delete_obj_inst(uint16_t obj_id, uint16_t obj_inst_id);
 int  lwm2m_get_or_create_engine_obj(struct lwm2m_message *msg,
 				    struct lwm2m_engine_obj_inst **obj_inst,
 				    uint8_t *created);
+int  lwm2m_get_write_target(struct lwm2m_message *msg,
+			    struct lwm2m_engine_obj_inst **obj_inst,
+			    struct lwm2m_engine_obj_field **obj_field,
+			    struct lwm2m_engine_res **res,
+			    struct lwm2m_engine_res_inst **res_inst);
 
 /* LwM2M context functions */
 int lwm2m_engine_context_close(struct lwm2m_ctx *client_ctx);
@@ -353,6 +353,12 @@ struct lwm2m_engine_obj_inst {
 	/* object instance member data */
 	uint16_t obj_inst_id;
 	uint16_t resource_count;
+
+	/* set when registered, cleared when deleted; lets a
+	 * struct lwm2m_res_handle detect that it refers to a deleted
+	 * instance, even if the memory is reused for a new one
+	 */
+	uint32_t generation;
 };
 
 /* Initialize resource instances prior to use */
@@ -99,6 +99,9 @@ struct json_out_formatter_data {
 
 	/* path storage */
 	uint8_t path_level;
+
+	/* SenML JSON (RFC 8428) instead of OMA JSON */
+	bool senml;
 };
 
 struct json_in_formatter_data {
@@ -251,11 +254,33 @@ static int json_next_token(struct lwm2m_input_context *in,
 	return (cont == 0U);
 }
 
+static size_t put_char(struct lwm2m_output_context *out,
+		       char c)
+{
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), &c, sizeof(c)) < 0) {
+		/* TODO: Generate error? */
+		return 0;
+	}
+
+	return 1;
+}
+
 static size_t put_begin(struct lwm2m_output_context *out,
 			struct lwm2m_obj_path *path)
 {
+	struct json_out_formatter_data *fd;
 	int len = -1;
 
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	/* SenML JSON carries the base name in the first record */
+	if (fd->senml) {
+		return put_char(out, '[');
+	}
+
 	if (path->level >= 2U) {
 		len = snprintk(json_buffer, sizeof(json_buffer),
 			       "{\"bn\":\"/%u/%u/\",\"e\":[",
@@ -283,6 +308,17 @@ static size_t put_begin(struct lwm2m_output_context *out,
 static size_t put_end(struct lwm2m_output_context *out,
 		      struct lwm2m_obj_path *path)
 {
+	struct json_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	if (fd->senml) {
+		return put_char(out, ']');
+	}
+
 	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), "]}", 2) < 0) {
 		/* TODO: Generate error? */
 		return 0;
@@ -319,23 +355,12 @@ static size_t put_end_ri(struct lwm2m_output_context *out,
 	return 0;
 }
 
-static size_t put_char(struct lwm2m_output_context *out,
-		       char c)
-{
-	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), &c, sizeof(c)) < 0) {
-		/* TODO: Generate error? */
-		return 0;
-	}
-
-	return 1;
-}
-
 static size_t put_json_prefix(struct lwm2m_output_context *out,
 			      struct lwm2m_obj_path *path,
-			      const char *format)
+			      const char *format, const char *senml_format)
 {
 	struct json_out_formatter_data *fd;
-	char *sep;
+	char sep[sizeof("{\"bn\":\"/65535/65535/\",")];
 	int len = 0;
 
 	fd = engine_get_out_user_data(out);
@@ -343,27 +368,42 @@ static size_t put_json_prefix(struct lwm2m_output_context *out,
 		return 0;
 	}
 
-	sep = SEPARATOR(fd->writer_flags);
+	if (!fd->senml) {
+		snprintk(sep, sizeof(sep), "%s{", SEPARATOR(fd->writer_flags));
+	} else if (fd->writer_flags & WRITER_OUTPUT_VALUE) {
+		format = senml_format;
+		snprintk(sep, sizeof(sep), ",{");
+	} else {
+		format = senml_format;
+		if (fd->path_level >= 2U) {
+			snprintk(sep, sizeof(sep), "{\"bn\":\"/%u/%u/\",",
+				 path->obj_id, path->obj_inst_id);
+		} else {
+			snprintk(sep, sizeof(sep), "{\"bn\":\"/%u/\",",
+				 path->obj_id);
+		}
+	}
+
 	if (fd->path_level >= 2U) {
 		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
 			len = snprintk(json_buffer, sizeof(json_buffer),
-				       "%s{\"n\":\"%u/%u\",%s:",
+				       "%s\"n\":\"%u/%u\",%s:",
 				       sep, path->res_id, path->res_inst_id,
 				       format);
 		} else {
 			len = snprintk(json_buffer, sizeof(json_buffer),
-				       "%s{\"n\":\"%u\",%s:",
+				       "%s\"n\":\"%u\",%s:",
 				       sep, path->res_id, format);
 		}
 	} else {
 		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
 			len = snprintk(json_buffer, sizeof(json_buffer),
-				       "%s{\"n\":\"%u/%u/%u\",%s:",
+				       "%s\"n\":\"%u/%u/%u\",%s:",
 				       sep, path->obj_inst_id, path->res_id,
 				       path->res_inst_id, format);
 		} else {
 			len = snprintk(json_buffer, sizeof(json_buffer),
-				       "%s{\"n\":\"%u/%u\",%s:",
+				       "%s\"n\":\"%u/%u\",%s:",
 				       sep, path->obj_inst_id, path->res_id,
 				       format);
 		}
@@ -405,7 +445,7 @@ static size_t put_s32(struct lwm2m_output_context *out,
 {
 	int len;
 
-	len = put_json_prefix(out, path, "\"v\"");
+	len = put_json_prefix(out, path, "\"v\"", "\"v\"");
 	len += plain_text_put_format(out, "%d", value);
 	len += put_json_postfix(out);
 
@@ -429,7 +469,7 @@ static size_t put_s64(struct lwm2m_output_context *out,
 {
 	int len;
 
-	len = put_json_prefix(out, path, "\"v\"");
+	len = put_json_prefix(out, path, "\"v\"", "\"v\"");
 	len += plain_text_put_format(out, "%lld", value);
 	len += put_json_postfix(out);
 	return (size_t)len;
@@ -443,7 +483,7 @@ static size_t put_string(struct lwm2m_output_context *out,
 	size_t len = 0;
 	int res;
 
-	res = put_json_prefix(out, path, "\"sv\"");
+	res = put_json_prefix(out, path, "\"sv\"", "\"vs\"");
 	res += put_char(out, '"');
 
 	if (res < 0) {
@@ -496,7 +536,7 @@ static size_t put_float32fix(struct lwm2m_output_context *out,
 {
 	size_t len;
 
-	len = put_json_prefix(out, path, "\"v\"");
+	len = put_json_prefix(out, path, "\"v\"", "\"v\"");
 	len += plain_text_put_float32fix(out, path, value);
 	len += put_json_postfix(out);
 	return len;
@@ -508,7 +548,7 @@ static size_t put_float64fix(struct lwm2m_output_context *out,
 {
 	size_t len;
 
-	len = put_json_prefix(out, path, "\"v\"");
+	len = put_json_prefix(out, path, "\"v\"", "\"v\"");
 	len += plain_text_put_float64fix(out, path, value);
 	len += put_json_postfix(out);
 	return len;
@@ -520,7 +560,7 @@ static size_t put_bool(struct lwm2m_output_context *out,
 {
 	size_t len;
 
-	len = put_json_prefix(out, path, "\"bv\"");
+	len = put_json_prefix(out, path, "\"bv\"", "\"vb\"");
 	len += plain_text_put_format(out, "%s", value ? "true" : "false");
 	len += put_json_postfix(out);
 	return (size_t)len;
@@ -532,7 +572,7 @@ static size_t put_objlnk(struct lwm2m_output_context *out,
 {
 	size_t len;
 
-	len = put_json_prefix(out, path, "\"ov\"");
+	len = put_json_prefix(out, path, "\"ov\"", "\"vlo\"");
 	len += plain_text_put_format(out, "\"%u:%u\"", value->obj_id,
 				     value->obj_inst);
 	len += put_json_postfix(out);
@@ -808,6 +848,7 @@ static int parse_path(const uint8_t *buf, uint16_t buflen,
 		}
 	} while (pos < buflen);
 
+	path->level = ret;
 	return ret;
 }
 
@@ -819,11 +860,10 @@ int do_write_op_json(struct lwm2m_message *msg)
 	struct lwm2m_engine_res_inst *res_inst = NULL;
 	struct lwm2m_obj_path orig_path;
 	struct json_in_formatter_data fd;
-	int ret = 0, index;
+	int ret = 0;
 	uint8_t value[TOKEN_BUF_LEN];
 	uint8_t base_name[MAX_RESOURCE_LEN];
 	uint8_t full_name[MAX_RESOURCE_LEN];
-	uint8_t created;
 
 	(void)memset(&fd, 0, sizeof(fd));
 	engine_set_in_user_data(&msg->in, &fd);
@@ -860,9 +900,6 @@ int do_write_op_json(struct lwm2m_message *msg)
 
 		/* handle resource name */
 		if (value[0] == 'n') {
-			/* reset values */
-			created = 0U;
-
 			/* get value for relative path */
 			if (buf_read(value, fd.value_len,
 				     CPKT_BUF_READ(msg->in.in_cpkt),
@@ -875,86 +912,160 @@ int do_write_op_json(struct lwm2m_message *msg)
 			snprintk(full_name, sizeof(full_name), "%s%s",
 				 base_name, value);
 
-			/* parse full_name into path */
 			ret = parse_path(full_name, strlen(full_name),
 					 &msg->path);
-			if (ret < 0) {
-				break;
+			if (ret >= 0) {
+				ret = lwm2m_get_write_target(msg, &obj_inst,
+							     &obj_field, &res,
+							     &res_inst);
 			}
 
-			/* if valid, use the return value as level */
-			msg->path.level = ret;
-
-			ret = lwm2m_get_or_create_engine_obj(msg, &obj_inst,
-							     &created);
 			if (ret < 0) {
 				break;
 			}
-
-			obj_field = lwm2m_get_engine_obj_field(
-							obj_inst->obj,
-							msg->path.res_id);
-			/*
-			 * if obj_field is not found,
-			 * treat as an optional resource
-			 */
-			if (!obj_field) {
-				ret = -ENOENT;
+		} else if (res && res_inst) {
+			/* handle value assignment */
+			ret = lwm2m_write_handler(obj_inst, res, res_inst,
+						  obj_field, msg);
+			if (orig_path.level >= 3U && ret < 0) {
+				/* return errors on a single write */
 				break;
 			}
+		} else {
+			/* complain about error? */
+		}
+	}
 
-			/*
-			 * TODO: support BOOTSTRAP WRITE where optional
-			 * resources are ignored
-			 */
+	engine_clear_in_user_data(&msg->in);
 
-			if (!LWM2M_HAS_PERM(obj_field, LWM2M_PERM_W)) {
-				ret = -EPERM;
+	return ret;
+}
+
+#if defined(CONFIG_LWM2M_RW_SENML_JSON_SUPPORT)
+int do_read_op_senml_json(struct lwm2m_message *msg, int content_format)
+{
+	struct json_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	fd.senml = true;
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	return ret;
+}
+
+static bool token_name_is(struct lwm2m_input_context *in,
+			  struct json_in_formatter_data *fd, const char *name)
+{
+	return fd->name_len == strlen(name) &&
+	       !strncmp(in->in_cpkt->data + fd->name_offset, name,
+			fd->name_len);
+}
+
+static int read_token_value(struct lwm2m_input_context *in,
+			    struct json_in_formatter_data *fd,
+			    char *buf, size_t buflen)
+{
+	if (fd->value_len >= buflen) {
+		return -ENOMEM;
+	}
+
+	if (buf_read(buf, fd->value_len, CPKT_BUF_READ(in->in_cpkt),
+		     &fd->value_offset) < 0) {
+		return -EINVAL;
+	}
+
+	buf[fd->value_len] = '\0';
+	return 0;
+}
+
+/* SenML records are JSON objects in a JSON array */
+int do_write_op_senml_json(struct lwm2m_message *msg)
+{
+	struct lwm2m_engine_obj_field *obj_field = NULL;
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res = NULL;
+	struct lwm2m_engine_res_inst *res_inst = NULL;
+	struct json_in_formatter_data fd;
+	uint8_t level = msg->path.level;
+	char base_name[sizeof("/65535/65535/65535/65535")] = "";
+	char name[sizeof(base_name)];
+	char full_name[sizeof(base_name)];
+	bool named = false;
+	int ret = 0;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_in_user_data(&msg->in, &fd);
+
+	while (json_next_token(&msg->in, &fd)) {
+		/* the first token of a record carries the opening brace */
+		if (fd.json_flags & T_OBJECT_BEGIN) {
+			named = false;
+		}
+
+		if (!(fd.json_flags & T_VALUE)) {
+			continue;
+		}
+
+		if (token_name_is(&msg->in, &fd, "bn")) {
+			ret = read_token_value(&msg->in, &fd, base_name,
+					       sizeof(base_name));
+			if (ret < 0) {
+				LOG_ERR("Error parsing base name!");
 				break;
 			}
-
-			if (!obj_inst->resources ||
-			    obj_inst->resource_count == 0U) {
-				ret = -EINVAL;
+		} else if (token_name_is(&msg->in, &fd, "n")) {
+			ret = read_token_value(&msg->in, &fd, name,
+					       sizeof(name));
+			if (ret < 0) {
+				LOG_ERR("Error parsing name!");
 				break;
 			}
 
-			for (index = 0; index < obj_inst->resource_count;
-			     index++) {
-				if (obj_inst->resources[index].res_id ==
-				    msg->path.res_id) {
-					res = &obj_inst->resources[index];
-					break;
-				}
+			snprintk(full_name, sizeof(full_name), "%s%s",
+				 base_name, name);
+			ret = parse_path(full_name, strlen(full_name),
+					 &msg->path);
+			if (ret >= 0) {
+				ret = lwm2m_get_write_target(msg, &obj_inst,
+							     &obj_field, &res,
+							     &res_inst);
 			}
 
-			if (!res) {
-				ret = -ENOENT;
+			if (ret < 0) {
 				break;
 			}
 
-			for (index = 0; index < res->res_inst_count; index++) {
-				if (res->res_instances[index].res_inst_id ==
-				    msg->path.res_inst_id) {
-					res_inst = &res->res_instances[index];
+			named = true;
+		} else if (token_name_is(&msg->in, &fd, "v") ||
+			   token_name_is(&msg->in, &fd, "vs") ||
+			   token_name_is(&msg->in, &fd, "vb") ||
+			   token_name_is(&msg->in, &fd, "vlo")) {
+			/* without a name the base name is the resource */
+			if (!named) {
+				ret = parse_path(base_name, strlen(base_name),
+						 &msg->path);
+				if (ret >= 0) {
+					ret = lwm2m_get_write_target(
+						msg, &obj_inst, &obj_field,
+						&res, &res_inst);
+				}
+
+				if (ret < 0) {
 					break;
 				}
 			}
 
-			if (!res_inst) {
-				ret = -ENOENT;
-				break;
-			}
-		} else if (res && res_inst) {
-			/* handle value assignment */
 			ret = lwm2m_write_handler(obj_inst, res, res_inst,
 						  obj_field, msg);
-			if (orig_path.level >= 3U && ret < 0) {
+			if (level >= 3U && ret < 0) {
 				/* return errors on a single write */
 				break;
 			}
-		} else {
-			/* complain about error? */
 		}
 	}
 
@@ -962,3 +1073,4 @@ int do_write_op_json(struct lwm2m_message *msg)
 
 	return ret;
 }
+#endif /* CONFIG_LWM2M_RW_SENML_JSON_SUPPORT */
@@ -51,4 +51,8 @@ extern const struct lwm2m_reader json_reader;
 int do_read_op_json(struct lwm2m_message *msg, int content_format);
 int do_write_op_json(struct lwm2m_message *msg);
 
+/* SenML JSON shares the JSON writer and reader */
+int do_read_op_senml_json(struct lwm2m_message *msg, int content_format);
+int do_write_op_senml_json(struct lwm2m_message *msg);
+
 #endif /* LWM2M_RW_JSON_H_ */
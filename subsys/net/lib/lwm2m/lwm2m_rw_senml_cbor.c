@@ -0,0 +1,1028 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SenML CBOR content format (RFC 8428 section 6) for LwM2M 1.1.
+ *
+ * The writer encodes the records straight into the CoAP packet buffer,
+ * there is no intermediate document. The reader decodes the items in
+ * place from the request payload.
+ */
+
+#define LOG_MODULE_NAME net_lwm2m_senml_cbor
+#define LOG_LEVEL CONFIG_LWM2M_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <sys/byteorder.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_rw_senml_cbor.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_util.h"
+
+/* CBOR major types */
+#define CBOR_UINT	0
+#define CBOR_NINT	1
+#define CBOR_BSTR	2
+#define CBOR_TSTR	3
+#define CBOR_ARRAY	4
+#define CBOR_MAP	5
+#define CBOR_TAG	6
+#define CBOR_SIMPLE	7
+
+/* CBOR additional information */
+#define CBOR_AI_U8		24
+#define CBOR_AI_U16		25
+#define CBOR_AI_U32		26
+#define CBOR_AI_U64		27
+#define CBOR_AI_INDEFINITE	31
+
+#define CBOR_FALSE		0xf4
+#define CBOR_TRUE		0xf5
+#define CBOR_FLOAT32		0xfa
+#define CBOR_FLOAT64		0xfb
+#define CBOR_BREAK		0xff
+
+#define CBOR_MAX_DEPTH		8
+
+/* SenML labels, RFC 8428 table 4 */
+#define SENML_LABEL_BN		-2
+#define SENML_LABEL_N		0
+#define SENML_LABEL_V		2
+#define SENML_LABEL_VS		3
+#define SENML_LABEL_VB		4
+#define SENML_LABEL_VD		8
+
+/* Text labels are mapped outside of the SenML label range */
+#define SENML_LABEL_VLO		INT64_MIN
+#define SENML_LABEL_OTHER	(INT64_MIN + 1)
+
+#define SENML_NAME_LEN		sizeof("/65535/65535/65535/65535")
+
+struct cbor_out_formatter_data {
+	/* flags */
+	uint8_t writer_flags;
+
+	/* path storage */
+	uint8_t path_level;
+
+	/* the message buffer ran out, the payload is truncated */
+	bool overflow;
+};
+
+static size_t put_bytes(struct lwm2m_output_context *out,
+			uint8_t *buf, size_t buflen)
+{
+	struct cbor_out_formatter_data *fd;
+
+	if (buf_append(CPKT_BUF_WRITE(out->out_cpkt), buf, buflen) < 0) {
+		/* reported by do_read_op_senml_cbor() once done */
+		fd = engine_get_out_user_data(out);
+		if (fd) {
+			fd->overflow = true;
+		}
+
+		return 0;
+	}
+
+	return buflen;
+}
+
+/* Item head with the argument in its shortest form */
+static size_t put_head(struct lwm2m_output_context *out,
+		       uint8_t major, uint64_t value)
+{
+	uint8_t head[9];
+	size_t len;
+
+	major <<= 5;
+
+	if (value < CBOR_AI_U8) {
+		head[0] = major | value;
+		len = 1;
+	} else if (value <= UINT8_MAX) {
+		head[0] = major | CBOR_AI_U8;
+		head[1] = value;
+		len = 2;
+	} else if (value <= UINT16_MAX) {
+		head[0] = major | CBOR_AI_U16;
+		sys_put_be16(value, &head[1]);
+		len = 3;
+	} else if (value <= UINT32_MAX) {
+		head[0] = major | CBOR_AI_U32;
+		sys_put_be32(value, &head[1]);
+		len = 5;
+	} else {
+		head[0] = major | CBOR_AI_U64;
+		sys_put_be64(value, &head[1]);
+		len = 9;
+	}
+
+	return put_bytes(out, head, len);
+}
+
+static size_t put_int(struct lwm2m_output_context *out, int64_t value)
+{
+	if (value < 0) {
+		return put_head(out, CBOR_NINT, ~(uint64_t)value);
+	}
+
+	return put_head(out, CBOR_UINT, value);
+}
+
+static size_t put_text(struct lwm2m_output_context *out,
+		       char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_head(out, CBOR_TSTR, buflen);
+	len += put_bytes(out, buf, buflen);
+	return len;
+}
+
+/* Opens a record and emits its name, the value label is up to the caller */
+static size_t put_record(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+	char name[SENML_NAME_LEN];
+	bool first;
+	size_t len;
+	int ret;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	/* the base name goes into the first record only */
+	first = !(fd->writer_flags & WRITER_OUTPUT_VALUE);
+	len = put_head(out, CBOR_MAP, first ? 3 : 2);
+
+	if (first) {
+		if (fd->path_level >= 2U) {
+			ret = snprintk(name, sizeof(name), "/%u/%u/",
+				       path->obj_id, path->obj_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "/%u/",
+				       path->obj_id);
+		}
+
+		len += put_int(out, SENML_LABEL_BN);
+		len += put_text(out, name, ret);
+	}
+
+	if (fd->path_level >= 2U) {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			ret = snprintk(name, sizeof(name), "%u/%u",
+				       path->res_id, path->res_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "%u",
+				       path->res_id);
+		}
+	} else {
+		if (fd->writer_flags & WRITER_RESOURCE_INSTANCE) {
+			ret = snprintk(name, sizeof(name), "%u/%u/%u",
+				       path->obj_inst_id, path->res_id,
+				       path->res_inst_id);
+		} else {
+			ret = snprintk(name, sizeof(name), "%u/%u",
+				       path->obj_inst_id, path->res_id);
+		}
+	}
+
+	len += put_int(out, SENML_LABEL_N);
+	len += put_text(out, name, ret);
+
+	fd->writer_flags |= WRITER_OUTPUT_VALUE;
+	return len;
+}
+
+static size_t put_begin(struct lwm2m_output_context *out,
+			struct lwm2m_obj_path *path)
+{
+	uint8_t c = (CBOR_ARRAY << 5) | CBOR_AI_INDEFINITE;
+
+	/* the record count is not known up front */
+	return put_bytes(out, &c, sizeof(c));
+}
+
+static size_t put_end(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path)
+{
+	uint8_t c = CBOR_BREAK;
+
+	return put_bytes(out, &c, sizeof(c));
+}
+
+static size_t put_begin_ri(struct lwm2m_output_context *out,
+			   struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags |= WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_end_ri(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path)
+{
+	struct cbor_out_formatter_data *fd;
+
+	fd = engine_get_out_user_data(out);
+	if (!fd) {
+		return 0;
+	}
+
+	fd->writer_flags &= ~WRITER_RESOURCE_INSTANCE;
+	return 0;
+}
+
+static size_t put_s64(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int64_t value)
+{
+	size_t len;
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_V);
+	len += put_int(out, value);
+	return len;
+}
+
+static size_t put_s32(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int32_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s16(struct lwm2m_output_context *out,
+		      struct lwm2m_obj_path *path, int16_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_s8(struct lwm2m_output_context *out,
+		     struct lwm2m_obj_path *path, int8_t value)
+{
+	return put_s64(out, path, (int64_t)value);
+}
+
+static size_t put_string(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_VS);
+	len += put_text(out, buf, buflen);
+	return len;
+}
+
+static size_t put_opaque(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 char *buf, size_t buflen)
+{
+	size_t len;
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_VD);
+	len += put_head(out, CBOR_BSTR, buflen);
+	len += put_bytes(out, buf, buflen);
+	return len;
+}
+
+static size_t put_float32fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float32_value_t *value)
+{
+	uint8_t b32[5] = { CBOR_FLOAT32 };
+	size_t len;
+	int ret;
+
+	/* whole numbers are shorter as integers */
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	ret = lwm2m_f32_to_b32(value, &b32[1], sizeof(b32) - 1);
+	if (ret < 0) {
+		LOG_ERR("float32 conversion error: %d", ret);
+		return 0;
+	}
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_V);
+	len += put_bytes(out, b32, sizeof(b32));
+	return len;
+}
+
+static size_t put_float64fix(struct lwm2m_output_context *out,
+			     struct lwm2m_obj_path *path,
+			     float64_value_t *value)
+{
+	uint8_t b64[9] = { CBOR_FLOAT64 };
+	size_t len;
+	int ret;
+
+	if (value->val2 == 0) {
+		return put_s64(out, path, value->val1);
+	}
+
+	ret = lwm2m_f64_to_b64(value, &b64[1], sizeof(b64) - 1);
+	if (ret < 0) {
+		LOG_ERR("float64 conversion error: %d", ret);
+		return 0;
+	}
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_V);
+	len += put_bytes(out, b64, sizeof(b64));
+	return len;
+}
+
+static size_t put_bool(struct lwm2m_output_context *out,
+		       struct lwm2m_obj_path *path,
+		       bool value)
+{
+	uint8_t c = value ? CBOR_TRUE : CBOR_FALSE;
+	size_t len;
+
+	len = put_record(out, path);
+	len += put_int(out, SENML_LABEL_VB);
+	len += put_bytes(out, &c, sizeof(c));
+	return len;
+}
+
+static size_t put_objlnk(struct lwm2m_output_context *out,
+			 struct lwm2m_obj_path *path,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	size_t len;
+	int ret;
+
+	ret = snprintk(buf, sizeof(buf), "%u:%u", value->obj_id,
+		       value->obj_inst);
+
+	len = put_record(out, path);
+	len += put_text(out, "vlo", strlen("vlo"));
+	len += put_text(out, buf, ret);
+	return len;
+}
+
+/* Reads an item head, the argument of an indefinite length item is 0 */
+static int get_head(struct lwm2m_input_context *in, uint8_t *major,
+		    uint8_t *ai, uint64_t *value)
+{
+	uint16_t v16;
+	uint32_t v32;
+	uint8_t c;
+	int ret;
+
+	ret = buf_read_u8(&c, CPKT_BUF_READ(in->in_cpkt), &in->offset);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*major = c >> 5;
+	*ai = c & 0x1f;
+
+	switch (*ai) {
+	case CBOR_AI_U8:
+		ret = buf_read_u8(&c, CPKT_BUF_READ(in->in_cpkt),
+				  &in->offset);
+		*value = c;
+		break;
+
+	case CBOR_AI_U16:
+		ret = buf_read_be16(&v16, CPKT_BUF_READ(in->in_cpkt),
+				    &in->offset);
+		*value = v16;
+		break;
+
+	case CBOR_AI_U32:
+		ret = buf_read_be32(&v32, CPKT_BUF_READ(in->in_cpkt),
+				    &in->offset);
+		*value = v32;
+		break;
+
+	case CBOR_AI_U64:
+		ret = buf_read_be32(&v32, CPKT_BUF_READ(in->in_cpkt),
+				    &in->offset);
+		*value = (uint64_t)v32 << 32;
+		if (ret == 0) {
+			ret = buf_read_be32(&v32, CPKT_BUF_READ(in->in_cpkt),
+					    &in->offset);
+			*value |= v32;
+		}
+		break;
+
+	case CBOR_AI_INDEFINITE:
+		*value = 0U;
+		break;
+
+	default:
+		if (*ai > CBOR_AI_U64) {
+			/* reserved */
+			return -EINVAL;
+		}
+
+		*value = *ai;
+		break;
+	}
+
+	return ret;
+}
+
+static bool at_break(struct lwm2m_input_context *in)
+{
+	return in->offset < in->in_cpkt->max_len &&
+	       in->in_cpkt->data[in->offset] == CBOR_BREAK;
+}
+
+static int skip_item(struct lwm2m_input_context *in, int depth)
+{
+	uint64_t count;
+	uint8_t major, ai;
+	int ret;
+
+	if (depth > CBOR_MAX_DEPTH) {
+		return -EINVAL;
+	}
+
+	ret = get_head(in, &major, &ai, &count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	switch (major) {
+	case CBOR_UINT:
+	case CBOR_NINT:
+		return 0;
+
+	case CBOR_TAG:
+		return skip_item(in, depth + 1);
+
+	case CBOR_SIMPLE:
+		/* the argument already held the value, a break is unexpected */
+		return ai == CBOR_AI_INDEFINITE ? -EINVAL : 0;
+
+	case CBOR_BSTR:
+	case CBOR_TSTR:
+		if (ai != CBOR_AI_INDEFINITE) {
+			if (count > UINT16_MAX) {
+				return -EINVAL;
+			}
+
+			return buf_skip(count, CPKT_BUF_READ(in->in_cpkt),
+					&in->offset);
+		}
+
+		break;
+
+	case CBOR_MAP:
+		count *= 2U;
+		break;
+	}
+
+	if (ai == CBOR_AI_INDEFINITE) {
+		while (!at_break(in)) {
+			ret = skip_item(in, depth + 1);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		/* consume the break */
+		in->offset++;
+		return 0;
+	}
+
+	while (count-- > 0U) {
+		ret = skip_item(in, depth + 1);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* binary16 and binary32 widened to binary64 bits, subnormals become 0 */
+static uint64_t float_to_b64(uint8_t ai, uint64_t bits)
+{
+	uint64_t sign;
+	int e;
+
+	if (ai == CBOR_AI_U16) {
+		sign = (bits >> 15) & 1U;
+		e = (bits >> 10) & 0x1f;
+		bits &= 0x3ff;
+		if (e == 0) {
+			return sign << 63;
+		}
+
+		e += e == 0x1f ? 2047 - 0x1f : 1023 - 15;
+		bits <<= 42;
+	} else if (ai == CBOR_AI_U32) {
+		sign = (bits >> 31) & 1U;
+		e = (bits >> 23) & 0xff;
+		bits &= 0x7fffff;
+		if (e == 0) {
+			return sign << 63;
+		}
+
+		e += e == 0xff ? 2047 - 0xff : 1023 - 127;
+		bits <<= 29;
+	} else {
+		return bits;
+	}
+
+	return (sign << 63) | ((uint64_t)e << 52) | bits;
+}
+
+/* Numeric value as fixed point, integers and floats are both accepted */
+static size_t get_number(struct lwm2m_input_context *in,
+			 float64_value_t *value)
+{
+	uint16_t start = in->offset;
+	uint8_t b64[8];
+	uint64_t arg;
+	uint8_t major, ai;
+
+	value->val1 = 0;
+	value->val2 = 0;
+
+	if (get_head(in, &major, &ai, &arg) < 0) {
+		return 0;
+	}
+
+	if (major == CBOR_UINT) {
+		value->val1 = arg;
+	} else if (major == CBOR_NINT) {
+		value->val1 = ~(int64_t)arg;
+	} else if (major == CBOR_SIMPLE && ai >= CBOR_AI_U16 &&
+		   ai <= CBOR_AI_U64) {
+		arg = float_to_b64(ai, arg);
+		/* the converter does not know about zero */
+		if ((arg << 1) != 0U) {
+			sys_put_be64(arg, b64);
+			lwm2m_b64_to_f64(b64, sizeof(b64), value);
+		}
+	} else {
+		in->offset = start;
+		return 0;
+	}
+
+	return in->offset - start;
+}
+
+static size_t get_s64(struct lwm2m_input_context *in, int64_t *value)
+{
+	float64_value_t number;
+	size_t len;
+
+	len = get_number(in, &number);
+	if (len > 0) {
+		*value = number.val1;
+	}
+
+	return len;
+}
+
+static size_t get_s32(struct lwm2m_input_context *in, int32_t *value)
+{
+	float64_value_t number;
+	size_t len;
+
+	len = get_number(in, &number);
+	if (len > 0) {
+		*value = (int32_t)number.val1;
+	}
+
+	return len;
+}
+
+static size_t get_float32fix(struct lwm2m_input_context *in,
+			     float32_value_t *value)
+{
+	float64_value_t number;
+	size_t len;
+
+	len = get_number(in, &number);
+	if (len > 0) {
+		value->val1 = (int32_t)number.val1;
+		value->val2 = (int32_t)(number.val2 /
+			(LWM2M_FLOAT64_DEC_MAX / LWM2M_FLOAT32_DEC_MAX));
+	}
+
+	return len;
+}
+
+static size_t get_float64fix(struct lwm2m_input_context *in,
+			     float64_value_t *value)
+{
+	return get_number(in, value);
+}
+
+/* Definite length string of the given major type */
+static int get_string_head(struct lwm2m_input_context *in, uint8_t type,
+			   uint16_t *len)
+{
+	uint8_t major, ai;
+	uint64_t arg;
+	int ret;
+
+	ret = get_head(in, &major, &ai, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major != type || ai == CBOR_AI_INDEFINITE || arg > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	*len = arg;
+	return 0;
+}
+
+static size_t get_string(struct lwm2m_input_context *in,
+			 uint8_t *buf, size_t buflen)
+{
+	uint16_t start = in->offset;
+	uint16_t len, copy;
+
+	if (buflen == 0 || get_string_head(in, CBOR_TSTR, &len) < 0) {
+		in->offset = start;
+		return 0;
+	}
+
+	copy = MIN(len, buflen - 1);
+	if (buf_read(buf, copy, CPKT_BUF_READ(in->in_cpkt),
+		     &in->offset) < 0 ||
+	    buf_skip(len - copy, CPKT_BUF_READ(in->in_cpkt),
+		     &in->offset) < 0) {
+		in->offset = start;
+		return 0;
+	}
+
+	buf[copy] = '\0';
+	return in->offset - start;
+}
+
+static size_t get_bool(struct lwm2m_input_context *in, bool *value)
+{
+	uint8_t c;
+
+	if (buf_read_u8(&c, CPKT_BUF_READ(in->in_cpkt), &in->offset) < 0) {
+		return 0;
+	}
+
+	if (c != CBOR_TRUE && c != CBOR_FALSE) {
+		in->offset--;
+		return 0;
+	}
+
+	*value = c == CBOR_TRUE;
+	return 1;
+}
+
+static size_t get_opaque(struct lwm2m_input_context *in,
+			 uint8_t *value, size_t buflen,
+			 struct lwm2m_opaque_context *opaque,
+			 bool *last_block)
+{
+	uint16_t len;
+
+	/* Get the byte string head only on first read. */
+	if (opaque->remaining == 0) {
+		if (get_string_head(in, CBOR_BSTR, &len) < 0) {
+			*last_block = true;
+			return 0;
+		}
+
+		opaque->len = len;
+		opaque->remaining = len;
+	}
+
+	return lwm2m_engine_get_opaque_more(in, value, buflen,
+					    opaque, last_block);
+}
+
+static size_t get_objlnk(struct lwm2m_input_context *in,
+			 struct lwm2m_objlnk *value)
+{
+	char buf[sizeof("65535:65535")];
+	char *end;
+	size_t len;
+
+	len = get_string(in, buf, sizeof(buf));
+	if (len == 0) {
+		return 0;
+	}
+
+	value->obj_id = strtoul(buf, &end, 10);
+	if (*end != ':') {
+		return 0;
+	}
+
+	value->obj_inst = strtoul(end + 1, NULL, 10);
+	return len;
+}
+
+const struct lwm2m_writer senml_cbor_writer = {
+	.put_begin = put_begin,
+	.put_end = put_end,
+	.put_begin_ri = put_begin_ri,
+	.put_end_ri = put_end_ri,
+	.put_s8 = put_s8,
+	.put_s16 = put_s16,
+	.put_s32 = put_s32,
+	.put_s64 = put_s64,
+	.put_string = put_string,
+	.put_float32fix = put_float32fix,
+	.put_float64fix = put_float64fix,
+	.put_bool = put_bool,
+	.put_opaque = put_opaque,
+	.put_objlnk = put_objlnk,
+};
+
+const struct lwm2m_reader senml_cbor_reader = {
+	.get_s32 = get_s32,
+	.get_s64 = get_s64,
+	.get_string = get_string,
+	.get_float32fix = get_float32fix,
+	.get_float64fix = get_float64fix,
+	.get_bool = get_bool,
+	.get_opaque = get_opaque,
+	.get_objlnk = get_objlnk,
+};
+
+int do_read_op_senml_cbor(struct lwm2m_message *msg, int content_format)
+{
+	struct cbor_out_formatter_data fd;
+	int ret;
+
+	(void)memset(&fd, 0, sizeof(fd));
+	engine_set_out_user_data(&msg->out, &fd);
+	/* save the level for output processing */
+	fd.path_level = msg->path.level;
+	ret = lwm2m_perform_read_op(msg, content_format);
+	engine_clear_out_user_data(&msg->out);
+
+	if (ret == 0 && fd.overflow) {
+		LOG_ERR("SenML CBOR payload does not fit in the message");
+		ret = -ENOMEM;
+	}
+
+	return ret;
+}
+
+static int parse_path(const char *buf, struct lwm2m_obj_path *path)
+{
+	uint16_t *ids[] = { &path->obj_id, &path->obj_inst_id,
+			    &path->res_id, &path->res_inst_id };
+	uint32_t val;
+	int level = 0;
+
+	(void)memset(path, 0, sizeof(*path));
+
+	if (*buf == '/') {
+		buf++;
+	}
+
+	while (*buf && level < ARRAY_SIZE(ids)) {
+		if (!isdigit((unsigned char)*buf)) {
+			return -EINVAL;
+		}
+
+		for (val = 0U; isdigit((unsigned char)*buf); buf++) {
+			val = val * 10U + (*buf - '0');
+			if (val > UINT16_MAX) {
+				return -EINVAL;
+			}
+		}
+
+		*ids[level++] = val;
+
+		if (*buf == '/') {
+			buf++;
+		} else if (*buf) {
+			return -EINVAL;
+		}
+	}
+
+	if (*buf) {
+		return -EINVAL;
+	}
+
+	path->level = level;
+	return level;
+}
+
+/* A write target names a resource or a resource instance */
+static int parse_name(const char *name, struct lwm2m_obj_path *path)
+{
+	if (parse_path(name, path) < 3) {
+		LOG_ERR("Invalid resource name %s", log_strdup(name));
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int get_label(struct lwm2m_input_context *in, int64_t *label)
+{
+	uint8_t major, ai;
+	uint64_t arg;
+	char text[sizeof("vlo")];
+	int ret;
+
+	ret = get_head(in, &major, &ai, &arg);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (major == CBOR_UINT) {
+		*label = arg;
+	} else if (major == CBOR_NINT) {
+		*label = ~(int64_t)arg;
+	} else if (major == CBOR_TSTR && ai != CBOR_AI_INDEFINITE &&
+		   arg <= UINT16_MAX) {
+		*label = SENML_LABEL_OTHER;
+		if (arg == strlen("vlo")) {
+			ret = buf_read(text, arg, CPKT_BUF_READ(in->in_cpkt),
+				       &in->offset);
+			if (ret == 0 && !strncmp(text, "vlo", arg)) {
+				*label = SENML_LABEL_VLO;
+			}
+		} else {
+			ret = buf_skip(arg, CPKT_BUF_READ(in->in_cpkt),
+				       &in->offset);
+		}
+	} else {
+		return -EINVAL;
+	}
+
+	return ret;
+}
+
+/* Write the resource named by a record, a CBOR map. Labels other than
+ * the name, base name and value ones are skipped.
+ */
+static int write_record(struct lwm2m_message *msg, char *base_name,
+			bool *stop)
+{
+	struct lwm2m_engine_obj_field *obj_field = NULL;
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+	struct lwm2m_engine_res *res = NULL;
+	struct lwm2m_engine_res_inst *res_inst = NULL;
+	struct lwm2m_input_context *in = &msg->in;
+	char name[SENML_NAME_LEN];
+	char full_name[SENML_NAME_LEN];
+	uint64_t count;
+	uint16_t value_offset;
+	uint8_t major, ai;
+	bool named = false;
+	int64_t label;
+	int ret, err = 0;
+
+	ret = get_head(in, &major, &ai, &count);
+	if (ret < 0 || major != CBOR_MAP) {
+		*stop = true;
+		return -EINVAL;
+	}
+
+	while (ai == CBOR_AI_INDEFINITE ? !at_break(in) : count-- > 0U) {
+		ret = get_label(in, &label);
+		if (ret < 0) {
+			*stop = true;
+			return ret;
+		}
+
+		value_offset = in->offset;
+
+		switch (label) {
+		case SENML_LABEL_BN:
+			if (!get_string(in, base_name, SENML_NAME_LEN)) {
+				*stop = true;
+				return -EINVAL;
+			}
+
+			break;
+
+		case SENML_LABEL_N:
+			if (!get_string(in, name, sizeof(name))) {
+				*stop = true;
+				return -EINVAL;
+			}
+
+			snprintk(full_name, sizeof(full_name), "%s%s",
+				 base_name, name);
+			ret = parse_name(full_name, &msg->path);
+			if (ret == 0) {
+				ret = lwm2m_get_write_target(msg, &obj_inst,
+							     &obj_field, &res,
+							     &res_inst);
+			}
+
+			if (ret < 0) {
+				*stop = true;
+				return ret;
+			}
+
+			named = true;
+			break;
+
+		case SENML_LABEL_V:
+		case SENML_LABEL_VS:
+		case SENML_LABEL_VB:
+		case SENML_LABEL_VD:
+		case SENML_LABEL_VLO:
+			/* without a name the base name is the resource */
+			if (!named) {
+				ret = parse_name(base_name, &msg->path);
+				if (ret == 0) {
+					ret = lwm2m_get_write_target(
+						msg, &obj_inst, &obj_field,
+						&res, &res_inst);
+				}
+
+				if (ret < 0) {
+					*stop = true;
+					return ret;
+				}
+			}
+
+			ret = lwm2m_write_handler(obj_inst, res, res_inst,
+						  obj_field, msg);
+			if (ret < 0) {
+				err = ret;
+			}
+
+			/* the readers may stop short of the item end */
+			in->offset = value_offset;
+			__fallthrough;
+
+		default:
+			if (skip_item(in, 0) < 0) {
+				*stop = true;
+				return -EINVAL;
+			}
+
+			break;
+		}
+	}
+
+	if (ai == CBOR_AI_INDEFINITE) {
+		/* consume the break */
+		in->offset++;
+	}
+
+	return err;
+}
+
+int do_write_op_senml_cbor(struct lwm2m_message *msg)
+{
+	struct lwm2m_input_context *in = &msg->in;
+	char base_name[SENML_NAME_LEN] = "";
+	uint8_t level = msg->path.level;
+	uint64_t count;
+	uint8_t major, ai;
+	bool stop = false;
+	int ret;
+
+	ret = get_head(in, &major, &ai, &count);
+	if (ret < 0 || major != CBOR_ARRAY) {
+		LOG_ERR("SenML pack is not an array");
+		return -EINVAL;
+	}
+
+	while (ai == CBOR_AI_INDEFINITE ? !at_break(in) : count-- > 0U) {
+		ret = write_record(msg, base_name, &stop);
+		/* return errors on a single write */
+		if (stop || (level >= 3U && ret < 0)) {
+			return ret;
+		}
+	}
+
+	if (ai == CBOR_AI_INDEFINITE) {
+		/* consume the break */
+		in->offset++;
+	}
+
+	return ret;
+}
@@ -6,6 +6,7 @@
 
 /* libc headers */
 #include <fcntl.h>
+#include <time.h>
 
 /* Zephyr headers */
 #include <logging/log.h>
@@ -43,6 +44,10 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 const struct socket_op_vtable sock_fd_op_vtable;
 
+#if defined(CONFIG_NET_SOCKETS_POLL_SET)
+static void poll_set_forget(void *obj);
+#endif
+
 static inline void *get_sock_vtable(
 			int sock, const struct socket_op_vtable **vtable)
 {
@@ -238,6 +243,10 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+#if defined(CONFIG_NET_SOCKETS_POLL_SET)
+	poll_set_forget(&ctx->recv_q);
+#endif
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -693,6 +702,41 @@ ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 	return status;
 }
 
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_TX)
+ssize_t zsock_sendmsg_zc(int sock, const struct msghdr *msg, int flags,
+			 struct net_pkt_ext_done *done)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	int status;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		status = -EBADF;
+	} else if (vtable != &sock_fd_op_vtable) {
+		status = -EOPNOTSUPP;
+	} else {
+		if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+			timeout = K_NO_WAIT;
+		}
+
+		status = net_context_sendmsg_ext(ctx, msg, flags, done, NULL,
+						 timeout, NULL);
+	}
+
+	/* The packet holds its own references to the buffers */
+	net_pkt_ext_done_put(done);
+
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_TX */
+
 ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 {
 	VTABLE_CALL(sendmsg, sock, msg, flags);
@@ -920,17 +964,149 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 	}
 }
 
+static void *sock_put_cmsg(struct msghdr *msg, size_t *used,
+			   int level, int type, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (msg->msg_control == NULL ||
+	    *used + CMSG_SPACE(len) > msg->msg_controllen) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return NULL;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control + *used);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+
+	*used += CMSG_SPACE(len);
+
+	return CMSG_DATA(cmsg);
+}
+
+static int sock_put_pktinfo(struct net_pkt *pkt, struct msghdr *msg,
+			    size_t *used)
+{
+	struct net_pkt_cursor backup;
+	int ifindex = net_if_get_by_iface(net_pkt_iface(pkt));
+	int ret = 0;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+		const struct in_addr *local;
+		struct in_pktinfo info;
+		void *data;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (!ipv4_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		info.ipi_ifindex = ifindex;
+		net_ipaddr_copy(&info.ipi_addr, &ipv4_hdr->dst);
+
+		/* Broadcast and multicast datagrams are answered from the
+		 * address the interface would pick for the sender.
+		 */
+		if (net_ipv4_is_addr_mcast(&info.ipi_addr) ||
+		    net_ipv4_is_addr_bcast(net_pkt_iface(pkt),
+					   &info.ipi_addr)) {
+			local = net_if_ipv4_select_src_addr(net_pkt_iface(pkt),
+							    &ipv4_hdr->src);
+			net_ipaddr_copy(&info.ipi_spec_dst, local);
+		} else {
+			net_ipaddr_copy(&info.ipi_spec_dst, &info.ipi_addr);
+		}
+
+		data = sock_put_cmsg(msg, used, IPPROTO_IP, IP_PKTINFO,
+				     sizeof(info));
+		if (data) {
+			memcpy(data, &info, sizeof(info));
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+		struct in6_pktinfo info;
+		void *data;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (!ipv6_hdr) {
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		info.ipi6_ifindex = ifindex;
+		net_ipaddr_copy(&info.ipi6_addr, &ipv6_hdr->dst);
+
+		data = sock_put_cmsg(msg, used, IPPROTO_IPV6, IPV6_PKTINFO,
+				     sizeof(info));
+		if (data) {
+			memcpy(data, &info, sizeof(info));
+		}
+	}
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+static int sock_put_cmsgs(struct net_context *ctx, struct net_pkt *pkt,
+			  struct msghdr *msg)
+{
+	size_t used = 0;
+	int ret;
+
+	if (sock_get_flag(ctx, SOCK_RECV_PKTINFO)) {
+		ret = sock_put_pktinfo(pkt, msg, &used);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP) &&
+	    sock_get_flag(ctx, SOCK_RECV_TIMESTAMP)) {
+		struct net_ptp_time *stamp = net_pkt_timestamp(pkt);
+		struct timespec ts;
+		void *data;
+
+		ts.tv_sec = stamp->second;
+		ts.tv_nsec = stamp->nanosecond;
+
+		data = sock_put_cmsg(msg, &used, SOL_SOCKET, SCM_TIMESTAMPNS,
+				     sizeof(ts));
+		if (data) {
+			memcpy(data, &ts, sizeof(ts));
+		}
+	}
+
+	msg->msg_controllen = used;
+
+	return 0;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       struct msghdr *msg,
+				       int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
+	size_t data_len;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	size_t i;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -958,37 +1134,57 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
+	msg->msg_flags = 0;
+
+	if (msg->msg_name) {
+		struct sockaddr *src_addr = msg->msg_name;
 		int rv;
 
 		rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-					   src_addr, *addrlen);
+					   src_addr, msg->msg_namelen);
 		if (rv < 0) {
 			errno = -rv;
 			goto fail;
 		}
 
-		/* addrlen is a value-result argument, set to actual
+		/* msg_namelen is a value-result argument, set to actual
 		 * size of source address
 		 */
 		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
+			msg->msg_namelen = sizeof(struct sockaddr_in);
 		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
+			msg->msg_namelen = sizeof(struct sockaddr_in6);
 		} else {
 			errno = ENOTSUP;
 			goto fail;
 		}
 	}
 
-	recv_len = net_pkt_remaining_data(pkt);
-	if (recv_len > max_len) {
-		recv_len = max_len;
+	if (msg->msg_controllen > 0) {
+		int rv;
+
+		rv = sock_put_cmsgs(ctx, pkt, msg);
+		if (rv < 0) {
+			errno = -rv;
+			goto fail;
+		}
 	}
 
-	if (net_pkt_read(pkt, buf, recv_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	data_len = net_pkt_remaining_data(pkt);
+
+	for (i = 0; i < msg->msg_iovlen && recv_len < data_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, data_len - recv_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		recv_len += len;
+	}
+
+	if (recv_len < data_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1007,6 +1203,8 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 fail:
 	if (!(flags & ZSOCK_MSG_PEEK)) {
 		net_pkt_unref(pkt);
+	} else {
+		net_pkt_cursor_restore(pkt, &backup);
 	}
 
 	return -1;
@@ -1119,7 +1317,27 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = max_len,
+		};
+		struct msghdr msg = {
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+		ssize_t ret;
+
+		if (src_addr && addrlen) {
+			msg.msg_name = src_addr;
+			msg.msg_namelen = *addrlen;
+		}
+
+		ret = zsock_recv_dgram(ctx, &msg, flags);
+		if (ret >= 0 && msg.msg_name) {
+			*addrlen = msg.msg_namelen;
+		}
+
+		return ret;
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1167,6 +1385,420 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static ssize_t zsock_recvmsg_stream(struct net_context *ctx,
+				    struct msghdr *msg, int flags)
+{
+	ssize_t recv_len = 0;
+	size_t i;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		size_t iov_len = msg->msg_iov[i].iov_len;
+		ssize_t len;
+
+		if (iov_len == 0) {
+			continue;
+		}
+
+		len = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					iov_len, flags);
+		if (len < 0) {
+			if (recv_len > 0) {
+				break;
+			}
+
+			return -1;
+		}
+
+		recv_len += len;
+
+		/* Peeking again would return the same data */
+		if (len < iov_len || (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		/* Only wait for the first chunk, like recv() does */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	msg->msg_namelen = 0;
+	msg->msg_controllen = 0;
+	msg->msg_flags = 0;
+
+	return recv_len;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, flags);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recvmsg_stream(ctx, msg, flags);
+	} else {
+		__ASSERT(0, "Unknown socket type");
+	}
+
+	return 0;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	size_t iov_size;
+	ssize_t ret = -1;
+	size_t i;
+
+	Z_OOPS(z_user_from_copy(&msg_copy, msg, sizeof(msg_copy)));
+
+	if (size_mul_overflow(msg_copy.msg_iovlen, sizeof(struct iovec),
+			      &iov_size)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (msg_copy.msg_iovlen > 0) {
+		msg_copy.msg_iov = z_user_alloc_from_copy(msg_copy.msg_iov,
+							  iov_size);
+		if (!msg_copy.msg_iov) {
+			errno = ENOMEM;
+			return -1;
+		}
+	}
+
+	/* Received data goes straight to the user buffers */
+	for (i = 0; i < msg_copy.msg_iovlen; i++) {
+		if (Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_iov[i].iov_base,
+					   msg_copy.msg_iov[i].iov_len)) {
+			errno = EFAULT;
+			goto out;
+		}
+	}
+
+	if ((msg_copy.msg_name &&
+	     Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_name,
+				    msg_copy.msg_namelen)) ||
+	    (msg_copy.msg_control &&
+	     Z_SYSCALL_MEMORY_WRITE(msg_copy.msg_control,
+				    msg_copy.msg_controllen))) {
+		errno = EFAULT;
+		goto out;
+	}
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+out:
+	if (msg_copy.msg_iovlen > 0) {
+		k_free(msg_copy.msg_iov);
+	}
+
+	if (ret >= 0) {
+		Z_OOPS(z_user_to_copy(&msg->msg_namelen,
+				      &msg_copy.msg_namelen,
+				      sizeof(msg_copy.msg_namelen)));
+		Z_OOPS(z_user_to_copy(&msg->msg_controllen,
+				      &msg_copy.msg_controllen,
+				      sizeof(msg_copy.msg_controllen)));
+		Z_OOPS(z_user_to_copy(&msg->msg_flags,
+				      &msg_copy.msg_flags,
+				      sizeof(msg_copy.msg_flags)));
+	}
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+static size_t zsock_pkt_frags(struct net_pkt *pkt, struct iovec *iov,
+			      size_t iovcnt, size_t *count)
+{
+	struct net_buf *buf;
+	size_t len = 0;
+
+	*count = 0;
+
+	/* Data starts at the cursor, after the headers and anything
+	 * already read with recv()
+	 */
+	for (buf = pkt->cursor.buf; buf; buf = buf->frags) {
+		uint8_t *pos = buf == pkt->cursor.buf ?
+			pkt->cursor.pos : buf->data;
+		size_t frag_len = buf->len - (pos - buf->data);
+
+		if (frag_len == 0) {
+			continue;
+		}
+
+		if (*count < iovcnt) {
+			iov[*count].iov_base = pos;
+			iov[*count].iov_len = frag_len;
+		}
+
+		(*count)++;
+		len += frag_len;
+	}
+
+	return len;
+}
+
+ssize_t zsock_recv_zc(int sock, struct iovec *iov, size_t *iovcnt,
+		      int flags, void **handle)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	bool stream;
+	size_t count;
+	size_t len;
+
+	*handle = NULL;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (flags & ~ZSOCK_MSG_DONTWAIT) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	stream = net_context_get_type(ctx) == SOCK_STREAM;
+
+	if (stream && net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		errno = ENOTCONN;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	}
+
+	do {
+		struct net_pkt *pkt;
+		int res;
+
+		if (stream && sock_is_eof(ctx)) {
+			*iovcnt = 0;
+			return 0;
+		}
+
+		res = k_fifo_wait_non_empty(&ctx->recv_q, timeout);
+		/* EAGAIN when timeout expired, EINTR when cancelled */
+		if (res && res != -EAGAIN && res != -EINTR) {
+			errno = -res;
+			return -1;
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (!pkt) {
+			if (stream && sock_is_eof(ctx)) {
+				*iovcnt = 0;
+				return 0;
+			}
+
+			errno = EAGAIN;
+			return -1;
+		}
+
+		len = zsock_pkt_frags(pkt, iov, *iovcnt, &count);
+		if (count > *iovcnt) {
+			*iovcnt = count;
+			errno = EMSGSIZE;
+			return -1;
+		}
+
+		k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		if (!stream) {
+			*handle = pkt;
+			break;
+		}
+
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		/* Empty stream packets only carry the EOF mark */
+		if (len == 0) {
+			net_pkt_unref(pkt);
+			continue;
+		}
+
+		net_context_update_recv_wnd(ctx, len);
+		*handle = pkt;
+	} while (*handle == NULL);
+
+	*iovcnt = count;
+
+	return len;
+}
+
+void zsock_recv_zc_release(void *handle)
+{
+	if (handle) {
+		net_pkt_unref(handle);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY_RX */
+
+/* The batch calls resolve the descriptor once and then go through the
+ * per-message handlers, so their saving is the syscall and fd table
+ * overhead of each message.
+ */
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t len;
+
+		len = vtable->sendmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	/* errno is left as set by the failed message */
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	for (i = 0; i < vlen; i++) {
+		unsigned int msg_len;
+		ssize_t len;
+
+		len = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msg_len = len;
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &msg_len,
+				      sizeof(msg_len)));
+	}
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	unsigned int i;
+	void *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable);
+	if (ctx == NULL || vtable->recvmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t len;
+
+		len = vtable->recvmsg(ctx, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+
+		/* Only wait for the first message */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	for (i = 0; i < vlen; i++) {
+		unsigned int msg_len;
+		ssize_t len;
+
+		len = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msg_len = len;
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &msg_len,
+				      sizeof(msg_len)));
+
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1245,6 +1877,205 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 	return 0;
 }
 
+#if defined(CONFIG_NET_SOCKETS_POLL_SET)
+struct poll_set_cache {
+	struct k_thread *owner;
+	struct k_poll_set set;
+	uint32_t last_used;
+	bool busy;
+	int num_events;
+	struct k_poll_event events[CONFIG_NET_SOCKETS_POLL_MAX];
+};
+
+static struct poll_set_cache poll_sets[CONFIG_NET_SOCKETS_POLL_SET_THREADS];
+static uint32_t poll_set_uses;
+static K_MUTEX_DEFINE(poll_set_lock);
+
+/* Must be called with poll_set_lock held */
+static void poll_set_clear(struct poll_set_cache *cache)
+{
+	for (int i = 0; i < cache->num_events; i++) {
+		(void)k_poll_set_remove(&cache->set, &cache->events[i]);
+	}
+
+	cache->num_events = 0;
+}
+
+/* Must be called with poll_set_lock held */
+static void poll_set_release(struct poll_set_cache *cache)
+{
+	poll_set_clear(cache);
+	cache->owner = NULL;
+}
+
+static bool poll_set_matches(struct poll_set_cache *cache,
+			     struct k_poll_event *events, int num_events)
+{
+	if (cache->num_events != num_events) {
+		return false;
+	}
+
+	for (int i = 0; i < num_events; i++) {
+		if (cache->events[i].obj != events[i].obj ||
+		    cache->events[i].type != events[i].type) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Must be called with poll_set_lock held. Returns a free entry, or the
+ * least recently used one nobody is waiting on, which also covers
+ * entries left behind by threads that have exited.
+ */
+static struct poll_set_cache *poll_set_claim(void)
+{
+	struct poll_set_cache *cache = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(poll_sets); i++) {
+		if (poll_sets[i].owner == NULL) {
+			return &poll_sets[i];
+		}
+
+		if (poll_sets[i].busy) {
+			continue;
+		}
+
+		if (cache == NULL ||
+		    (int32_t)(poll_sets[i].last_used - cache->last_used) < 0) {
+			cache = &poll_sets[i];
+		}
+	}
+
+	if (cache != NULL) {
+		poll_set_release(cache);
+	}
+
+	return cache;
+}
+
+/* Get the calling thread's poll set, loaded with @a events. A thread
+ * polling other sockets than last time gives its entry up and uses
+ * plain k_poll() for this call.
+ */
+static struct poll_set_cache *poll_set_get(struct k_poll_event *events,
+					   int num_events)
+{
+	struct k_thread *thread = k_current_get();
+	struct poll_set_cache *cache = NULL;
+	int i;
+
+	k_mutex_lock(&poll_set_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(poll_sets); i++) {
+		if (poll_sets[i].owner == thread) {
+			cache = &poll_sets[i];
+			break;
+		}
+	}
+
+	if (cache != NULL) {
+		if (!poll_set_matches(cache, events, num_events)) {
+			poll_set_release(cache);
+			cache = NULL;
+		}
+	} else {
+		cache = poll_set_claim();
+		if (cache != NULL) {
+			cache->owner = thread;
+			k_poll_set_init(&cache->set);
+
+			for (i = 0; i < num_events; i++) {
+				cache->events[i] = events[i];
+				cache->events[i].poller = NULL;
+				(void)k_poll_set_add(&cache->set,
+						     &cache->events[i]);
+			}
+
+			cache->num_events = num_events;
+		}
+	}
+
+	if (cache != NULL) {
+		cache->busy = true;
+		cache->last_used = ++poll_set_uses;
+	}
+
+	k_mutex_unlock(&poll_set_lock);
+
+	return cache;
+}
+
+static void poll_set_put(struct poll_set_cache *cache)
+{
+	k_mutex_lock(&poll_set_lock, K_FOREVER);
+	cache->busy = false;
+	k_mutex_unlock(&poll_set_lock);
+}
+
+/* Drop registrations on an object that is going away */
+static void poll_set_forget(void *obj)
+{
+	k_mutex_lock(&poll_set_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(poll_sets); i++) {
+		for (int j = 0; j < poll_sets[i].num_events; j++) {
+			if (poll_sets[i].events[j].obj == obj) {
+				poll_set_clear(&poll_sets[i]);
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(&poll_set_lock);
+}
+
+/* k_poll() replacement keeping the registrations of @a events alive
+ * between calls of the same thread. On return the state of each event
+ * is set the way k_poll() would have set it.
+ */
+static int poll_set_wait(struct k_poll_event *events, int num_events,
+			 k_timeout_t timeout)
+{
+	struct k_poll_event *ready[CONFIG_NET_SOCKETS_POLL_MAX];
+	struct poll_set_cache *cache = NULL;
+	int ret;
+
+	if (num_events > 0) {
+		cache = poll_set_get(events, num_events);
+	}
+
+	if (cache == NULL) {
+		return k_poll(events, num_events, timeout);
+	}
+
+	/* Data may have been queued while another poller, or none at all,
+	 * was told about it, so look at every socket and not only at the
+	 * ones signaled since the last call.
+	 */
+	k_poll_set_refresh(&cache->set, cache->events, num_events);
+
+	ret = k_poll_set_wait(&cache->set, ready, num_events, timeout);
+	if (ret >= 0) {
+		for (int i = 0; i < num_events; i++) {
+			events[i].state = cache->events[i].state;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			if (ready[i]->state & K_POLL_STATE_CANCELLED) {
+				ret = -EINTR;
+				break;
+			}
+		}
+	}
+
+	poll_set_put(cache);
+
+	return ret < 0 ? ret : 0;
+}
+#endif /* CONFIG_NET_SOCKETS_POLL_SET */
+
 static inline int time_left(uint32_t start, uint32_t timeout)
 {
 	uint32_t elapsed = k_uptime_get_32() - start;
@@ -1267,6 +2098,7 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int poll_timeout)
 	bool offload = false;
 	const struct fd_op_vtable *offl_vtable = NULL;
 	void *offl_ctx = NULL;
+	bool cacheable = IS_ENABLED(CONFIG_NET_SOCKETS_POLL_SET);
 
 	if (poll_timeout < 0) {
 		timeout = K_FOREVER;
@@ -1294,6 +2126,14 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int poll_timeout)
 			continue;
 		}
 
+		/* Only sockets whose close path drops cached registrations
+		 * (see zsock_close_ctx()) may use the persistent poll set.
+		 */
+		if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable &&
+		    !net_socket_is_tls(ctx)) {
+			cacheable = false;
+		}
+
 		result = z_fdtable_call_ioctl(vtable, ctx,
 					      ZFD_IOCTL_POLL_PREPARE,
 					      pfd, &pev, pev_end);
@@ -1344,7 +2184,16 @@ int z_impl_zsock_poll(struct zsock_pollfd *fds, int nfds, int poll_timeout)
 	}
 
 	do {
+#if defined(CONFIG_NET_SOCKETS_POLL_SET)
+		if (cacheable) {
+			ret = poll_set_wait(poll_events, pev - poll_events,
+					    timeout);
+		} else {
+			ret = k_poll(poll_events, pev - poll_events, timeout);
+		}
+#else
 		ret = k_poll(poll_events, pev - poll_events, timeout);
+#endif
 		/* EAGAIN when timeout expired, EINTR when cancelled (i.e. EOF) */
 		if (ret != 0 && ret != -EAGAIN && ret != -EINTR) {
 			errno = -ret;
@@ -1549,6 +2398,19 @@ int z_vrfy_zsock_getsockopt(int sock, int level, int optname,
 #include <syscalls/zsock_getsockopt_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int sock_set_recv_flag(struct net_context *ctx, uintptr_t flag,
+			      const void *optval, socklen_t optlen)
+{
+	if (optval == NULL || optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sock_set_flag(ctx, flag, *(const int *)optval ? flag : 0);
+
+	return 0;
+}
+
 int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 const void *optval, socklen_t optlen)
 {
@@ -1609,6 +2471,16 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_TIMESTAMPNS:
+			/* Report RX timestamps through recvmsg() */
+			if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP)) {
+				return sock_set_recv_flag(ctx,
+							  SOCK_RECV_TIMESTAMP,
+							  optval, optlen);
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
@@ -1639,6 +2511,14 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 		}
 		break;
 
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			return sock_set_recv_flag(ctx, SOCK_RECV_PKTINFO,
+						  optval, optlen);
+		}
+		break;
+
 	case IPPROTO_IPV6:
 		switch (optname) {
 		case IPV6_V6ONLY:
@@ -1646,6 +2526,10 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case IPV6_RECVPKTINFO:
+			return sock_set_recv_flag(ctx, SOCK_RECV_PKTINFO,
+						  optval, optlen);
 		}
 		break;
 	}
@@ -1866,6 +2750,11 @@ static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -1910,6 +2799,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.accept = sock_accept_vmeth,
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
@@ -11,6 +11,8 @@
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
+#define SOCK_RECV_PKTINFO 4
+#define SOCK_RECV_TIMESTAMP 8
 
 static inline void sock_set_flag(struct net_context *ctx, uintptr_t mask,
 				 uintptr_t flag)
@@ -60,6 +62,7 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 };
@@ -20,6 +20,8 @@ void queue_test(void)
 {
 	uint32_t et; /* elapsed time */
 	int i;
+	uint32_t n;
+	void *slot;
 
 	PRINT_STRING(dashline, output_file);
 	et = BENCH_START();
@@ -61,6 +63,52 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH) {
+		k_msgq_put_batch(&DEMOQX4, data_bench,
+				 MIN(FIFO_BATCH, NR_OF_FIFO_RUNS - i),
+				 K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO, batches of 32",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH) {
+		k_msgq_get_batch(&DEMOQX4, data_bench, FIFO_BATCH, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO, batches of 32",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_put_claim(&DEMOQX4, &slot,
+				     MIN(FIFO_BATCH, NR_OF_FIFO_RUNS - i));
+		(void)memcpy(slot, data_bench, n * 4);
+		k_msgq_put_commit(&DEMOQX4, n);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue 4 bytes msg in FIFO, zero-copy",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_get_claim(&DEMOQX4, &slot, FIFO_BATCH);
+		k_msgq_get_commit(&DEMOQX4, n);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO, zero-copy",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
@@ -84,6 +132,19 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT,
 			"enqueue 4 bytes in FIFO to a waiting higher priority task",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH) {
+		k_msgq_put_batch(&DEMOQX4, data_bench,
+				 MIN(FIFO_BATCH, NR_OF_FIFO_RUNS - i),
+				 K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT,
+			"enqueue 4 bytes batch to a waiting higher priority task",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 }
 
 #endif /* FIFO_BENCH */
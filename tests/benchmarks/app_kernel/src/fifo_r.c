@@ -20,7 +20,7 @@
  */
 void dequtask(void)
 {
-	int x, i;
+	int x, i, n;
 
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
 		k_msgq_get(&DEMOQX1, &x, K_FOREVER);
@@ -29,6 +29,11 @@ void dequtask(void)
 	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
 		k_msgq_get(&DEMOQX4, &x, K_FOREVER);
 	}
+
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += n) {
+		n = k_msgq_get_batch(&DEMOQX4, data_recv, FIFO_BATCH,
+				     K_FOREVER);
+	}
 }
 
 
@@ -37,6 +37,7 @@
 		   CONFIG_SYS_CLOCK_TICKS_PER_SEC / 10 : 1)
 #define NR_OF_NOP_RUNS 10000
 #define NR_OF_FIFO_RUNS 500
+#define FIFO_BATCH 32
 #define NR_OF_SEMA_RUNS 500
 #define NR_OF_MUTEX_RUNS 1000
 #define NR_OF_POOL_RUNS 1000
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure ISR to thread handoff through a FIFO
+ *
+ * This file contains the tests that measure the time an ISR spends in
+ * k_fifo_put() when no thread is waiting, and the time from an ISR
+ * putting an item to a waiting thread getting it.  With
+ * CONFIG_QUEUE_MPSC both are measured for a regular FIFO and for one
+ * in lock-free producer mode.
+ */
+
+#include <zephyr.h>
+#include <timing/timing.h>
+#include <irq_offload.h>
+#include "utils.h"
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_data;
+
+static K_SEM_DEFINE(waiter_done, 0, 1);
+
+static struct k_fifo handoff_fifo;
+static void *handoff_item[2];
+
+static timing_t timestamp_start;
+static timing_t timestamp_put;
+static timing_t timestamp_end;
+
+static void fifo_put_isr(const void *unused)
+{
+	ARG_UNUSED(unused);
+
+	timestamp_start = timing_counter_get();
+	k_fifo_put(&handoff_fifo, handoff_item);
+	timestamp_put = timing_counter_get();
+}
+
+static void fifo_waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	(void)k_fifo_get(&handoff_fifo, K_FOREVER);
+	timestamp_end = timing_counter_get();
+	k_sem_give(&waiter_done);
+}
+
+static void fifo_handoff(const char *mode)
+{
+	char label[64];
+	uint32_t diff;
+
+	/* Nobody waiting: the cost of the put alone */
+	irq_offload(fifo_put_isr, NULL);
+	diff = timing_cycles_get(&timestamp_start, &timestamp_put);
+	snprintk(label, sizeof(label), "ISR k_fifo_put() with no waiter (%s)",
+		 mode);
+	PRINT_STATS(label, diff);
+	(void)k_fifo_get(&handoff_fifo, K_NO_WAIT);
+
+	/* A higher priority thread pends first and runs on ISR exit */
+	k_thread_create(&waiter_data, waiter_stack, STACK_SIZE,
+			fifo_waiter, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(3), 0, K_NO_WAIT);
+
+	irq_offload(fifo_put_isr, NULL);
+	k_sem_take(&waiter_done, K_FOREVER);
+	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
+	snprintk(label, sizeof(label), "ISR k_fifo_put() to waiting thread (%s)",
+		 mode);
+	PRINT_STATS(label, diff);
+}
+
+/**
+ *
+ * @brief The test main function
+ *
+ * @return 0 on success
+ */
+int fifo_isr_to_thread(void)
+{
+	timing_start();
+	TICK_SYNCH();
+
+	k_fifo_init(&handoff_fifo);
+	fifo_handoff("locked");
+
+#ifdef CONFIG_QUEUE_MPSC
+	k_fifo_init_mpsc(&handoff_fifo);
+	fifo_handoff("lock-free");
+#endif
+
+	timing_stop();
+	return 0;
+}
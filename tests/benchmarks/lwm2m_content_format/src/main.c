@@ -0,0 +1,88 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/coap.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_rw_oma_tlv.h"
+#include "lwm2m_rw_json.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+/* Encoding cost of the device object instance in every content format.
+ * The object is registered by the engine at boot, nothing is sent.
+ */
+
+#define READS 100
+
+struct content_format {
+	const char *name;
+	uint16_t format;
+	const struct lwm2m_writer *writer;
+	int (*read_op)(struct lwm2m_message *msg, int content_format);
+};
+
+static const struct content_format formats[] = {
+	{ "tlv", LWM2M_FORMAT_OMA_TLV, &oma_tlv_writer, do_read_op_tlv },
+	{ "json", LWM2M_FORMAT_OMA_JSON, &json_writer, do_read_op_json },
+	{ "senml-json", LWM2M_FORMAT_APP_SENML_JSON, &json_writer,
+	  do_read_op_senml_json },
+	{ "senml-cbor", LWM2M_FORMAT_APP_SENML_CBOR, &senml_cbor_writer,
+	  do_read_op_senml_cbor },
+};
+
+static struct lwm2m_message msg;
+static uint8_t msg_data[1024];
+
+/* Returns the payload length of a read of /3/0 */
+static int read_device_object(const struct content_format *fmt)
+{
+	int ret;
+
+	(void)memset(&msg, 0, sizeof(msg));
+
+	ret = coap_packet_init(&msg.cpkt, msg_data, sizeof(msg_data), 1,
+			       COAP_TYPE_ACK, 0, NULL,
+			       COAP_RESPONSE_CODE_CONTENT, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.out.writer = fmt->writer;
+	msg.path.obj_id = 3U;
+	msg.path.obj_inst_id = 0U;
+	msg.path.level = 2U;
+
+	ret = fmt->read_op(&msg, fmt->format);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* the payload marker is not part of opt_len */
+	return msg.cpkt.offset - msg.cpkt.hdr_len - msg.cpkt.opt_len - 1;
+}
+
+void main(void)
+{
+	uint32_t start, cycles;
+	int i, j, len;
+
+	for (i = 0; i < ARRAY_SIZE(formats); i++) {
+		len = 0;
+
+		start = k_cycle_get_32();
+		for (j = 0; j < READS && len >= 0; j++) {
+			len = read_device_object(&formats[i]);
+		}
+		cycles = (k_cycle_get_32() - start) / READS;
+
+		printk("format %-10s bytes %4d cycles %8u%s\n",
+		       formats[i].name, len, cycles, len < 0 ? " ERROR" : "");
+	}
+
+	printk("fin\n");
+}
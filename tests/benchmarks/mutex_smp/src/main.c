@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* SMP mutex contention benchmark.  Critical sections are kept to a
+ * few microseconds of busy-waiting, which is the case adaptive
+ * spinning targets: the owner keeps running on its CPU and releases
+ * the mutex sooner than a waiter could pend and be switched back in.
+ */
+
+#define N_THREADS CONFIG_MP_NUM_CPUS
+#define WINDOW_MS 1000
+#define HANDOFF_ROUNDS 1000
+#define HOLD_US 2
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+static K_MUTEX_DEFINE(mutex);
+static struct k_thread threads[N_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_THREADS, STACK_SIZE);
+
+static struct k_sem owner_go;
+static struct k_sem owner_locked;
+static struct k_sem waiter_done;
+static volatile uint32_t unlock_stamp;
+static uint64_t handoff_total;
+
+static uint32_t counts[N_THREADS];
+static volatile bool stop;
+
+static void owner_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < HANDOFF_ROUNDS; i++) {
+		k_sem_take(&owner_go, K_FOREVER);
+		k_mutex_lock(&mutex, K_FOREVER);
+		k_sem_give(&owner_locked);
+
+		/* Give the waiter time to reach k_mutex_lock() */
+		k_busy_wait(HOLD_US * 10);
+
+		unlock_stamp = k_cycle_get_32();
+		k_mutex_unlock(&mutex);
+	}
+}
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < HANDOFF_ROUNDS; i++) {
+		k_sem_give(&owner_go);
+		k_sem_take(&owner_locked, K_FOREVER);
+
+		k_mutex_lock(&mutex, K_FOREVER);
+		handoff_total += k_cycle_get_32() - unlock_stamp;
+		k_mutex_unlock(&mutex);
+	}
+
+	k_sem_give(&waiter_done);
+}
+
+static uint32_t run_handoff(void)
+{
+	k_sem_init(&owner_go, 0, 1);
+	k_sem_init(&owner_locked, 0, 1);
+	k_sem_init(&waiter_done, 0, 1);
+	handoff_total = 0U;
+
+	k_thread_create(&threads[0], stacks[0], STACK_SIZE,
+			owner_fn, NULL, NULL, NULL,
+			WORKER_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&threads[1], stacks[1], STACK_SIZE,
+			waiter_fn, NULL, NULL, NULL,
+			WORKER_PRIO, 0, K_NO_WAIT);
+
+	k_sem_take(&waiter_done, K_FOREVER);
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+
+	return (uint32_t)(handoff_total / HANDOFF_ROUNDS);
+}
+
+static void locker_fn(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		k_mutex_lock(&mutex, K_FOREVER);
+		k_busy_wait(HOLD_US);
+		(*count)++;
+		k_mutex_unlock(&mutex);
+	}
+}
+
+static uint32_t run_lockers(int n)
+{
+	uint32_t total = 0U;
+
+	stop = false;
+	for (int i = 0; i < n; i++) {
+		counts[i] = 0U;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				locker_fn, &counts[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(WINDOW_MS));
+
+	/* Let the lockers exit on their own: aborting one that holds
+	 * the mutex would leave it locked for the next round.
+	 */
+	stop = true;
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < n; i++) {
+		total += counts[i];
+	}
+
+	return total;
+}
+
+void main(void)
+{
+	/* The main thread must outrank the workers so it can stop
+	 * them promptly at the end of each window.
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	printk("handoff %8u cycles\n", run_handoff());
+
+	for (int n = 2; n <= N_THREADS; n++) {
+		uint32_t locks = run_lockers(n);
+
+		printk("threads %d locks %8u per-sec %8u\n", n, locks,
+		       (uint32_t)((uint64_t)locks * MSEC_PER_SEC / WINDOW_MS));
+	}
+	printk("fin\n");
+}
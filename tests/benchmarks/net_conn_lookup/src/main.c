@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+
+#include "connection.h"
+
+/* Cost of net_conn_input() for a unicast UDP packet, with the matching
+ * handler at the far end of the registration list.
+ */
+
+#define ROUNDS 10000
+#define LOCAL_PORT 4242
+#define LISTEN_PORT 5353
+#define REMOTE_PORT_BASE 10000
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static uint32_t hits;
+
+static enum net_verdict conn_cb(struct net_conn *conn,
+				struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	hits++;
+
+	/* Keep the packet, it is passed in again */
+	return NET_OK;
+}
+
+static int register_conns(int count)
+{
+	struct sockaddr_in remote = {
+		.sin_family = AF_INET,
+		.sin_addr = peer_addr,
+	};
+	int ret;
+
+	/* A wildcard listener, as a server socket would have */
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL, NULL, 0,
+				LISTEN_PORT, conn_cb, NULL, &handles[0]);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (int i = 1; i <= count; i++) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET,
+					(struct sockaddr *)&remote, NULL,
+					REMOTE_PORT_BASE + i - 1, LOCAL_PORT,
+					conn_cb, NULL, &handles[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void unregister_conns(int count)
+{
+	for (int i = 0; i <= count; i++) {
+		net_conn_unregister(handles[i]);
+	}
+}
+
+static void measure(struct net_pkt *pkt, int count)
+{
+	struct net_ipv4_hdr ipv4 = { 0 };
+	struct net_udp_hdr udp = {
+		.src_port = htons(REMOTE_PORT_BASE),
+		.dst_port = htons(LOCAL_PORT),
+	};
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4 };
+	union net_proto_header proto_hdr = { .udp = &udp };
+	uint32_t start, cycles;
+
+	net_ipaddr_copy(&ipv4.src, &peer_addr);
+	net_ipaddr_copy(&ipv4.dst, &my_addr);
+
+	if (register_conns(count) < 0) {
+		printk("registering %d connections failed\n", count);
+		return;
+	}
+
+	hits = 0U;
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	unregister_conns(count);
+
+	if (hits != ROUNDS) {
+		printk("only %u of %u lookups matched\n", hits, ROUNDS);
+		return;
+	}
+
+	printk("conns %d cycles %u\n", count, cycles / ROUNDS);
+}
+
+void main(void)
+{
+	static const int counts[] = { 1, 16, 128 };
+	struct net_if *iface = net_if_get_default();
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_on_iface(iface, K_NO_WAIT);
+	if (!pkt) {
+		printk("cannot allocate packet\n");
+		return;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		measure(pkt, counts[i]);
+	}
+
+	net_pkt_unref(pkt);
+
+	printk("fin\n");
+}
@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_if.h>
+#include <net/net_ip.h>
+
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+/* Route lookup cost with a growing routing table. Route i goes to
+ * 2001:db8:<i * 0x9e37>:<i>::/48, /56 or /64, so that no route covers
+ * another one.
+ */
+
+#define NBR_COUNT 16
+#define LOOKUPS 10000
+
+static const int route_counts[] = { 16, 256, CONFIG_NET_MAX_ROUTES };
+
+static struct in6_addr nexthops[NBR_COUNT];
+static struct in6_addr dsts[CONFIG_NET_MAX_ROUTES];
+static struct net_route_entry *routes[CONFIG_NET_MAX_ROUTES];
+static uint8_t lladdrs[NBR_COUNT][6];
+
+static int add_neighbors(struct net_if *iface)
+{
+	int i;
+
+	for (i = 0; i < NBR_COUNT; i++) {
+		struct net_linkaddr lladdr = {
+			.addr = lladdrs[i],
+			.len = sizeof(lladdrs[i]),
+		};
+
+		/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+		lladdrs[i][2] = 0x5e;
+		lladdrs[i][4] = 0x53;
+		lladdrs[i][5] = i;
+
+		net_ipv6_addr_create(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0,
+				     i + 1);
+
+		if (!net_ipv6_nbr_add(iface, &nexthops[i], &lladdr, false,
+				      NET_IPV6_NBR_STATE_STATIC)) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static int add_routes(struct net_if *iface, int from, int to)
+{
+	int i;
+
+	for (i = from; i < to; i++) {
+		uint16_t spread = i * 0x9e37;
+
+		net_ipv6_addr_create(&dsts[i], 0x2001, 0x0db8, spread, i,
+				     0, 0, 0, 1);
+
+		routes[i] = net_route_add(iface, &dsts[i], 48 + 8 * (i % 3),
+					  &nexthops[i % NBR_COUNT]);
+		if (!routes[i]) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	uint32_t start, cycles, nbr_cycles;
+	bool mismatch;
+	int i, j, added = 0;
+
+	if (add_neighbors(iface)) {
+		printk("cannot add neighbors\n");
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(route_counts); i++) {
+		int count = route_counts[i];
+
+		if (add_routes(iface, added, count)) {
+			printk("cannot add %d routes\n", count);
+			return;
+		}
+
+		added = count;
+		mismatch = false;
+
+		start = k_cycle_get_32();
+		for (j = 0; j < LOOKUPS; j++) {
+			int k = j % count;
+
+			if (net_route_lookup(iface, &dsts[k]) != routes[k]) {
+				mismatch = true;
+			}
+		}
+		cycles = (k_cycle_get_32() - start) / LOOKUPS;
+
+		/* net_route_get_info() checks the neighbor cache first */
+		start = k_cycle_get_32();
+		for (j = 0; j < LOOKUPS; j++) {
+			if (net_ipv6_nbr_lookup(iface, &dsts[j % count])) {
+				mismatch = true;
+			}
+		}
+		nbr_cycles = (k_cycle_get_32() - start) / LOOKUPS;
+
+		printk("routes %4d lookup cycles %6u nbr miss cycles %6u%s\n",
+		       count, cycles, nbr_cycles, mismatch ? " MISMATCH" : "");
+	}
+
+	printk("fin\n");
+}
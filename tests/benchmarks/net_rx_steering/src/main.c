@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* Received UDP packet rate.  The main thread injects PKT_COUNT packets
+ * spread over FLOW_COUNT flows on the loopback interface, and a reader
+ * thread per flow drains the socket the flow goes to.
+ */
+
+#define FLOW_COUNT 4
+#define PKT_COUNT 8192
+#define PAYLOAD_SIZE 512
+#define SERVER_PORT 4000
+#define CLIENT_PORT 5000
+#define PEER_ADDR "192.0.2.2"
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define READER_PRIO K_PRIO_PREEMPT(4)
+
+static struct k_thread reader_threads[FLOW_COUNT];
+static K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, FLOW_COUNT, STACK_SIZE);
+
+static K_SEM_DEFINE(readers_ready, 0, FLOW_COUNT);
+static K_SEM_DEFINE(all_read, 0, 1);
+
+static uint8_t payload[PAYLOAD_SIZE];
+static atomic_t received;
+
+static void reader_fn(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT + POINTER_TO_INT(p1)),
+	};
+	uint8_t buf[PAYLOAD_SIZE];
+	int sock;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("reader setup failed (%d)\n", errno);
+		return;
+	}
+
+	k_sem_give(&readers_ready);
+
+	while (recv(sock, buf, sizeof(buf), 0) >= 0) {
+		if (atomic_inc(&received) + 1 == PKT_COUNT) {
+			k_sem_give(&all_read);
+		}
+	}
+}
+
+static int inject(struct net_if *iface, struct in_addr *src,
+		  struct in_addr *dst, int flow)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, PAYLOAD_SIZE, AF_INET,
+					   IPPROTO_UDP, K_FOREVER);
+	if (!pkt) {
+		return -ENOMEM;
+	}
+
+	if (net_ipv4_create(pkt, src, dst) ||
+	    net_udp_create(pkt, htons(CLIENT_PORT + flow),
+			   htons(SERVER_PORT + flow)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+	net_pkt_cursor_init(pkt);
+
+	if (net_recv_data(iface, pkt) < 0) {
+		net_pkt_unref(pkt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	struct in_addr src, dst;
+	uint32_t start, ms;
+	int i, ret;
+
+	inet_pton(AF_INET, PEER_ADDR, &src);
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &dst);
+
+	for (i = 0; i < FLOW_COUNT; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i],
+				STACK_SIZE, reader_fn, INT_TO_POINTER(i),
+				NULL, NULL, READER_PRIO, 0, K_NO_WAIT);
+		k_sem_take(&readers_ready, K_FOREVER);
+	}
+
+	start = k_uptime_get_32();
+
+	for (i = 0; i < PKT_COUNT; i++) {
+		ret = inject(iface, &src, &dst, i % FLOW_COUNT);
+		if (ret < 0) {
+			printk("inject failed (%d)\n", ret);
+			return;
+		}
+	}
+
+	if (k_sem_take(&all_read, K_SECONDS(30))) {
+		printk("only %d packets read\n", (int)atomic_get(&received));
+	}
+
+	ms = MAX(1U, k_uptime_get_32() - start);
+
+	printk("flows %d packets %d ms %u pkts/s %u\n", FLOW_COUNT,
+	       (int)atomic_get(&received), ms,
+	       (uint32_t)(atomic_get(&received) * 1000U / ms));
+	printk("fin\n");
+}
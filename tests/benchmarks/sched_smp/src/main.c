@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* SMP scheduler contention benchmark.  A "lane" is a pair of threads
+ * handing control back and forth through two semaphores, so each
+ * handoff goes through z_ready_thread() on one side and a pend plus
+ * z_get_next_switch_handle() on the other.  Running 1..N lanes at
+ * once on N CPUs shows how far context switch throughput scales
+ * before the shared scheduler state becomes the bottleneck.
+ */
+
+#define N_LANES CONFIG_MP_NUM_CPUS
+#define WINDOW_MS 1000
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct lane {
+	struct k_sem ping;
+	struct k_sem pong;
+	uint32_t count;
+};
+
+static struct lane lanes[N_LANES];
+static struct k_thread threads[N_LANES][2];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_LANES * 2, STACK_SIZE);
+
+static void ping_fn(void *p1, void *p2, void *p3)
+{
+	struct lane *lane = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_give(&lane->pong);
+		k_sem_take(&lane->ping, K_FOREVER);
+		lane->count++;
+	}
+}
+
+static void pong_fn(void *p1, void *p2, void *p3)
+{
+	struct lane *lane = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&lane->pong, K_FOREVER);
+		k_sem_give(&lane->ping);
+	}
+}
+
+static uint32_t run_lanes(int n)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < n; i++) {
+		k_sem_init(&lanes[i].ping, 0, 1);
+		k_sem_init(&lanes[i].pong, 0, 1);
+		lanes[i].count = 0U;
+
+		k_thread_create(&threads[i][0], stacks[2 * i], STACK_SIZE,
+				ping_fn, &lanes[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&threads[i][1], stacks[2 * i + 1], STACK_SIZE,
+				pong_fn, &lanes[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(WINDOW_MS));
+
+	for (int i = 0; i < n; i++) {
+		total += lanes[i].count;
+	}
+
+	for (int i = 0; i < n; i++) {
+		k_thread_abort(&threads[i][0]);
+		k_thread_abort(&threads[i][1]);
+	}
+
+	return total;
+}
+
+void main(void)
+{
+	/* The main thread must outrank the workers so it can stop
+	 * them promptly at the end of each window.
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	for (int n = 1; n <= N_LANES; n++) {
+		uint32_t switches = run_lanes(n);
+
+		printk("lanes %d switches %8u per-sec %8u\n", n, switches,
+		       (uint32_t)((uint64_t)switches * MSEC_PER_SEC / WINDOW_MS));
+	}
+	printk("fin\n");
+}
@@ -20,6 +20,89 @@ static K_MEM_SLAB_DEFINE(my_slab,
 /* Array contains pointers to allocated regions. */
 static void *slab_array[MEM_SLAB_BLOCK_CNT];
 
+/* Blocks each thread of the throughput test keeps allocated at once */
+#define MEM_SLAB_BURST       (8)
+
+static K_THREAD_STACK_ARRAY_DEFINE(slab_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread slab_threads[CONFIG_MP_NUM_CPUS];
+static K_SEM_DEFINE(slab_done, 0, CONFIG_MP_NUM_CPUS);
+
+/**
+ *
+ * @brief Memslab throughput thread.
+ *		  Allocates and frees bursts of blocks so that, with
+ *		  several of these running on different CPUs, the slab
+ *		  sees concurrent allocations and frees.
+ *
+ * @param p1 Amount of loops to run.
+ *
+ * @return N/A
+ */
+static void mem_slab_thread(void *p1, void *p2, void *p3)
+{
+	int no_of_loops = POINTER_TO_INT(p1);
+	void *blocks[MEM_SLAB_BURST];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < no_of_loops; i += MEM_SLAB_BURST) {
+		for (int j = 0; j < MEM_SLAB_BURST; j++) {
+			(void)k_mem_slab_alloc(&my_slab, &blocks[j], K_FOREVER);
+		}
+		for (int j = 0; j < MEM_SLAB_BURST; j++) {
+			k_mem_slab_free(&my_slab, &blocks[j]);
+		}
+	}
+
+	k_sem_give(&slab_done);
+}
+
+/**
+ *
+ * @brief Memslab throughput test function.
+ *		  Runs @a no_of_threads threads doing alloc/free bursts
+ *		  at once and reports the average time of one alloc/free
+ *		  pair across all of them.
+ *
+ * @param no_of_threads Number of concurrent threads.
+ *
+ * @return 1 if success and 0 on failure
+ */
+static int mem_slab_threads_test(int no_of_threads)
+{
+	int i = number_of_loops;
+	uint32_t t;
+
+	fprintf(output_file, sz_test_case_fmt, "Memslab #3");
+	fprintf(output_file, sz_description,
+		"\n\tk_mem_slab_alloc(K_FOREVER)"
+		"\n\tk_mem_slab_free");
+	fprintf(output_file, "\n\tfrom %d concurrent thread(s)",
+		no_of_threads);
+	printf(sz_test_start_fmt);
+
+	t = BENCH_START();
+	for (int n = 0; n < no_of_threads; n++) {
+		k_thread_create(&slab_threads[n], slab_stacks[n], STACK_SIZE,
+				mem_slab_thread,
+				INT_TO_POINTER(number_of_loops), NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+	for (int n = 0; n < no_of_threads; n++) {
+		k_sem_take(&slab_done, K_FOREVER);
+	}
+	t = TIME_STAMP_DELTA_GET(t);
+
+	if (k_mem_slab_num_used_get(&my_slab) != 0) {
+		i = 0;
+	}
+
+	/* Each thread did number_of_loops pairs in the same wall time */
+	return check_result(i, t / no_of_threads);
+}
+
 /**
  *
  * @brief Memslab allocation test function.
@@ -103,5 +186,11 @@ int mem_slab_test(void)
 
 	return_value += check_result(i, t);
 
+	/* Test alloc/free throughput with 1 thread, then one per CPU */
+	return_value += mem_slab_threads_test(1);
+	if (CONFIG_MP_NUM_CPUS > 1) {
+		return_value += mem_slab_threads_test(CONFIG_MP_NUM_CPUS);
+	}
+
 	return return_value;
 }
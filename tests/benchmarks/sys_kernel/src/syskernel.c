@@ -168,8 +168,10 @@ void main(void)
 		test_result += mem_slab_test();
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
-			if (test_result == 14) {
+			/* sema/lifo/fifo/stack/mem_slab account for 15 tests
+			 * in total, plus one more for the multi-CPU memslab test
+			 */
+			if (test_result == 15 + (CONFIG_MP_NUM_CPUS > 1)) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
@@ -0,0 +1,175 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* Bulk TCP throughput over the loopback interface.  The main thread
+ * writes TOTAL_BYTES to a server thread on the same device, which
+ * reads until the connection is closed.  The cycles the server spends
+ * receiving are reported per MiB, along with the bytes it copied out of
+ * the network buffers: with CONFIG_NET_SOCKETS_ZEROCOPY_RX the data is
+ * checksummed in place instead.
+ */
+
+#define SERVER_PORT 4242
+#define TOTAL_BYTES (2 * 1024 * 1024)
+#define CHUNK_SIZE 1024
+#define STACK_SIZE (2048 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define SERVER_PRIO K_PRIO_PREEMPT(8)
+#define ZC_IOV_MAX 8
+
+static struct k_thread server_thread;
+static K_THREAD_STACK_DEFINE(server_stack, STACK_SIZE);
+
+static K_SEM_DEFINE(server_ready, 0, 1);
+static K_SEM_DEFINE(server_done, 0, 1);
+
+static uint8_t tx_buf[CHUNK_SIZE];
+static uint32_t received;
+static uint32_t copied;
+static uint64_t rx_cycles;
+static uint32_t rx_sum;
+
+static void consume(const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		rx_sum += data[i];
+	}
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_RX)
+static ssize_t server_recv(int client)
+{
+	struct iovec iov[ZC_IOV_MAX];
+	size_t iovcnt = ARRAY_SIZE(iov);
+	uint32_t start = k_cycle_get_32();
+	void *handle;
+	ssize_t len;
+
+	len = zsock_recv_zc(client, iov, &iovcnt, 0, &handle);
+	if (len > 0) {
+		for (size_t i = 0; i < iovcnt; i++) {
+			consume(iov[i].iov_base, iov[i].iov_len);
+		}
+	}
+
+	zsock_recv_zc_release(handle);
+	rx_cycles += k_cycle_get_32() - start;
+
+	return len;
+}
+#else
+static uint8_t rx_buf[CHUNK_SIZE];
+
+static ssize_t server_recv(int client)
+{
+	uint32_t start = k_cycle_get_32();
+	ssize_t len;
+
+	len = recv(client, rx_buf, sizeof(rx_buf), 0);
+	if (len > 0) {
+		copied += len;
+		consume(rx_buf, len);
+	}
+
+	rx_cycles += k_cycle_get_32() - start;
+
+	return len;
+}
+#endif
+
+static void server_fn(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int sock, client;
+	ssize_t len;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(sock, 1) < 0) {
+		printk("server setup failed (%d)\n", errno);
+		return;
+	}
+
+	k_sem_give(&server_ready);
+
+	client = accept(sock, NULL, NULL);
+	if (client < 0) {
+		printk("accept failed (%d)\n", errno);
+		close(sock);
+		return;
+	}
+
+	while ((len = server_recv(client)) > 0) {
+		received += len;
+	}
+
+	close(client);
+	close(sock);
+
+	k_sem_give(&server_done);
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint32_t sent = 0U, start, elapsed;
+	int sock;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = i;
+	}
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	k_thread_create(&server_thread, server_stack, STACK_SIZE, server_fn,
+			NULL, NULL, NULL, SERVER_PRIO, 0, K_NO_WAIT);
+	k_sem_take(&server_ready, K_FOREVER);
+
+	sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0 ||
+	    connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed (%d)\n", errno);
+		return;
+	}
+
+	start = k_uptime_get_32();
+
+	while (sent < TOTAL_BYTES) {
+		ssize_t len = send(sock, tx_buf,
+				   MIN(sizeof(tx_buf), TOTAL_BYTES - sent), 0);
+
+		if (len < 0) {
+			printk("send failed (%d)\n", errno);
+			break;
+		}
+
+		sent += len;
+	}
+
+	close(sock);
+
+	k_sem_take(&server_done, K_FOREVER);
+	elapsed = MAX(1U, k_uptime_get_32() - start);
+
+	printk("bytes %u ms %u KiB/s %u\n", received, elapsed,
+	       (uint32_t)((uint64_t)received * MSEC_PER_SEC /
+			  (elapsed * 1024U)));
+	printk("copied %u rx cycles/MiB %u\n", copied,
+	       (uint32_t)(rx_cycles * 1024U * 1024U / MAX(1U, received)));
+	printk("fin\n");
+}
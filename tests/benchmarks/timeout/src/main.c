@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+#include <drivers/timer/system_timer.h>
+
+/* Timeout queue microbenchmark: average cycle cost of adding,
+ * aborting and expiring kernel timeouts with different numbers of
+ * timeouts pending at once.  See README.rst for details.
+ */
+
+#define N_MAX 10000
+
+/* Every benchmark timeout expires between BASE and BASE + RANGE ticks
+ * from now, far enough out that the system timer never gets to them.
+ */
+#define BASE 1000000
+#define RANGE 100000
+
+static const int sizes[] = { 10, 100, N_MAX };
+
+static struct _timeout timeouts[N_MAX];
+static uint16_t order[N_MAX];
+static int n_expired;
+
+static uint32_t rand_state;
+
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void expiry_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	n_expired++;
+}
+
+static void add_all(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_add_timeout(&timeouts[i], expiry_fn,
+			      Z_TIMEOUT_TICKS(BASE + next_rand() % RANGE));
+	}
+}
+
+static void run(int n)
+{
+	uint32_t t0, insert, abort, expire;
+	unsigned int key;
+
+	rand_state = 1U;
+
+	for (int i = 0; i < n; i++) {
+		z_init_timeout(&timeouts[i]);
+		order[i] = i;
+	}
+
+	/* Fisher-Yates shuffle of the abort order */
+	for (int i = n - 1; i > 0; i--) {
+		int j = next_rand() % (i + 1);
+		uint16_t tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	t0 = k_cycle_get_32();
+	add_all(n);
+	insert = k_cycle_get_32() - t0;
+
+	t0 = k_cycle_get_32();
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&timeouts[order[i]]);
+	}
+	abort = k_cycle_get_32() - t0;
+
+	add_all(n);
+	n_expired = 0;
+
+	/* Announce from thread context with interrupts locked so the
+	 * real timer ISR can't interleave with the measurement.
+	 */
+	key = irq_lock();
+	t0 = k_cycle_get_32();
+	z_clock_announce(BASE + RANGE);
+	expire = k_cycle_get_32() - t0;
+	irq_unlock(key);
+
+	if (n_expired != n) {
+		printk("ERROR: %d of %d timeouts expired\n", n_expired, n);
+	}
+
+	printk("timeouts %5d insert %6u abort %6u expire %6u\n", n,
+	       insert / n, abort / n, expire / n);
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		run(sizes[i]);
+	}
+	printk("fin\n");
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_pkt.h>
+
+/* UDP send cost over the loopback interface.  The main thread sends
+ * DGRAM_COUNT datagrams to a receiver thread on the same device, which
+ * runs at a higher priority so that it drains the socket as it goes.
+ */
+
+#define SERVER_PORT 4242
+#define DGRAM_SIZE 480
+#define DGRAM_COUNT 4096
+#define BUF_COUNT 4
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define RECEIVER_PRIO K_PRIO_PREEMPT(4)
+
+static struct k_thread receiver_thread;
+static K_THREAD_STACK_DEFINE(receiver_stack, STACK_SIZE);
+
+static K_SEM_DEFINE(receiver_ready, 0, 1);
+
+static uint8_t tx_buf[BUF_COUNT][DGRAM_SIZE];
+static uint8_t rx_buf[DGRAM_SIZE];
+static uint32_t received;
+static uint64_t tx_cycles;
+
+static void receiver_fn(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	ssize_t len;
+	int sock;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0 ||
+	    bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("receiver setup failed (%d)\n", errno);
+		return;
+	}
+
+	k_sem_give(&receiver_ready);
+
+	while ((len = recv(sock, rx_buf, sizeof(rx_buf), 0)) >= 0) {
+		received += len;
+	}
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY_TX)
+struct tx_slot {
+	struct net_pkt_ext_done done;
+	struct k_sem free;
+};
+
+static struct tx_slot slots[BUF_COUNT];
+
+static void tx_done(struct net_pkt_ext_done *done)
+{
+	struct tx_slot *slot = CONTAINER_OF(done, struct tx_slot, done);
+
+	k_sem_give(&slot->free);
+}
+
+static void send_init(void)
+{
+	for (int i = 0; i < BUF_COUNT; i++) {
+		k_sem_init(&slots[i].free, 1, 1);
+	}
+}
+
+static ssize_t send_dgram(int sock, int n)
+{
+	struct tx_slot *slot = &slots[n % BUF_COUNT];
+	struct iovec iov = {
+		.iov_base = tx_buf[n % BUF_COUNT],
+		.iov_len = DGRAM_SIZE,
+	};
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+	};
+	uint32_t start;
+	ssize_t len;
+
+	/* Wait until the stack is done with the previous datagram */
+	k_sem_take(&slot->free, K_FOREVER);
+	net_pkt_ext_done_init(&slot->done, tx_done);
+
+	start = k_cycle_get_32();
+	len = zsock_sendmsg_zc(sock, &msg, 0, &slot->done);
+	tx_cycles += k_cycle_get_32() - start;
+
+	return len;
+}
+#else
+static void send_init(void)
+{
+}
+
+static ssize_t send_dgram(int sock, int n)
+{
+	uint32_t start;
+	ssize_t len;
+
+	start = k_cycle_get_32();
+	len = send(sock, tx_buf[n % BUF_COUNT], DGRAM_SIZE, 0);
+	tx_cycles += k_cycle_get_32() - start;
+
+	return len;
+}
+#endif
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	uint32_t sent = 0U;
+	int sock;
+
+	for (int i = 0; i < BUF_COUNT; i++) {
+		memset(tx_buf[i], i, DGRAM_SIZE);
+	}
+
+	send_init();
+
+	inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR, &addr.sin_addr);
+
+	k_thread_create(&receiver_thread, receiver_stack, STACK_SIZE,
+			receiver_fn, NULL, NULL, NULL, RECEIVER_PRIO, 0,
+			K_NO_WAIT);
+	k_sem_take(&receiver_ready, K_FOREVER);
+
+	sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0 ||
+	    connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("connect failed (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < DGRAM_COUNT; i++) {
+		ssize_t len = send_dgram(sock, i);
+
+		if (len < 0) {
+			printk("send failed (%d)\n", errno);
+			break;
+		}
+
+		sent += len;
+	}
+
+	/* Let the receiver drain what is still queued */
+	k_msleep(100);
+
+	printk("sent %u received %u tx cycles/MiB %u\n", sent, received,
+	       (uint32_t)(tx_cycles * 1024U * 1024U / MAX(1U, sent)));
+	printk("fin\n");
+
+	close(sock);
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_fifo.h"
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_PRODUCERS 3
+#define ITEMS_PER_PRODUCER 16
+
+#ifdef CONFIG_QUEUE_MPSC
+/**TESTPOINT: init via K_FIFO_MPSC_DEFINE*/
+K_FIFO_MPSC_DEFINE(kfifo_mpsc);
+
+static struct k_fifo fifo_mpsc;
+static fdata_t items[NUM_PRODUCERS][ITEMS_PER_PRODUCER];
+
+static K_THREAD_STACK_ARRAY_DEFINE(pstacks, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread pthreads[NUM_PRODUCERS];
+
+static void tfifo_mpsc_order(struct k_fifo *pfifo)
+{
+	fdata_t *d = items[0];
+
+	zassert_true(k_fifo_is_empty(pfifo), NULL);
+
+	/* Lock-free puts, then a locked put_list, then lock-free again:
+	 * the list must land behind the earlier lock-free items
+	 */
+	k_fifo_put(pfifo, &d[0]);
+	k_fifo_put(pfifo, &d[1]);
+	zassert_false(k_fifo_is_empty(pfifo), NULL);
+
+	d[2].snode.next = &d[3].snode;
+	d[3].snode.next = NULL;
+	k_fifo_put_list(pfifo, &d[2], &d[3]);
+	k_fifo_put(pfifo, &d[4]);
+
+	zassert_equal(k_fifo_peek_head(pfifo), &d[0], NULL);
+	zassert_equal(k_fifo_peek_tail(pfifo), &d[4], NULL);
+
+	for (int i = 0; i < 5; i++) {
+		zassert_equal(k_fifo_get(pfifo, K_NO_WAIT), &d[i], NULL);
+	}
+	zassert_true(k_fifo_is_empty(pfifo), NULL);
+	zassert_is_null(k_fifo_get(pfifo, K_NO_WAIT), NULL);
+}
+
+static void tisr_put(const void *p)
+{
+	k_fifo_put(&fifo_mpsc, (void *)p);
+}
+
+static void tthread_isr_put(void *p1, void *p2, void *p3)
+{
+	irq_offload(tisr_put, p1);
+}
+
+static void tproducer(void *p1, void *p2, void *p3)
+{
+	fdata_t *d = items[POINTER_TO_INT(p1)];
+
+	for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+		d[i].data = POINTER_TO_INT(p1) * ITEMS_PER_PRODUCER + i;
+		k_fifo_put(&fifo_mpsc, &d[i]);
+		if ((i % 4) == 3) {
+			k_yield();
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Test ordering of a lock-free producer mode FIFO
+ *
+ * @ingroup kernel_fifo_tests
+ *
+ * @see k_fifo_init_mpsc(), K_FIFO_MPSC_DEFINE(), k_fifo_put(),
+ * k_fifo_put_list(), k_fifo_peek_head(), k_fifo_peek_tail()
+ */
+void test_fifo_mpsc_order(void)
+{
+#ifdef CONFIG_QUEUE_MPSC
+	/**TESTPOINT: init via k_fifo_init_mpsc*/
+	k_fifo_init_mpsc(&fifo_mpsc);
+	tfifo_mpsc_order(&fifo_mpsc);
+
+	/**TESTPOINT: test K_FIFO_MPSC_DEFINEed fifo*/
+	tfifo_mpsc_order(&kfifo_mpsc);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test an ISR waking a thread pended on a lock-free FIFO
+ *
+ * @ingroup kernel_fifo_tests
+ *
+ * @see k_fifo_init_mpsc(), k_fifo_put(), k_fifo_get()
+ */
+void test_fifo_mpsc_isr2thread(void)
+{
+#ifdef CONFIG_QUEUE_MPSC
+	fdata_t *d = items[0];
+	k_tid_t tid;
+
+	k_fifo_init_mpsc(&fifo_mpsc);
+
+	/* Lower priority, so it only raises the ISR once we pend */
+	tid = k_thread_create(&pthreads[0], pstacks[0], STACK_SIZE,
+			      tthread_isr_put, &d[0], NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(1));
+
+	zassert_equal(k_fifo_get(&fifo_mpsc, K_FOREVER), &d[0], NULL);
+	zassert_true(k_fifo_is_empty(&fifo_mpsc), NULL);
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(0));
+	k_thread_abort(tid);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test several producers on a lock-free FIFO
+ *
+ * Each producer's items must come out in the order it put them.
+ *
+ * @ingroup kernel_fifo_tests
+ *
+ * @see k_fifo_init_mpsc(), k_fifo_put(), k_fifo_get()
+ */
+void test_fifo_mpsc_producers(void)
+{
+#ifdef CONFIG_QUEUE_MPSC
+	int next[NUM_PRODUCERS] = { 0 };
+
+	k_fifo_init_mpsc(&fifo_mpsc);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&pthreads[i], pstacks[i], STACK_SIZE,
+				tproducer, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int n = 0; n < NUM_PRODUCERS * ITEMS_PER_PRODUCER; n++) {
+		fdata_t *rx = k_fifo_get(&fifo_mpsc, K_MSEC(1000));
+		int p, i;
+
+		zassert_not_null(rx, "item %d missing", n);
+		p = rx->data / ITEMS_PER_PRODUCER;
+		i = rx->data % ITEMS_PER_PRODUCER;
+		zassert_equal(i, next[p], "producer %d out of order", p);
+		next[p]++;
+	}
+
+	zassert_true(k_fifo_is_empty(&fifo_mpsc), NULL);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&pthreads[i], K_FOREVER);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
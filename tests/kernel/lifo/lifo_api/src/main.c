@@ -26,6 +26,7 @@ extern void test_lifo_thread2isr(void);
 extern void test_lifo_isr2thread(void);
 extern void test_lifo_get_fail(void);
 extern void test_lifo_loop(void);
+extern void test_lifo_mpsc(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -35,6 +36,7 @@ void test_main(void)
 		ztest_unit_test(test_lifo_thread2isr),
 		ztest_unit_test(test_lifo_isr2thread),
 		ztest_unit_test(test_lifo_get_fail),
-		ztest_1cpu_unit_test(test_lifo_loop));
+		ztest_1cpu_unit_test(test_lifo_loop),
+		ztest_unit_test(test_lifo_mpsc));
 	ztest_run_test_suite(lifo_api);
 }
@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_lifo.h"
+
+#define LIST_LEN 4
+
+#ifdef CONFIG_QUEUE_MPSC
+/**TESTPOINT: init via K_LIFO_MPSC_DEFINE*/
+K_LIFO_MPSC_DEFINE(klifo_mpsc);
+
+static struct k_lifo lifo_mpsc;
+static ldata_t data[LIST_LEN];
+
+static void tisr_put(const void *p)
+{
+	k_lifo_put(&lifo_mpsc, (void *)p);
+}
+
+static void tlifo_mpsc_order(struct k_lifo *plifo)
+{
+	/* Lock-free puts interleaved with gets, which drain the
+	 * pending items under the lock, must keep LIFO order
+	 */
+	k_lifo_put(plifo, &data[0]);
+	k_lifo_put(plifo, &data[1]);
+	zassert_equal(k_lifo_get(plifo, K_NO_WAIT), &data[1], NULL);
+	k_lifo_put(plifo, &data[2]);
+	k_lifo_put(plifo, &data[3]);
+
+	for (int i = 3; i >= 0; i--) {
+		if (i == 1) {
+			continue;
+		}
+		zassert_equal(k_lifo_get(plifo, K_NO_WAIT), &data[i], NULL);
+	}
+	zassert_is_null(k_lifo_get(plifo, K_NO_WAIT), NULL);
+}
+#endif
+
+/**
+ * @brief Test a lock-free producer mode LIFO
+ *
+ * @ingroup kernel_lifo_tests
+ *
+ * @see k_lifo_init_mpsc(), K_LIFO_MPSC_DEFINE(), k_lifo_put(),
+ * k_lifo_get()
+ */
+void test_lifo_mpsc(void)
+{
+#ifdef CONFIG_QUEUE_MPSC
+	/**TESTPOINT: init via k_lifo_init_mpsc*/
+	k_lifo_init_mpsc(&lifo_mpsc);
+	tlifo_mpsc_order(&lifo_mpsc);
+
+	/**TESTPOINT: test K_LIFO_MPSC_DEFINEed lifo*/
+	tlifo_mpsc_order(&klifo_mpsc);
+
+	/**TESTPOINT: put from ISR*/
+	irq_offload(tisr_put, &data[0]);
+	zassert_equal(k_lifo_get(&lifo_mpsc, K_NO_WAIT), &data[0], NULL);
+#else
+	ztest_test_skip();
+#endif
+}
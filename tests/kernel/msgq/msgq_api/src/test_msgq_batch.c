@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 8
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_BMEM uint32_t tx[BATCH_LEN * 2];
+static ZTEST_BMEM uint32_t rx[BATCH_LEN * 2];
+static ZTEST_BMEM int thread_ret;
+
+static void fill_tx(uint32_t base)
+{
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = base + i;
+	}
+}
+
+static void batch_put_get(struct k_msgq *q)
+{
+	int ret;
+
+	fill_tx(MSG0);
+
+	ret = k_msgq_put_batch(q, tx, 5, K_NO_WAIT);
+	zassert_equal(ret, 5, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 5, NULL);
+
+	ret = k_msgq_get_batch(q, rx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rx[i], tx[i], NULL);
+	}
+
+	/**TESTPOINT: batch wraps around the end of the ring buffer and
+	 * stops when the queue is full
+	 */
+	ret = k_msgq_put_batch(q, &tx[5], 10, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 2, NULL);
+	zassert_equal(k_msgq_num_free_get(q), 0, NULL);
+	ret = k_msgq_put_batch(q, tx, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_put_batch(q, tx, 1, TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+
+	ret = k_msgq_get_batch(q, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(rx[i], tx[i + 3], NULL);
+	}
+
+	ret = k_msgq_get_batch(q, rx, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+	ret = k_msgq_get_batch(q, rx, 1, TIMEOUT);
+	zassert_equal(ret, -EAGAIN, NULL);
+	zassert_equal(k_msgq_put_batch(q, tx, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_batch(q, rx, 0, K_NO_WAIT), 0, NULL);
+}
+
+static void batch_reader(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_msgq_get_batch((struct k_msgq *)p1, rx, 4, K_FOREVER);
+}
+
+static void batch_writer(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_msgq_put_batch((struct k_msgq *)p1, &tx[BATCH_LEN], 3,
+				      K_FOREVER);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test batch send and receive
+ * @see k_msgq_put_batch(), k_msgq_get_batch()
+ */
+void test_msgq_batch(void)
+{
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+	batch_put_get(&msgq);
+}
+
+/**
+ * @brief Test batch send and receive from a user thread
+ * @see k_msgq_alloc_init(), k_msgq_put_batch(), k_msgq_get_batch()
+ */
+#ifdef CONFIG_USERSPACE
+void test_msgq_user_batch(void)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN), NULL);
+	batch_put_get(q);
+}
+#endif
+
+/**
+ * @brief Test batches against threads pending on the queue
+ *
+ * @details A batch sent to an empty queue satisfies a pending receiver
+ * in full, and a batch received from a full queue pulls in the messages
+ * of a pending sender.
+ *
+ * @see k_msgq_put_batch(), k_msgq_get_batch()
+ */
+void test_msgq_batch_pend(void)
+{
+	int ret;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+	fill_tx(MSG1);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_reader, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	ret = k_msgq_put_batch(&msgq, tx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 3, NULL);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rx[i], tx[i], NULL);
+	}
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+
+	ret = k_msgq_put_batch(&msgq, tx, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE, batch_writer, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	ret = k_msgq_get_batch(&msgq, rx, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 3, NULL);
+
+	ret = k_msgq_get_batch(&msgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rx[i], tx[BATCH_LEN + i], NULL);
+	}
+}
+
+/**
+ * @brief Test zero-copy claim and commit
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_commit()
+ */
+void test_msgq_claim_commit(void)
+{
+	uint32_t *slot;
+	uint32_t n;
+
+	k_msgq_init(&msgq, bbuffer, MSG_SIZE, BATCH_LEN);
+	fill_tx(MSG0);
+
+	n = k_msgq_get_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(n, 0, NULL);
+
+	n = k_msgq_put_claim(&msgq, (void **)&slot, 6);
+	zassert_equal(n, 6, NULL);
+	zassert_equal_ptr(slot, bbuffer, NULL);
+	for (int i = 0; i < n; i++) {
+		slot[i] = tx[i];
+	}
+	zassert_equal(k_msgq_put_commit(&msgq, BATCH_LEN + 1), -EINVAL, NULL);
+	zassert_equal(k_msgq_put_commit(&msgq, n), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 6, NULL);
+
+	n = k_msgq_get_claim(&msgq, (void **)&slot, 4);
+	zassert_equal(n, 4, NULL);
+	for (int i = 0; i < n; i++) {
+		zassert_equal(slot[i], tx[i], NULL);
+	}
+	zassert_equal(k_msgq_get_commit(&msgq, n), 0, NULL);
+
+	/**TESTPOINT: claims stop at the end of the ring buffer */
+	n = k_msgq_put_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(n, BATCH_LEN - 6, NULL);
+	zassert_equal(k_msgq_put_commit(&msgq, n), 0, NULL);
+	n = k_msgq_put_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(n, 4, NULL);
+	zassert_equal_ptr(slot, bbuffer, NULL);
+	zassert_equal(k_msgq_put_commit(&msgq, 0), 0, NULL);
+
+	n = k_msgq_get_claim(&msgq, (void **)&slot, BATCH_LEN);
+	zassert_equal(n, BATCH_LEN - 4, NULL);
+	zassert_equal(slot[0], tx[4], NULL);
+	zassert_equal(k_msgq_get_commit(&msgq, n + 1), -EINVAL, NULL);
+	zassert_equal(k_msgq_get_commit(&msgq, n), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
+
+/**
+ * @}
+ */
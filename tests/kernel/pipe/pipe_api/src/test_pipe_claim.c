@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for the Pipe zero-copy claim / finish API
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define CLAIM_LEN	8
+
+static unsigned char __aligned(4) cbuffer[CLAIM_LEN];
+K_PIPE_DEFINE(cpipe, CLAIM_LEN, 4);
+static struct k_pipe cbufferless;
+
+static K_THREAD_STACK_DEFINE(cstack, STACK_SIZE);
+static struct k_thread cdata;
+static unsigned char rx[CLAIM_LEN];
+static size_t xferd;
+static int thread_ret;
+
+static void claim_reader(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_pipe_get(&cpipe, rx, 4, &xferd, 4, K_FOREVER);
+}
+
+static void claim_writer(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_pipe_put(&cpipe, "wxyz", 4, &xferd, 4, K_FOREVER);
+}
+
+/**
+ * @brief Test claiming and finishing space in a pipe's buffer
+ *
+ * Claims never extend past the end of the buffer, so a region that
+ * wraps is handed out in two parts.
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+void test_pipe_claim_finish(void)
+{
+	struct k_pipe pipe;
+	uint8_t *ptr;
+	size_t n;
+
+	k_pipe_init(&pipe, cbuffer, sizeof(cbuffer));
+
+	zassert_equal(k_pipe_get_claim(&pipe, &ptr, CLAIM_LEN), 0, NULL);
+
+	n = k_pipe_put_claim(&pipe, &ptr, 5);
+	zassert_equal(n, 5, NULL);
+	zassert_equal_ptr(ptr, cbuffer, NULL);
+	memcpy(ptr, "abcde", n);
+	zassert_equal(k_pipe_put_finish(&pipe, CLAIM_LEN + 1), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_finish(&pipe, n), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&pipe), 5, NULL);
+
+	n = k_pipe_get_claim(&pipe, &ptr, 3);
+	zassert_equal(n, 3, NULL);
+	zassert_mem_equal(ptr, "abc", n, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, n), 0, NULL);
+
+	n = k_pipe_put_claim(&pipe, &ptr, CLAIM_LEN);
+	zassert_equal(n, 3, NULL);
+	memcpy(ptr, "fgh", n);
+	zassert_equal(k_pipe_put_finish(&pipe, n), 0, NULL);
+
+	n = k_pipe_put_claim(&pipe, &ptr, CLAIM_LEN);
+	zassert_equal(n, 3, NULL);
+	zassert_equal_ptr(ptr, cbuffer, NULL);
+	memcpy(ptr, "ijk", n);
+	zassert_equal(k_pipe_put_finish(&pipe, n), 0, NULL);
+	zassert_equal(k_pipe_put_claim(&pipe, &ptr, CLAIM_LEN), 0, NULL);
+
+	n = k_pipe_get_claim(&pipe, &ptr, CLAIM_LEN);
+	zassert_equal(n, 5, NULL);
+	zassert_mem_equal(ptr, "defgh", n, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, n + 1), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, n), 0, NULL);
+
+	n = k_pipe_get_claim(&pipe, &ptr, CLAIM_LEN);
+	zassert_equal(n, 3, NULL);
+	zassert_mem_equal(ptr, "ijk", n, NULL);
+	zassert_equal(k_pipe_get_finish(&pipe, n), 0, NULL);
+	zassert_equal(k_pipe_read_avail(&pipe), 0, NULL);
+
+	zassert_equal(k_pipe_put_claim(&cbufferless, &ptr, 1), 0, NULL);
+	zassert_equal(k_pipe_get_claim(&cbufferless, &ptr, 1), 0, NULL);
+}
+
+/**
+ * @brief Test that finishing a claim serves threads pending on the pipe
+ *
+ * @see k_pipe_put_finish(), k_pipe_get_finish()
+ */
+void test_pipe_claim_wakeup(void)
+{
+	uint8_t *ptr;
+	size_t n;
+
+	k_thread_create(&cdata, cstack, STACK_SIZE, claim_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	n = k_pipe_put_claim(&cpipe, &ptr, 4);
+	zassert_equal(n, 4, NULL);
+	memcpy(ptr, "1234", n);
+	zassert_equal(k_pipe_put_finish(&cpipe, n), 0, NULL);
+	k_thread_join(&cdata, K_FOREVER);
+	zassert_equal(thread_ret, 0, NULL);
+	zassert_equal(xferd, 4, NULL);
+	zassert_mem_equal(rx, "1234", 4, NULL);
+	zassert_equal(k_pipe_read_avail(&cpipe), 0, NULL);
+
+	/* fill the buffer so that the writer has to wait */
+	while ((n = k_pipe_put_claim(&cpipe, &ptr, CLAIM_LEN)) != 0) {
+		memset(ptr, 'a', n);
+		zassert_equal(k_pipe_put_finish(&cpipe, n), 0, NULL);
+	}
+
+	k_thread_create(&cdata, cstack, STACK_SIZE, claim_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(50);
+
+	n = k_pipe_get_claim(&cpipe, &ptr, 4);
+	zassert_equal(n, 4, NULL);
+	zassert_equal(k_pipe_get_finish(&cpipe, n), 0, NULL);
+	k_thread_join(&cdata, K_FOREVER);
+	zassert_equal(thread_ret, 0, NULL);
+	zassert_equal(xferd, 4, NULL);
+
+	zassert_equal(k_pipe_get(&cpipe, rx, CLAIM_LEN, &n, CLAIM_LEN,
+				 K_NO_WAIT), 0, NULL);
+	zassert_mem_equal(rx, "aaaawxyz", CLAIM_LEN, NULL);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,317 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define NUM_SEMS 40
+
+struct set_fifo_msg {
+	void *private;
+	uint32_t msg;
+};
+
+static struct k_poll_set set;
+static struct k_poll_set other_set;
+static struct k_sem set_sem;
+static struct k_fifo set_fifo;
+static struct k_poll_signal set_signal;
+static struct k_sem sems[NUM_SEMS];
+static struct k_poll_event sem_events[NUM_SEMS];
+static struct k_thread set_thread;
+K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_sem signal_woken;
+static struct k_thread signal_threads[2];
+K_THREAD_STACK_ARRAY_DEFINE(signal_stacks, 2, STACK_SIZE);
+
+/**
+ * @brief Test adding, removing and checking events of a poll set
+ *
+ * @details Returned events are reported again while their condition
+ * holds, and removed events are no longer reported.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove(),
+ * k_poll_set_wait()
+ */
+void test_poll_set_no_wait(void)
+{
+	struct set_fifo_msg msg = { NULL, 0 };
+	struct k_poll_event *ready[4];
+	struct k_poll_event events[3];
+
+	k_sem_init(&set_sem, 0, 1);
+	k_fifo_init(&set_fifo);
+	k_poll_signal_init(&set_signal);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[2], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	k_poll_set_init(&set);
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		zassert_equal(k_poll_set_add(&set, &events[i]), 0, NULL);
+	}
+	zassert_equal(k_poll_set_add(&set, &events[0]), -EALREADY, NULL);
+
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* level-triggered: reported until the semaphore is taken */
+	k_sem_give(&set_sem);
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+					      K_NO_WAIT), 1, NULL);
+		zassert_equal_ptr(ready[0], &events[0], NULL);
+		zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE,
+			      NULL);
+	}
+	zassert_equal(k_sem_take(&set_sem, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_equal(events[0].state, K_POLL_STATE_NOT_READY, NULL);
+
+	/* ready events come back in the order they were signaled */
+	k_poll_signal_raise(&set_signal, 0);
+	k_fifo_put(&set_fifo, &msg);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2, NULL);
+	zassert_equal_ptr(ready[0], &events[2], NULL);
+	zassert_equal_ptr(ready[1], &events[1], NULL);
+	zassert_equal(events[1].state, K_POLL_STATE_FIFO_DATA_AVAILABLE,
+		      NULL);
+
+	/* only as many as requested; the rest stay queued */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+
+	k_poll_signal_reset(&set_signal);
+	zassert_equal(k_poll_set_remove(&set, &events[1]), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &events[1]), -EINVAL, NULL);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT), NULL);
+
+	zassert_equal(k_poll_set_remove(&set, &events[0]), 0, NULL);
+	zassert_equal(k_poll_set_remove(&set, &events[2]), 0, NULL);
+}
+
+static void set_give_entry(void *p1, void *p2, void *p3)
+{
+	k_msleep(10);
+	k_sem_give((struct k_sem *)p1);
+}
+
+/**
+ * @brief Test waiting on a large poll set
+ *
+ * @details Only the event that fired is returned, without touching the
+ * others, and the set can be waited on repeatedly.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_wait(void)
+{
+	struct k_poll_event *ready[NUM_SEMS];
+
+	k_poll_set_init(&set);
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&sems[i], 0, 1);
+		k_poll_event_init(&sem_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &sems[i]);
+		sem_events[i].tag = i;
+		zassert_equal(k_poll_set_add(&set, &sem_events[i]), 0, NULL);
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_MSEC(10)),
+		      -EAGAIN, NULL);
+
+	for (int i = 0; i < NUM_SEMS; i += 13) {
+		k_thread_create(&set_thread, set_stack, STACK_SIZE,
+				set_give_entry, &sems[i], NULL, NULL,
+				K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+
+		zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS,
+					      K_FOREVER), 1, NULL);
+		zassert_equal(ready[0]->tag, i, NULL);
+		zassert_equal(k_sem_take(&sems[i], K_NO_WAIT), 0, NULL);
+		k_thread_join(&set_thread, K_FOREVER);
+	}
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &sem_events[i]), 0, NULL);
+	}
+}
+
+static void set_poll_entry(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event event;
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, p1);
+	(void)k_poll(&event, 1, K_FOREVER);
+}
+
+/**
+ * @brief Test poll sets sharing an object with other pollers
+ *
+ * @details Every poll set waiting on an object is notified, not only the
+ * first poller, whether it is another set or a thread in k_poll().
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+void test_poll_set_shared(void)
+{
+	struct set_fifo_msg msg = { NULL, 0 };
+	struct k_poll_event *ready[1];
+	struct k_poll_event events[2];
+
+	k_sem_init(&set_sem, 0, 1);
+	k_fifo_init(&set_fifo);
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	k_poll_event_init(&events[1], K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+
+	k_poll_set_init(&set);
+	k_poll_set_init(&other_set);
+	zassert_equal(k_poll_set_add(&set, &events[0]), 0, NULL);
+	zassert_equal(k_poll_set_add(&other_set, &events[1]), 0, NULL);
+
+	k_fifo_put(&set_fifo, &msg);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal(k_poll_set_wait(&other_set, ready, 1, K_NO_WAIT), 1,
+		      NULL);
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT), NULL);
+
+	zassert_equal(k_poll_set_remove(&set, &events[0]), 0, NULL);
+	zassert_equal(k_poll_set_remove(&other_set, &events[1]), 0, NULL);
+
+	/* a thread in k_poll() queues ahead of the set */
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	zassert_equal(k_poll_set_add(&set, &events[0]), 0, NULL);
+
+	k_thread_create(&set_thread, set_stack, STACK_SIZE,
+			set_poll_entry, &set_sem, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+	k_msleep(10);
+
+	k_sem_give(&set_sem);
+	k_thread_join(&set_thread, K_FOREVER);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &events[0], NULL);
+
+	zassert_equal(k_poll_set_remove(&set, &events[0]), 0, NULL);
+}
+
+/**
+ * @brief Test re-checking the events of a poll set
+ *
+ * @details An event whose object became ready without signaling is
+ * reported once the set is refreshed.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_refresh()
+ */
+void test_poll_set_refresh(void)
+{
+	struct k_poll_event *ready[1];
+	struct k_poll_event event;
+
+	k_sem_init(&set_sem, 0, 1);
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+
+	k_poll_set_init(&set);
+	zassert_equal(k_poll_set_add(&set, &event), 0, NULL);
+
+	/* behind the set's back, as if its notification had been lost */
+	set_sem.count = 1U;
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN,
+		      NULL);
+
+	k_poll_set_refresh(&set, &event, 1);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal(event.state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+
+	/* events already reported are left alone */
+	k_poll_set_refresh(&set, &event, 1);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+
+	zassert_equal(k_poll_set_remove(&set, &event), 0, NULL);
+}
+
+static void set_signal_entry(void *p1, void *p2, void *p3)
+{
+	struct k_poll_event event;
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, p1);
+	if (k_poll(&event, 1, K_FOREVER) == 0 &&
+	    event.state == K_POLL_STATE_SIGNALED) {
+		k_sem_give(&signal_woken);
+	}
+}
+
+/**
+ * @brief Test raising a poll signal with several pollers
+ *
+ * @details Every thread in k_poll() on the signal wakes up, and so does
+ * the poll set waiting on it.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_signal_raise()
+ */
+void test_poll_set_signal(void)
+{
+	struct k_poll_event *ready[1];
+	struct k_poll_event event;
+	int i;
+
+	k_sem_init(&signal_woken, 0, ARRAY_SIZE(signal_threads));
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	k_poll_set_init(&set);
+	zassert_equal(k_poll_set_add(&set, &event), 0, NULL);
+
+	for (i = 0; i < ARRAY_SIZE(signal_threads); i++) {
+		k_thread_create(&signal_threads[i], signal_stacks[i],
+				STACK_SIZE, set_signal_entry, &set_signal,
+				NULL, NULL, K_HIGHEST_THREAD_PRIO, 0,
+				K_NO_WAIT);
+	}
+	k_msleep(10);
+
+	zassert_equal(k_poll_signal_raise(&set_signal, 0), 0, NULL);
+
+	for (i = 0; i < ARRAY_SIZE(signal_threads); i++) {
+		zassert_equal(k_sem_take(&signal_woken, K_MSEC(100)), 0,
+			      "poller %d not woken", i);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(signal_threads); i++) {
+		k_thread_join(&signal_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1, NULL);
+	zassert_equal_ptr(ready[0], &event, NULL);
+
+	k_poll_signal_reset(&set_signal);
+	zassert_equal(k_poll_set_remove(&set, &event), 0, NULL);
+}
@@ -709,6 +709,71 @@ void test_timeout_abs(void)
 #endif
 }
 
+/* Tick counts on either side of the first boundaries of the timing
+ * wheel levels, so that timeouts are cascaded down from each of them
+ */
+static const uint32_t exact_ticks[] = {
+	1, 63, 64, 65, 129, 4095, 4096, 4161,
+};
+static struct k_timer exact_timers[ARRAY_SIZE(exact_ticks)];
+static int64_t exact_fired[ARRAY_SIZE(exact_ticks)];
+
+/* Longest timeout worth waiting for on slow tick rates */
+#define EXACT_MAX_MS 10000
+
+static void exact_expire(struct k_timer *timer)
+{
+	exact_fired[timer - exact_timers] = k_uptime_ticks();
+}
+
+/**
+ * @brief Test that timeouts expire exactly on their tick
+ *
+ * @details Start timers of various tick counts within the same tick
+ * and check that each expires on the tick after its duration, however
+ * many levels of the timeout queue it went through.
+ *
+ * @ingroup kernel_timer_tests
+ */
+void test_timeout_exact_tick(void)
+{
+	uint32_t max_ticks = k_ms_to_ticks_floor32(EXACT_MAX_MS);
+	int64_t start;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(exact_timers); i++) {
+		k_timer_init(&exact_timers[i], exact_expire, NULL);
+	}
+
+	/* Restart them all if a tick went by while starting them */
+	do {
+		k_usleep(1); /* align to tick */
+		start = k_uptime_ticks();
+		for (i = 0; i < ARRAY_SIZE(exact_timers); i++) {
+			if (exact_ticks[i] > max_ticks) {
+				continue;
+			}
+			exact_fired[i] = 0;
+			k_timer_start(&exact_timers[i],
+				      K_TICKS(exact_ticks[i]), K_NO_WAIT);
+		}
+	} while (k_uptime_ticks() != start);
+
+	/* A timeout of N ticks expires N + 1 ticks from now, the current
+	 * tick being partially elapsed
+	 */
+	for (i = 0; i < ARRAY_SIZE(exact_timers); i++) {
+		if (exact_ticks[i] > max_ticks) {
+			continue;
+		}
+		k_timer_status_sync(&exact_timers[i]);
+		zassert_equal(exact_fired[i] - start, exact_ticks[i] + 1,
+			      "%u ticks timeout expired after %lld ticks",
+			      exact_ticks[i],
+			      (long long)(exact_fired[i] - start));
+	}
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -744,6 +809,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_k_define),
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
-			 ztest_user_unit_test(test_timeout_abs));
+			 ztest_user_unit_test(test_timeout_abs),
+			 ztest_unit_test(test_timeout_exact_tick));
 	ztest_run_test_suite(timer_api);
 }
@@ -292,13 +292,245 @@ static void test_realloc(void)
 	zassert_true(realloc_check_block(p3, p1, 61), "data changed");
 }
 
+static void test_realloc_move_down(void)
+{
+	struct sys_heap heap;
+	void *p1, *p2, *p3, *p4, *p5;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* Free block below, allocated block above: growing must slide
+	 * the data down into the hole rather than copy elsewhere.
+	 */
+	p1 = sys_heap_alloc(&heap, 64);
+	p2 = sys_heap_alloc(&heap, 64);
+	p3 = sys_heap_alloc(&heap, 64);
+	p5 = sys_heap_alloc(&heap, 64);
+	realloc_fill_block(p2, 64);
+	sys_heap_free(&heap, p1);
+
+	p4 = sys_heap_realloc(&heap, p2, 120);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	zassert_true(p4 == p1, "Realloc should have moved down %p -> %p",
+		     p2, p4);
+	zassert_true(realloc_check_block(p4, p2, 64), "data changed");
+
+	/* Growing with no room on either side copies, and only the
+	 * old contents
+	 */
+	p1 = sys_heap_realloc(&heap, p3, 512);
+	zassert_not_null(p1, "realloc failed");
+	zassert_true(p1 != p3, "Realloc should have moved %p", p3);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_free(&heap, p5);
+}
+
+static void test_aligned_alloc(void)
+{
+	struct sys_heap heap;
+	void *p[32];
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		size_t align = 16 << (i % 3);
+
+		p[i] = sys_heap_aligned_alloc(&heap, align, 8 + (i % 5) * 8);
+		if (p[i] != NULL) {
+			zassert_true(((uintptr_t)p[i] & (align - 1)) == 0,
+				     "%p not aligned to %d", p[i], (int)align);
+		}
+		zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+		/* Punch holes so later requests can find
+		 * pre-aligned free chunks
+		 */
+		if ((i % 4) == 3) {
+			sys_heap_free(&heap, p[i - 2]);
+			p[i - 2] = NULL;
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(p); i++) {
+		sys_heap_free(&heap, p[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+}
+
+static void test_runtime_stats(void)
+{
+	struct sys_heap heap;
+	struct sys_heap_runtime_stats stats;
+	size_t total, largest;
+	void *p1, *p2;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_equal(sys_heap_runtime_stats_get(&heap, NULL), -EINVAL, "");
+	zassert_equal(sys_heap_runtime_stats_get(&heap, &stats), 0, "");
+	zassert_equal(stats.allocated_bytes, 0, "");
+	zassert_equal(stats.free_chunks, 1, "");
+	total = stats.free_bytes;
+
+	/* The reported largest block must fit, one byte more must not */
+	largest = stats.max_free_bytes;
+	zassert_is_null(sys_heap_alloc(&heap, largest + 1), "");
+	p1 = sys_heap_alloc(&heap, largest);
+	zassert_not_null(p1, "");
+	sys_heap_free(&heap, p1);
+
+	/* Fragment the heap: the free space splits in two */
+	p1 = sys_heap_alloc(&heap, 128);
+	p2 = sys_heap_alloc(&heap, 128);
+	sys_heap_free(&heap, p1);
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.free_chunks, 2, "");
+	zassert_equal(stats.free_bytes + stats.allocated_bytes, total, "");
+	zassert_true(stats.max_free_bytes < largest - 128, "");
+
+	size_t sum = 0;
+
+	for (int b = 0; b < stats.nb_buckets; b++) {
+		sum += stats.bucket_free_bytes[b];
+	}
+	zassert_equal(sum, stats.free_bytes, "");
+
+	sys_heap_free(&heap, p2);
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.max_free_bytes, largest, "");
+}
+
+static struct k_heap kheap;
+
+/* Exhaust the heap with small blocks, free them all, then check that
+ * the memory coalesces back into one large block: nothing may stay
+ * stranded in the per-CPU caches when CONFIG_HEAP_CPU_CACHE is used.
+ */
+static void test_k_heap_drain(void)
+{
+	void **blocks = (void **)scratchmem;
+	size_t max = sizeof(scratchmem) / sizeof(void *);
+	size_t n = 0;
+	void *p;
+
+	k_heap_init(&kheap, heapmem, SMALL_HEAP_SZ);
+
+	while (n < max) {
+		blocks[n] = k_heap_alloc(&kheap, 16, K_NO_WAIT);
+		if (blocks[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+	zassert_true(n > 0 && n < max, "unexpected block count %d", (int)n);
+
+	while (n > 0) {
+		k_heap_free(&kheap, blocks[--n]);
+	}
+
+	p = k_heap_alloc(&kheap, SMALL_HEAP_SZ / 2, K_NO_WAIT);
+	zassert_not_null(p, "freed memory did not coalesce");
+	k_heap_free(&kheap, p);
+	zassert_true(sys_heap_validate(&kheap.heap), "invalid heap");
+}
+
+/* Multi-threaded stress: several threads hammer one k_heap at once,
+ * each running the sys_heap stress rig over its own share of the
+ * heap.  Reports aggregate alloc/free throughput.
+ */
+#define STRESS_THREADS MAX(2, CONFIG_MP_NUM_CPUS)
+#define STRESS_STACK_SZ (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define STRESS_SCRATCH_SZ (SCRATCH_SZ / STRESS_THREADS)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stress_stacks, STRESS_THREADS,
+				   STRESS_STACK_SZ);
+static struct k_thread stress_threads[STRESS_THREADS];
+static struct z_heap_stress_result stress_results[STRESS_THREADS];
+static K_SEM_DEFINE(stress_done, 0, STRESS_THREADS);
+
+void *kheap_testalloc(void *arg, size_t bytes)
+{
+	void *ret = k_heap_alloc(arg, bytes, K_NO_WAIT);
+
+	fill_block(ret, bytes);
+	return ret;
+}
+
+void kheap_testfree(void *arg, void *p)
+{
+	check_fill(p);
+	k_heap_free(arg, p);
+}
+
+static void stress_thread(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sys_heap_stress(kheap_testalloc, kheap_testfree, &kheap,
+			BIG_HEAP_SZ / STRESS_THREADS, ITERATION_COUNT,
+			(char *)scratchmem + id * STRESS_SCRATCH_SZ,
+			STRESS_SCRATCH_SZ, 50, &stress_results[id]);
+
+	k_sem_give(&stress_done);
+}
+
+static void test_k_heap_threads(void)
+{
+	uint32_t ops = 0, successful = 0, start, cycles;
+
+	TC_PRINT("Testing %d threads on a shared (%d byte) k_heap\n",
+		 STRESS_THREADS, (int) BIG_HEAP_SZ);
+
+	k_heap_init(&kheap, heapmem, BIG_HEAP_SZ);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		k_thread_create(&stress_threads[i], stress_stacks[i],
+				STRESS_STACK_SZ, stress_thread,
+				INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		k_sem_take(&stress_done, K_FOREVER);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	for (int i = 0; i < STRESS_THREADS; i++) {
+		struct z_heap_stress_result *r = &stress_results[i];
+
+		ops += r->total_allocs + r->total_frees;
+		successful += r->successful_allocs;
+	}
+
+	zassert_true(successful > 0, "no allocation succeeded");
+	zassert_true(sys_heap_validate(&kheap.heap), "invalid heap");
+
+	if (cycles > 0) {
+		TC_PRINT("%u alloc/free ops in %u cycles: %u ops/sec\n",
+			 ops, cycles, (uint32_t)((uint64_t)ops *
+				sys_clock_hw_cycles_per_sec() / cycles));
+	} else {
+		TC_PRINT("%u alloc/free ops (no cycle count)\n", ops);
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(lib_heap_test,
 			 ztest_unit_test(test_realloc),
+			 ztest_unit_test(test_realloc_move_down),
+			 ztest_unit_test(test_aligned_alloc),
+			 ztest_unit_test(test_runtime_stats),
 			 ztest_unit_test(test_small_heap),
 			 ztest_unit_test(test_fragmentation),
-			 ztest_unit_test(test_big_heap)
+			 ztest_unit_test(test_big_heap),
+			 ztest_unit_test(test_k_heap_drain),
+			 ztest_unit_test(test_k_heap_threads)
 			 );
 
 	ztest_run_test_suite(lib_heap_test);
@@ -195,6 +195,9 @@ static int verify_echo_reply(struct net_pkt *pkt)
 		zassert_true(false, "echo_reply invalid type or code");
 	}
 
+	zassert_equal(net_calc_chksum_icmpv4(pkt), 0,
+		      "echo_reply invalid checksum");
+
 	/* Calculate payload length */
 	payload_len = sizeof(icmpv4_echo_req) -
 		      NET_IPV4H_LEN - NET_ICMPH_LEN;
@@ -378,6 +378,66 @@ done:
 	return result;
 }
 
+static int test_parse_indexed_pdu(void)
+{
+	uint8_t pdu[] = { 0x40, 0x01, 0x12, 0x34,
+			  0xb1, 's', 0x01, '1', /* Uri-Path */
+			  0x41, 'q', /* Uri-Query */
+			  0xff, 'p' };
+	struct coap_option options[3];
+	struct coap_option found[4];
+	struct coap_packet cpkt;
+	int result = TC_FAIL;
+	int opt_num, r;
+
+	/* Only the array that holds all options is kept as an index */
+	for (opt_num = 2; opt_num <= ARRAY_SIZE(options); opt_num++) {
+		bool indexed = opt_num == ARRAY_SIZE(options);
+
+		r = coap_packet_parse_indexed(&cpkt, pdu, sizeof(pdu),
+					      options, opt_num);
+		if (r) {
+			TC_PRINT("Could not parse packet\n");
+			goto done;
+		}
+
+		if ((cpkt.opt_index != NULL) != indexed ||
+		    (indexed && cpkt.opt_index_num != 3U)) {
+			TC_PRINT("Unexpected option index\n");
+			goto done;
+		}
+
+		r = coap_find_options(&cpkt, COAP_OPTION_URI_PATH, found,
+				      ARRAY_SIZE(found));
+		if (r != 2 || found[0].len != 1U || found[0].value[0] != 's' ||
+		    found[1].len != 1U || found[1].value[0] != '1') {
+			TC_PRINT("Uri-Path options don't match reference\n");
+			goto done;
+		}
+
+		r = coap_find_options(&cpkt, COAP_OPTION_URI_QUERY, found,
+				      ARRAY_SIZE(found));
+		if (r != 1 || found[0].value[0] != 'q') {
+			TC_PRINT("Uri-Query option doesn't match reference\n");
+			goto done;
+		}
+
+		r = coap_find_options(&cpkt, COAP_OPTION_ETAG, found,
+				      ARRAY_SIZE(found));
+		if (r) {
+			TC_PRINT("There shouldn't be any ETAG option\n");
+			goto done;
+		}
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 static int test_parse_malformed_opt(void)
 {
 	uint8_t opt[] = { 0x55, 0xA5, 0x12, 0x34, 't', 'o', 'k', 'e', 'n',
@@ -588,6 +648,105 @@ out:
 
 }
 
+static const char * const tree_path_0[] = { "a", "+", NULL };
+static const char * const tree_path_1[] = { "a", "b", NULL };
+static const char * const tree_path_2[] = { "c", "#", NULL };
+static const char * const tree_path_3[] = { "c", NULL };
+static struct coap_resource tree_resources[] = {
+	{ .path = tree_path_0 },
+	{ .path = tree_path_1 },
+	{ .path = tree_path_2 },
+	{ .path = tree_path_3 },
+	{ },
+};
+
+COAP_RESOURCE_TREE_DEFINE(resource_tree, 8);
+COAP_RESOURCE_TREE_DEFINE(small_resource_tree, 3);
+
+static uint8_t path_to_options(const char *path, struct coap_option *options,
+			       uint8_t opt_num)
+{
+	uint8_t num = 0U;
+
+	while (*path && num < opt_num) {
+		const char *end = strchr(path, '/');
+
+		if (!end) {
+			end = path + strlen(path);
+		}
+
+		options[num].delta = COAP_OPTION_URI_PATH;
+		options[num].len = end - path;
+		memcpy(options[num].value, path, options[num].len);
+		num++;
+
+		path = *end ? end + 1 : end;
+	}
+
+	return num;
+}
+
+static int test_resource_tree(void)
+{
+	static const struct {
+		const char *path;
+		int resource;
+	} lookups[] = {
+		{ "a/b", 0 },
+		{ "a/x", 0 },
+		{ "a", -1 },
+		{ "a/b/c", -1 },
+		{ "c", 3 },
+		{ "c/d/e", 2 },
+		{ "x", -1 },
+		{ "", -1 },
+	};
+	struct coap_option options[4];
+	struct coap_resource *resource;
+	int result = TC_FAIL;
+	uint8_t opt_num;
+	int i, r;
+
+	r = coap_resource_tree_build(&small_resource_tree, tree_resources);
+	if (r != -ENOMEM) {
+		TC_PRINT("Tree should have run out of nodes\n");
+		goto done;
+	}
+
+	r = coap_resource_tree_build(&resource_tree, tree_resources);
+	if (r) {
+		TC_PRINT("Could not build resource tree\n");
+		goto done;
+	}
+
+	/* Root, a, +, b, c and # */
+	if (resource_tree.used != 6U) {
+		TC_PRINT("Unexpected number of nodes %u\n",
+			 resource_tree.used);
+		goto done;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(lookups); i++) {
+		opt_num = path_to_options(lookups[i].path, options,
+					  ARRAY_SIZE(options));
+
+		resource = coap_resource_tree_find(&resource_tree, options,
+						   opt_num);
+		if (resource != (lookups[i].resource < 0 ? NULL :
+				 &tree_resources[lookups[i].resource])) {
+			TC_PRINT("Wrong resource for /%s\n", lookups[i].path);
+			goto done;
+		}
+	}
+
+	result = TC_PASS;
+
+done:
+	TC_END_RESULT(result);
+
+	return result;
+}
+
 #define BLOCK_WISE_TRANSFER_SIZE_GET 128
 
 static int prepare_block1_request(struct coap_packet *req,
@@ -1303,6 +1462,11 @@ static int test_observer_server(void)
 		goto done;
 	}
 
+	if (observers[0].resource != &server_resources[0]) {
+		TC_PRINT("Observer should be bound to the resource\n");
+		goto done;
+	}
+
 	/* Suppose some time passes */
 	r = coap_resource_notify(&server_resources[0]);
 	if (r) {
@@ -1470,7 +1634,9 @@ static const struct {
 		test_parse_malformed_opt_len_ext },
 	{ "Parse malformed empty payload with marker",
 		test_parse_malformed_marker, },
+	{ "Parse indexed PDU", test_parse_indexed_pdu, },
 	{ "Test match path uri", test_match_path_uri, },
+	{ "Test resource tree", test_resource_tree, },
 	{ "Test block sized 1 transfer", test_block1_size, },
 	{ "Test block sized 2 transfer", test_block2_size, },
 	{ "Test retransmission", test_retransmit_second_round, },
@@ -1199,6 +1199,54 @@ static void test_dns_malformed_responses(void)
 	RUN_MALFORMED_TEST(resp_truncated_response_ipv4_5);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE)
+static void test_dns_cache(void)
+{
+	/* Same labels that run_dns_malformed_response() sets as the query */
+	static const char query[] = "\x03www\x0dzephyrproject\x03org";
+	static const uint8_t addr[] = { 0x8c, 0xd3, 0xa9, 0x08 };
+	struct dns_addrinfo info[DNS_CACHE_MAX_ADDRS];
+	uint32_t hits, misses;
+	int ret;
+
+	dns_cache_flush();
+
+	ret = dns_cache_find(query, DNS_QUERY_TYPE_A, info, ARRAY_SIZE(info));
+	zassert_equal(ret, -ENOENT, "Empty cache returned %d", ret);
+
+	RUN_VALID_TEST(resp_valid_response_ipv4_6);
+
+	ret = dns_cache_find(query, DNS_QUERY_TYPE_A, info, ARRAY_SIZE(info));
+	zassert_equal(ret, 1, "Answer was not cached (%d)", ret);
+	zassert_equal(info[0].ai_family, AF_INET, "Wrong family");
+	zassert_mem_equal(&net_sin(&info[0].ai_addr)->sin_addr, addr,
+			  sizeof(addr), "Wrong address cached");
+
+	ret = dns_cache_find(query, DNS_QUERY_TYPE_AAAA, info,
+			     ARRAY_SIZE(info));
+	zassert_equal(ret, -ENOENT, "AAAA query hit A answer (%d)", ret);
+
+	dns_cache_add_negative(query, DNS_QUERY_TYPE_A);
+
+	ret = dns_cache_find(query, DNS_QUERY_TYPE_A, info, ARRAY_SIZE(info));
+	zassert_equal(ret, 0, "Negative answer was not cached (%d)", ret);
+
+	dns_cache_get_stats(&hits, &misses);
+	zassert_equal(hits, 2, "Wrong hit count %u", hits);
+	zassert_equal(misses, 2, "Wrong miss count %u", misses);
+
+	dns_cache_flush();
+
+	ret = dns_cache_find(query, DNS_QUERY_TYPE_A, info, ARRAY_SIZE(info));
+	zassert_equal(ret, -ENOENT, "Flushed cache returned %d", ret);
+}
+#else
+static void test_dns_cache(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 static void test_dns_id_len(void)
 {
 	struct dns_msg_t dns_msg = { 0 };
@@ -1246,7 +1294,8 @@ void test_main(void)
 			 ztest_unit_test(test_dns_id_len),
 			 ztest_unit_test(test_dns_flags_len),
 			 ztest_unit_test(test_dns_malformed_responses),
-			 ztest_unit_test(test_dns_valid_responses)
+			 ztest_unit_test(test_dns_valid_responses),
+			 ztest_unit_test(test_dns_cache)
 		);
 
 	ztest_run_test_suite(dns_tests);
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <net/lwm2m.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+
+/* Resource handles on the Sensor Value of an IPSO temperature object */
+
+#define TEMP_OBJ_ID	3303
+#define TEMP_INST_PATH	"3303/0"
+#define TEMP_VALUE_PATH	"3303/0/5700"
+
+static void setup(void)
+{
+	zassert_equal(lwm2m_engine_create_obj_inst(TEMP_INST_PATH), 0,
+		      "Cannot create the temperature object instance");
+}
+
+static void teardown(void)
+{
+	(void)lwm2m_delete_obj_inst(TEMP_OBJ_ID, 0);
+}
+
+static void test_resolve(void)
+{
+	struct lwm2m_res_handle handle;
+
+	zassert_equal(lwm2m_engine_resolve_path(TEMP_VALUE_PATH, &handle), 0,
+		      "Cannot resolve an existing resource");
+
+	zassert_equal(lwm2m_engine_resolve_path(TEMP_INST_PATH, &handle),
+		      -EINVAL, "Resolved an object instance path");
+	zassert_equal(lwm2m_engine_resolve_path("3303/1/5700", &handle),
+		      -ENOENT, "Resolved a missing object instance");
+	zassert_equal(lwm2m_engine_resolve_path("3303/0/9999", &handle),
+		      -ENOENT, "Resolved a missing resource");
+	zassert_equal(lwm2m_engine_resolve_path("3303/0/5700/1", &handle),
+		      -ENOENT, "Resolved a missing resource instance");
+}
+
+static void test_read_write(void)
+{
+	struct lwm2m_res_handle handle;
+	float32_value_t in = { 21, 250000 };
+	float32_value_t out = { 0 };
+
+	zassert_equal(lwm2m_engine_resolve_path(TEMP_VALUE_PATH, &handle), 0,
+		      "Cannot resolve the temperature value");
+
+	/* what is written through the handle is read through the path */
+	zassert_equal(lwm2m_engine_set_by_handle(&handle, &in, sizeof(in)), 0,
+		      "Cannot write through the handle");
+	zassert_equal(lwm2m_engine_get_float32(TEMP_VALUE_PATH, &out), 0,
+		      "Cannot read through the path");
+	zassert_equal(out.val1, in.val1, "Wrong value read");
+	zassert_equal(out.val2, in.val2, "Wrong value read");
+
+	/* and the other way around */
+	in.val1 = -5;
+	in.val2 = 500000;
+	zassert_equal(lwm2m_engine_set_float32(TEMP_VALUE_PATH, &in), 0,
+		      "Cannot write through the path");
+	zassert_equal(lwm2m_engine_get_by_handle(&handle, &out, sizeof(out)),
+		      0, "Cannot read through the handle");
+	zassert_equal(out.val1, in.val1, "Wrong value read");
+	zassert_equal(out.val2, in.val2, "Wrong value read");
+
+	zassert_equal(lwm2m_engine_set_by_handle(NULL, &in, sizeof(in)),
+		      -EINVAL, "Wrote through no handle");
+}
+
+static void test_use_after_delete(void)
+{
+	struct lwm2m_res_handle handle;
+	float32_value_t value = { 30, 0 };
+
+	zassert_equal(lwm2m_engine_resolve_path(TEMP_VALUE_PATH, &handle), 0,
+		      "Cannot resolve the temperature value");
+
+	zassert_equal(lwm2m_delete_obj_inst(TEMP_OBJ_ID, 0), 0,
+		      "Cannot delete the temperature object instance");
+
+	zassert_equal(lwm2m_engine_set_by_handle(&handle, &value,
+						 sizeof(value)),
+		      -ENOENT, "Wrote through a handle on a deleted instance");
+	zassert_equal(lwm2m_engine_get_by_handle(&handle, &value,
+						 sizeof(value)),
+		      -ENOENT, "Read through a handle on a deleted instance");
+
+	/* the new instance takes the memory of the old one */
+	setup();
+
+	zassert_equal(lwm2m_engine_set_by_handle(&handle, &value,
+						 sizeof(value)),
+		      -ENOENT, "Wrote through a handle on a new instance");
+
+	zassert_equal(lwm2m_engine_resolve_path(TEMP_VALUE_PATH, &handle), 0,
+		      "Cannot resolve the recreated temperature value");
+	zassert_equal(lwm2m_engine_set_by_handle(&handle, &value,
+						 sizeof(value)), 0,
+		      "Cannot write through the resolved handle");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_engine_handle,
+			 ztest_unit_test_setup_teardown(test_resolve,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_read_write,
+							setup, teardown),
+			 ztest_unit_test_setup_teardown(test_use_after_delete,
+							setup, teardown)
+		);
+
+	ztest_run_test_suite(lwm2m_engine_handle);
+}
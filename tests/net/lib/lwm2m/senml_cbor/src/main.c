@@ -0,0 +1,488 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <init.h>
+#include <string.h>
+#include <ztest.h>
+#include <net/coap.h>
+
+#include "lwm2m_object.h"
+#include "lwm2m_engine.h"
+#include "lwm2m_rw_oma_tlv.h"
+#include "lwm2m_rw_senml_cbor.h"
+
+/* Decoding of SenML CBOR write payloads into the resources of a test
+ * object, one resource per data type.
+ */
+
+#define TEST_OBJ_ID		32769
+#define NUMBER_OF_OBJ_FIELDS	9
+
+#define S32_RID			0
+#define S64_RID			1
+#define U16_RID			2
+#define STRING_RID		3
+#define BOOL_RID		4
+#define FLOAT32_RID		5
+#define FLOAT64_RID		6
+#define OPAQUE_RID		7
+#define OBJLNK_RID		8
+
+#define STRING_MAX_SIZE		16
+#define OPAQUE_SIZE		8
+
+#define DECODES			100
+
+/* record items: the base name "/32769/0/" and the name of a resource */
+#define BASE_NAME	0x21, 0x69, '/', '3', '2', '7', '6', '9', '/', '0', '/'
+#define NAME(rid)	0x00, 0x61, '0' + (rid)
+
+/* as deep as the decoder goes, arrays of arrays around an integer */
+#define NESTED		0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81
+
+/* resource state variables */
+static int32_t s32_value;
+static int64_t s64_value;
+static uint16_t u16_value;
+static char string_value[STRING_MAX_SIZE];
+static bool bool_value;
+static float32_value_t float32_value;
+static float64_value_t float64_value;
+static uint8_t opaque_value[OPAQUE_SIZE];
+static struct lwm2m_objlnk objlnk_value;
+
+static const uint8_t opaque[OPAQUE_SIZE] = {
+	0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff, 0x55, 0xaa
+};
+
+static struct lwm2m_engine_obj test_obj;
+static struct lwm2m_engine_obj_field fields[] = {
+	OBJ_FIELD_DATA(S32_RID, RW, S32),
+	OBJ_FIELD_DATA(S64_RID, RW, S64),
+	OBJ_FIELD_DATA(U16_RID, RW, U16),
+	OBJ_FIELD_DATA(STRING_RID, RW, STRING),
+	OBJ_FIELD_DATA(BOOL_RID, RW, BOOL),
+	OBJ_FIELD_DATA(FLOAT32_RID, RW, FLOAT32),
+	OBJ_FIELD_DATA(FLOAT64_RID, RW, FLOAT64),
+	OBJ_FIELD_DATA(OPAQUE_RID, RW, OPAQUE),
+	OBJ_FIELD_DATA(OBJLNK_RID, RW, OBJLNK),
+};
+
+static struct lwm2m_engine_obj_inst inst;
+static struct lwm2m_engine_res res[NUMBER_OF_OBJ_FIELDS];
+static struct lwm2m_engine_res_inst res_inst[NUMBER_OF_OBJ_FIELDS];
+
+struct content_format {
+	const char *name;
+	uint16_t format;
+	const struct lwm2m_writer *writer;
+	const struct lwm2m_reader *reader;
+	int (*read_op)(struct lwm2m_message *msg, int content_format);
+	int (*write_op)(struct lwm2m_message *msg);
+};
+
+static const struct content_format senml_cbor = {
+	"senml-cbor", LWM2M_FORMAT_APP_SENML_CBOR,
+	&senml_cbor_writer, &senml_cbor_reader,
+	do_read_op_senml_cbor, do_write_op_senml_cbor,
+};
+
+static const struct content_format oma_tlv = {
+	"tlv", LWM2M_FORMAT_OMA_TLV,
+	&oma_tlv_writer, &oma_tlv_reader,
+	do_read_op_tlv, do_write_op_tlv,
+};
+
+static struct lwm2m_message msg;
+static struct coap_packet in_cpkt;
+static uint8_t msg_data[256];
+
+static struct lwm2m_engine_obj_inst *test_obj_create(uint16_t obj_inst_id)
+{
+	int i = 0, j = 0;
+
+	(void)memset(res, 0, sizeof(res));
+	init_res_instance(res_inst, ARRAY_SIZE(res_inst));
+
+	INIT_OBJ_RES_DATA(S32_RID, res, i, res_inst, j,
+			  &s32_value, sizeof(s32_value));
+	INIT_OBJ_RES_DATA(S64_RID, res, i, res_inst, j,
+			  &s64_value, sizeof(s64_value));
+	INIT_OBJ_RES_DATA(U16_RID, res, i, res_inst, j,
+			  &u16_value, sizeof(u16_value));
+	INIT_OBJ_RES_DATA(STRING_RID, res, i, res_inst, j,
+			  string_value, sizeof(string_value));
+	INIT_OBJ_RES_DATA(BOOL_RID, res, i, res_inst, j,
+			  &bool_value, sizeof(bool_value));
+	INIT_OBJ_RES_DATA(FLOAT32_RID, res, i, res_inst, j,
+			  &float32_value, sizeof(float32_value));
+	INIT_OBJ_RES_DATA(FLOAT64_RID, res, i, res_inst, j,
+			  &float64_value, sizeof(float64_value));
+	INIT_OBJ_RES_DATA(OPAQUE_RID, res, i, res_inst, j,
+			  opaque_value, sizeof(opaque_value));
+	INIT_OBJ_RES_DATA(OBJLNK_RID, res, i, res_inst, j,
+			  &objlnk_value, sizeof(objlnk_value));
+
+	inst.resources = res;
+	inst.resource_count = i;
+	return &inst;
+}
+
+static void clear_values(void)
+{
+	s32_value = 0;
+	s64_value = 0;
+	u16_value = 0U;
+	(void)memset(string_value, 0, sizeof(string_value));
+	bool_value = false;
+	(void)memset(&float32_value, 0, sizeof(float32_value));
+	(void)memset(&float64_value, 0, sizeof(float64_value));
+	(void)memset(opaque_value, 0, sizeof(opaque_value));
+	(void)memset(&objlnk_value, 0, sizeof(objlnk_value));
+}
+
+/* Returns the payload length of a read of the test object instance */
+static int read_format(const struct content_format *fmt,
+		       uint8_t *buf, size_t size, uint8_t **payload)
+{
+	uint16_t start;
+	int ret;
+
+	(void)memset(&msg, 0, sizeof(msg));
+
+	ret = coap_packet_init(&msg.cpkt, buf, size, 1, COAP_TYPE_ACK, 0,
+			       NULL, COAP_RESPONSE_CODE_CONTENT, 0);
+	if (ret < 0) {
+		return ret;
+	}
+
+	msg.out.out_cpkt = &msg.cpkt;
+	msg.out.writer = fmt->writer;
+	msg.path.obj_id = TEST_OBJ_ID;
+	msg.path.obj_inst_id = 0U;
+	msg.path.level = 2U;
+
+	ret = fmt->read_op(&msg, fmt->format);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* the payload marker is not part of opt_len */
+	start = msg.cpkt.hdr_len + msg.cpkt.opt_len + 1;
+	*payload = msg.cpkt.data + start;
+	return msg.cpkt.offset - start;
+}
+
+/* Writes a payload to the test object instance */
+static int write_format(const struct content_format *fmt,
+			const uint8_t *doc, size_t len)
+{
+	(void)memset(&msg, 0, sizeof(msg));
+	(void)memset(&in_cpkt, 0, sizeof(in_cpkt));
+
+	in_cpkt.data = (uint8_t *)doc;
+	in_cpkt.offset = len;
+	in_cpkt.max_len = len;
+
+	msg.in.in_cpkt = &in_cpkt;
+	msg.in.offset = 0U;
+	msg.in.reader = fmt->reader;
+	msg.path.obj_id = TEST_OBJ_ID;
+	msg.path.obj_inst_id = 0U;
+	msg.path.level = 2U;
+
+	return fmt->write_op(&msg);
+}
+
+static int read_instance(uint8_t *buf, size_t size, uint8_t **payload)
+{
+	return read_format(&senml_cbor, buf, size, payload);
+}
+
+static int write_instance(const uint8_t *doc, size_t len)
+{
+	return write_format(&senml_cbor, doc, len);
+}
+
+static void set_values(void)
+{
+	s32_value = INT32_MIN;
+	s64_value = INT64_MIN;
+	u16_value = UINT16_MAX;
+	strcpy(string_value, "zephyr");
+	bool_value = true;
+	/* 1.25 and -2.5 are exact in binary */
+	float32_value.val1 = 1;
+	float32_value.val2 = 250000;
+	float64_value.val1 = -2;
+	float64_value.val2 = 500000000;
+	memcpy(opaque_value, opaque, sizeof(opaque_value));
+	objlnk_value.obj_id = 3U;
+	objlnk_value.obj_inst = UINT16_MAX;
+}
+
+static void check_values(void)
+{
+	zassert_equal(s32_value, INT32_MIN, NULL);
+	zassert_equal(s64_value, INT64_MIN, NULL);
+	zassert_equal(u16_value, UINT16_MAX, NULL);
+	zassert_true(!strcmp(string_value, "zephyr"), NULL);
+	zassert_true(bool_value, NULL);
+	zassert_equal(float32_value.val1, 1, NULL);
+	zassert_equal(float32_value.val2, 250000, NULL);
+	zassert_equal(float64_value.val1, -2, NULL);
+	zassert_equal(float64_value.val2, 500000000, NULL);
+	zassert_mem_equal(opaque_value, opaque, sizeof(opaque), NULL);
+	zassert_equal(objlnk_value.obj_id, 3U, NULL);
+	zassert_equal(objlnk_value.obj_inst, UINT16_MAX, NULL);
+}
+
+/* Every value type read by the writer is decoded back as it was */
+static void test_round_trip(void)
+{
+	uint8_t *payload;
+	int len;
+
+	set_values();
+
+	len = read_instance(msg_data, sizeof(msg_data), &payload);
+	zassert_true(len > 0, "read failed %d", len);
+
+	clear_values();
+	zassert_equal(write_instance(payload, len), 0, NULL);
+
+	check_values();
+}
+
+/* Decoding cost of the same instance written in SenML CBOR and in OMA
+ * TLV, the format writes were decoded from so far. The cycles depend on
+ * the target, so they are only reported.
+ */
+static uint32_t decode_cycles(const struct content_format *fmt)
+{
+	uint32_t start, cycles;
+	uint8_t *payload;
+	int i, len;
+
+	set_values();
+
+	len = read_format(fmt, msg_data, sizeof(msg_data), &payload);
+	zassert_true(len > 0, "%s: read failed %d", fmt->name, len);
+
+	clear_values();
+	start = k_cycle_get_32();
+	for (i = 0; i < DECODES; i++) {
+		zassert_equal(write_format(fmt, payload, len), 0,
+			      "%s: write failed", fmt->name);
+	}
+	cycles = (k_cycle_get_32() - start) / DECODES;
+
+	check_values();
+
+	TC_PRINT("format %-10s bytes %4d decode cycles %8u\n",
+		 fmt->name, len, cycles);
+
+	return cycles;
+}
+
+static void test_decode_cost(void)
+{
+	uint32_t cbor, tlv;
+
+	cbor = decode_cycles(&senml_cbor);
+	tlv = decode_cycles(&oma_tlv);
+
+	TC_PRINT("senml-cbor decode cost %u%% of tlv\n",
+		 tlv ? (uint32_t)(100ULL * cbor / tlv) : 0U);
+}
+
+/* A read larger than the message fails instead of being cut short */
+static void test_read_overflow(void)
+{
+	uint8_t buf[32];
+	uint8_t *payload;
+
+	zassert_equal(read_instance(buf, sizeof(buf), &payload), -ENOMEM,
+		      NULL);
+}
+
+/* Definite length pack and records, the unit of the second record is a
+ * nested indefinite array to skip, its value a half precision float.
+ */
+static const uint8_t definite_doc[] = {
+	0x82,
+	0xa3, BASE_NAME, NAME(STRING_RID), 0x03, 0x62, 'o', 'k',
+	0xa3, NAME(FLOAT64_RID),
+	0x01, 0x9f, 0x01, 0xa1, 0x01, 0x02, 0xff,
+	0x02, 0xf9, 0x3e, 0x00,
+};
+
+/* Indefinite length pack and records, the unit of the second record is
+ * a definite array of empty containers to skip.
+ */
+static const uint8_t indefinite_doc[] = {
+	0x9f,
+	0xbf, BASE_NAME, NAME(STRING_RID), 0x03, 0x63, 'a', 'b', 'c', 0xff,
+	0xbf, NAME(S32_RID), 0x01, 0x82, 0xa0, 0x80, 0x02, 0x38, 0x63, 0xff,
+	0xff,
+};
+
+static void test_definite_containers(void)
+{
+	clear_values();
+	zassert_equal(write_instance(definite_doc, sizeof(definite_doc)), 0,
+		      NULL);
+
+	zassert_true(!strcmp(string_value, "ok"), NULL);
+	zassert_equal(float64_value.val1, 1, NULL);
+	zassert_equal(float64_value.val2, 500000000, NULL);
+}
+
+static void test_indefinite_containers(void)
+{
+	clear_values();
+	zassert_equal(write_instance(indefinite_doc, sizeof(indefinite_doc)),
+		      0, NULL);
+
+	zassert_true(!strcmp(string_value, "abc"), NULL);
+	zassert_equal(s32_value, -100, NULL);
+}
+
+static void test_max_depth(void)
+{
+	static const uint8_t max_depth[] = {
+		0x81, 0xa4, BASE_NAME, NAME(STRING_RID),
+		0x01, NESTED, 0x00,
+		0x03, 0x62, 'o', 'k',
+	};
+	static const uint8_t excess_depth[] = {
+		0x81, 0xa4, BASE_NAME, NAME(STRING_RID),
+		0x01, NESTED, 0x81, 0x00,
+		0x03, 0x62, 'o', 'k',
+	};
+
+	clear_values();
+	zassert_equal(write_instance(max_depth, sizeof(max_depth)), 0, NULL);
+	zassert_true(!strcmp(string_value, "ok"), NULL);
+
+	zassert_true(write_instance(excess_depth, sizeof(excess_depth)) < 0,
+		     NULL);
+}
+
+struct malformed_doc {
+	const char *name;
+	const uint8_t *data;
+	size_t len;
+};
+
+#define MALFORMED_DOC(_name, ...)				\
+	{							\
+		.name = _name,					\
+		.data = (const uint8_t []){ __VA_ARGS__ },	\
+		.len = sizeof((const uint8_t []){ __VA_ARGS__ }),	\
+	}
+
+static const struct malformed_doc malformed_docs[] = {
+	MALFORMED_DOC("reserved record AI",
+		      0x81, 0xbc, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("reserved value AI",
+		      0x81, 0xa3, BASE_NAME, NAME(S32_RID), 0x02, 0x1c),
+	MALFORMED_DOC("pack is not an array",
+		      0xa3, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("record is not a map",
+		      0x81, 0x83, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("missing pack break",
+		      0x9f, 0xa3, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("missing record break",
+		      0x81, 0xbf, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("missing nested break",
+		      0x81, 0xa4, BASE_NAME, NAME(STRING_RID),
+		      0x01, 0x9f, 0x01, 0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("oversized name",
+		      0x81, 0xa3, BASE_NAME, 0x00, 0x7a, 0x00, 0x01, 0x00, 0x00,
+		      0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("oversized label",
+		      0x81, 0xa4, BASE_NAME, NAME(STRING_RID),
+		      0x7a, 0x00, 0x01, 0x00, 0x00, 0x03, 0x62, 'o', 'k'),
+	MALFORMED_DOC("string past the end",
+		      0x81, 0xa3, BASE_NAME, NAME(STRING_RID),
+		      0x03, 0x78, 0x40, 'o', 'k'),
+	MALFORMED_DOC("name is not a resource",
+		      0x81, 0xa2, 0x00, 0x61, '3', 0x03, 0x62, 'o', 'k'),
+};
+
+static void test_malformed(void)
+{
+	int i, ret;
+
+	for (i = 0; i < ARRAY_SIZE(malformed_docs); i++) {
+		ret = write_instance(malformed_docs[i].data,
+				     malformed_docs[i].len);
+		zassert_true(ret < 0, "%s: accepted", malformed_docs[i].name);
+	}
+}
+
+/* Every prefix of a valid pack is rejected */
+static void test_truncated(void)
+{
+	uint8_t *payload;
+	int i, len;
+
+	for (i = 0; i < sizeof(definite_doc); i++) {
+		zassert_true(write_instance(definite_doc, i) < 0,
+			     "definite pack accepted at %d bytes", i);
+	}
+
+	for (i = 0; i < sizeof(indefinite_doc); i++) {
+		zassert_true(write_instance(indefinite_doc, i) < 0,
+			     "indefinite pack accepted at %d bytes", i);
+	}
+
+	len = read_instance(msg_data, sizeof(msg_data), &payload);
+	zassert_true(len > 0, "read failed %d", len);
+
+	for (i = 0; i < len; i++) {
+		zassert_true(write_instance(payload, i) < 0,
+			     "read pack accepted at %d bytes", i);
+	}
+}
+
+static int test_obj_init(const struct device *dev)
+{
+	struct lwm2m_engine_obj_inst *obj_inst = NULL;
+
+	test_obj.obj_id = TEST_OBJ_ID;
+	test_obj.fields = fields;
+	test_obj.field_count = ARRAY_SIZE(fields);
+	test_obj.max_instance_count = 1U;
+	test_obj.create_cb = test_obj_create;
+	lwm2m_register_obj(&test_obj);
+
+	/* auto create the only instance */
+	return lwm2m_create_obj_inst(TEST_OBJ_ID, 0, &obj_inst);
+}
+
+SYS_INIT(test_obj_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+void test_main(void)
+{
+	ztest_test_suite(lwm2m_senml_cbor,
+			 ztest_unit_test(test_round_trip),
+			 ztest_unit_test(test_decode_cost),
+			 ztest_unit_test(test_read_overflow),
+			 ztest_unit_test(test_definite_containers),
+			 ztest_unit_test(test_indefinite_containers),
+			 ztest_unit_test(test_max_depth),
+			 ztest_unit_test(test_malformed),
+			 ztest_unit_test(test_truncated)
+		);
+
+	ztest_run_test_suite(lwm2m_senml_cbor);
+}
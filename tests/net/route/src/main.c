@@ -473,6 +473,53 @@ static void test_route_del_many(void)
 	}
 }
 
+static void test_route_lookup_longest_prefix(void)
+{
+	/* 2001:db8::/64 and 2001:db8::/48, host bits set so that the
+	 * /128 route to dest_addr does not match them when adding.
+	 */
+	struct in6_addr prefix64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x64 } } };
+	struct in6_addr prefix48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1,
+					 0, 0, 0, 0, 0, 0, 0, 0x48 } } };
+	struct in6_addr in64 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				     0, 0, 0, 0, 0, 0, 0, 0x5 } } };
+	struct in6_addr in48 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0xff, 0xff,
+				     0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr outside = { { { 0x20, 0x01, 0x0d, 0xb9, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct net_route_entry *r128, *r64, *r48;
+
+	r128 = net_route_add(my_iface, &dest_addr, 128, &peer_addr);
+	r64 = net_route_add(my_iface, &prefix64, 64, &peer_addr);
+	r48 = net_route_add(my_iface, &prefix48, 48, &peer_addr);
+	zassert_not_null(r128, "Route add failed");
+	zassert_not_null(r64, "Route add failed");
+	zassert_not_null(r48, "Route add failed");
+
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), r128,
+			  "/128 route not found");
+	zassert_equal_ptr(net_route_lookup(NULL, &in64), r64,
+			  "/64 route not found");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in48), r48,
+			  "/48 route not found");
+	zassert_is_null(net_route_lookup(my_iface, &outside),
+			"Route found for unrouted address");
+	zassert_is_null(net_route_lookup(peer_iface, &in64),
+			"Route found on wrong interface");
+
+	zassert_false(net_route_del(r64), "Route del failed");
+	zassert_equal_ptr(net_route_lookup(my_iface, &in64), r48,
+			  "Shorter prefix not found after del");
+	zassert_equal_ptr(net_route_lookup(my_iface, &dest_addr), r128,
+			  "/128 route lost after del");
+
+	zassert_false(net_route_del(r128), "Route del failed");
+	zassert_false(net_route_del(r48), "Route del failed");
+	zassert_is_null(net_route_lookup(my_iface, &dest_addr),
+			"Route found after all were deleted");
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -492,6 +539,7 @@ void test_main(void)
 			ztest_unit_test(test_route_del_nexthop_again),
 			ztest_unit_test(test_populate_nbr_cache),
 			ztest_unit_test(test_route_add_many),
-			ztest_unit_test(test_route_del_many));
+			ztest_unit_test(test_route_del_many),
+			ztest_unit_test(test_route_lookup_longest_prefix));
 	ztest_run_test_suite(test_route);
 }
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+
+#include "ipv4.h"
+#include "udp_internal.h"
+#include "net_private.h"
+
+#define FLOW_COUNT 64
+#define PKTS_PER_FLOW 8
+#define CLIENT_PORT 5000
+#define SERVER_PORT 4000
+
+static struct in_addr client_addr = { { { 192, 0, 2, 2 } } };
+static struct in_addr server_addr = { { { 192, 0, 2, 1 } } };
+
+static K_SEM_DEFINE(handled, 0, 1);
+static k_tid_t handler_thread;
+
+/* Runs in the RX thread the packet was steered to */
+static void flow_handler(struct k_work *work)
+{
+	struct net_pkt *pkt = CONTAINER_OF(work, struct net_pkt, work);
+
+	handler_thread = k_current_get();
+	net_pkt_unref(pkt);
+
+	k_sem_give(&handled);
+}
+
+/* Pass a UDP packet of the flow from client_port to the RX queues and
+ * return the thread that handled it.
+ */
+static k_tid_t steer_packet(uint16_t client_port)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(net_if_get_default(),
+					sizeof(struct net_udp_hdr), AF_INET,
+					IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Failed to allocate packet");
+
+	ret = net_ipv4_create(pkt, &client_addr, &server_addr);
+	zassert_equal(ret, 0, "Failed to create IPv4 header (%d)", ret);
+
+	ret = net_udp_create(pkt, htons(client_port), htons(SERVER_PORT));
+	zassert_equal(ret, 0, "Failed to create UDP header (%d)", ret);
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv4_finalize(pkt, IPPROTO_UDP);
+	zassert_equal(ret, 0, "Failed to finalize packet (%d)", ret);
+
+	k_work_init(net_pkt_work(pkt), flow_handler);
+	net_tc_submit_to_rx_queue(0, pkt);
+
+	ret = k_sem_take(&handled, K_MSEC(100));
+	zassert_equal(ret, 0, "Packet not handled");
+
+	return handler_thread;
+}
+
+static void test_same_flow_same_queue(void)
+{
+	k_tid_t thread;
+
+	for (int flow = 0; flow < FLOW_COUNT; flow++) {
+		thread = steer_packet(CLIENT_PORT + flow);
+
+		for (int i = 1; i < PKTS_PER_FLOW; i++) {
+			zassert_equal(steer_packet(CLIENT_PORT + flow), thread,
+				      "Flow %d changed RX thread", flow);
+		}
+	}
+}
+
+static void test_flows_spread(void)
+{
+	k_tid_t threads[CONFIG_NET_TC_RX_FLOW_QUEUES];
+	int flows[CONFIG_NET_TC_RX_FLOW_QUEUES] = { 0 };
+	int count = 0;
+	k_tid_t thread;
+	int i;
+
+	for (int flow = 0; flow < FLOW_COUNT; flow++) {
+		thread = steer_packet(CLIENT_PORT + flow);
+
+		for (i = 0; i < count; i++) {
+			if (threads[i] == thread) {
+				break;
+			}
+		}
+
+		if (i == count) {
+			zassert_true(count < ARRAY_SIZE(threads),
+				     "More RX threads than queues");
+			threads[count++] = thread;
+		}
+
+		flows[i]++;
+	}
+
+	zassert_equal(count, CONFIG_NET_TC_RX_FLOW_QUEUES,
+		      "%d flows used only %d RX threads", FLOW_COUNT, count);
+
+	/* No queue gets more than twice its fair share */
+	for (i = 0; i < count; i++) {
+		TC_PRINT("RX thread %d: %d flows\n", i, flows[i]);
+		zassert_true(flows[i] <= 2 * FLOW_COUNT / count,
+			     "RX thread %d got %d flows", i, flows[i]);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(rx_flow_steering,
+			 ztest_unit_test(test_same_flow_same_queue),
+			 ztest_unit_test(test_flows_spread));
+
+	ztest_run_test_suite(rx_flow_steering);
+}
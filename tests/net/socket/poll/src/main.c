@@ -175,10 +175,99 @@ void test_poll(void)
 	zassert_equal(res, 0, "close failed");
 }
 
+/* Exercised with CONFIG_NET_SOCKETS_POLL_SET too, where the sockets stay
+ * registered between calls and a call on other sockets drops them.
+ */
+void test_poll_two_sockets(void)
+{
+	int res;
+	int c_sock;
+	int s_sock[2];
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr[2];
+	struct pollfd pollfds[2];
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &c_sock, &c_addr);
+
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR,
+				    SERVER_PORT + 1 + i, &s_sock[i], &s_addr[i]);
+		res = bind(s_sock[i], (struct sockaddr *)&s_addr[i],
+			   sizeof(s_addr[i]));
+		zassert_equal(res, 0, "bind failed");
+
+		pollfds[i].fd = s_sock[i];
+		pollfds[i].events = POLLIN;
+	}
+
+	res = poll(pollfds, ARRAY_SIZE(pollfds), 0);
+	zassert_equal(res, 0, "");
+
+	/* Both become ready between two calls */
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		res = sendto(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			     (struct sockaddr *)&s_addr[i], sizeof(s_addr[i]));
+		zassert_equal(res, STRLEN(TEST_STR_SMALL), "sendto failed");
+	}
+
+	k_msleep(10);
+
+	res = poll(pollfds, ARRAY_SIZE(pollfds), 0);
+	zassert_equal(res, 2, "");
+	zassert_equal(pollfds[0].revents, POLLIN, "");
+	zassert_equal(pollfds[1].revents, POLLIN, "");
+
+	res = recv(s_sock[0], BUF_AND_SIZE(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = poll(pollfds, ARRAY_SIZE(pollfds), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(pollfds[0].revents, 0, "");
+	zassert_equal(pollfds[1].revents, POLLIN, "");
+
+	res = recv(s_sock[1], BUF_AND_SIZE(buf), 0);
+	zassert_equal(res, STRLEN(TEST_STR_SMALL), "");
+
+	res = poll(pollfds, ARRAY_SIZE(pollfds), 0);
+	zassert_equal(res, 0, "");
+
+	/* Both become ready while only one of them is polled */
+	res = poll(pollfds, 1, 0);
+	zassert_equal(res, 0, "");
+
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		res = sendto(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			     (struct sockaddr *)&s_addr[i], sizeof(s_addr[i]));
+		zassert_equal(res, STRLEN(TEST_STR_SMALL), "sendto failed");
+	}
+
+	res = poll(pollfds, 1, 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(pollfds[0].revents, POLLIN, "");
+
+	k_msleep(10);
+
+	res = poll(pollfds, ARRAY_SIZE(pollfds), 0);
+	zassert_equal(res, 2, "");
+	zassert_equal(pollfds[0].revents, POLLIN, "");
+	zassert_equal(pollfds[1].revents, POLLIN, "");
+
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	for (int i = 0; i < ARRAY_SIZE(s_sock); i++) {
+		res = close(s_sock[i]);
+		zassert_equal(res, 0, "close failed");
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_poll,
-			 ztest_unit_test(test_poll));
+			 ztest_unit_test(test_poll),
+			 ztest_unit_test(test_poll_two_sockets));
 
 	ztest_run_test_suite(socket_poll);
 }
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 #include <fcntl.h>
 #include <net/socket.h>
+#include <net/loopback.h>
 
 #include "../../socket_helpers.h"
 
@@ -513,6 +514,104 @@ void test_v4_accept_timeout(void)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+#define LOSSY_DATA_LEN (32 * 1024)
+#define LOSSY_CHUNK_LEN 512
+#define LOSSY_DROP_RATIO 0.05f
+#define LOSSY_STACK_SZ (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+
+static struct k_thread lossy_sender_thread;
+K_THREAD_STACK_DEFINE(lossy_sender_stack, LOSSY_STACK_SZ);
+
+static void lossy_sender(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	uint8_t buf[LOSSY_CHUNK_LEN];
+
+	for (size_t off = 0; off < LOSSY_DATA_LEN; off += sizeof(buf)) {
+		for (size_t i = 0; i < sizeof(buf); i++) {
+			buf[i] = (uint8_t)(off + i);
+		}
+
+		test_send(sock, buf, sizeof(buf), 0);
+	}
+}
+#endif
+
+void test_v4_send_recv_lossy(void)
+{
+	/* Test that a bulk transfer over a link losing packets completes
+	 * with the data intact, and report how long it took.
+	 */
+#if defined(CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DROP)
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	uint8_t rx_buf[LOSSY_CHUNK_LEN];
+	size_t total = 0;
+	uint32_t start, elapsed;
+	ssize_t recved;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	zassert_equal(loopback_set_packet_drop_ratio(LOSSY_DROP_RATIO), 0,
+		      "cannot set drop ratio");
+
+	start = k_uptime_get_32();
+
+	k_thread_create(&lossy_sender_thread, lossy_sender_stack,
+			K_THREAD_STACK_SIZEOF(lossy_sender_stack),
+			lossy_sender, INT_TO_POINTER(c_sock), NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	while (total < LOSSY_DATA_LEN) {
+		recved = recv(new_sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_true(recved > 0, "recv failed (%d)", errno);
+
+		for (size_t i = 0; i < recved; i++) {
+			zassert_equal(rx_buf[i], (uint8_t)(total + i),
+				      "corrupted data at %zu", total + i);
+		}
+
+		total += recved;
+	}
+
+	elapsed = k_uptime_get_32() - start;
+
+	k_thread_join(&lossy_sender_thread, K_FOREVER);
+	zassert_equal(loopback_set_packet_drop_ratio(0.0f), 0, "");
+
+	zassert_true(loopback_get_num_dropped_packets() > 0,
+		     "no packets dropped");
+
+	TC_PRINT("%d bytes in %u ms (%u B/s), %d packets dropped\n",
+		 LOSSY_DATA_LEN, elapsed,
+		 (uint32_t)(LOSSY_DATA_LEN * 1000ULL / MAX(elapsed, 1U)),
+		 loopback_get_num_dropped_packets());
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+#else
+	ztest_test_skip();
+#endif
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACKSIZE)
 struct k_thread child_thread;
@@ -599,6 +698,7 @@ void test_main(void)
 		ztest_user_unit_test(test_v6_recv_enotconn),
 		ztest_unit_test(test_open_close_immediately),
 		ztest_user_unit_test(test_v4_accept_timeout),
+		ztest_unit_test(test_v4_send_recv_lossy),
 		ztest_user_unit_test(test_socket_permission)
 		);
 
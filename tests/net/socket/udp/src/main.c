@@ -703,6 +703,317 @@ void test_v6_sendmsg_recvfrom_connected(void)
 	zassert_equal(rv, 0, "close failed");
 }
 
+void test_v4_recvmsg_pktinfo(void)
+{
+	int rv;
+	int on = 1;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	struct msghdr msg;
+	struct cmsghdr *cmsg;
+	struct in_pktinfo *info;
+	struct iovec io_vector[2];
+	char head[2];
+	char tail[8];
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in_pktinfo))];
+	} cmsgbuf;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = setsockopt(server_sock, IPPROTO_IP, IP_PKTINFO, &on, sizeof(on));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	/* The datagram is scattered over both buffers */
+	io_vector[0].iov_base = head;
+	io_vector[0].iov_len = sizeof(head);
+	io_vector[1].iov_base = tail;
+	io_vector[1].iov_len = sizeof(tail);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed (%d)", errno);
+	zassert_mem_equal(head, TEST_STR_SMALL, sizeof(head),
+			  "invalid first buffer");
+	zassert_mem_equal(tail, TEST_STR_SMALL + sizeof(head),
+			  STRLEN(TEST_STR_SMALL) - sizeof(head),
+			  "invalid second buffer");
+	zassert_equal(msg.msg_namelen, sizeof(struct sockaddr_in),
+		      "unexpected address length");
+	zassert_equal(msg.msg_flags, 0, "unexpected flags");
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no control message");
+	zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "invalid level");
+	zassert_equal(cmsg->cmsg_type, IP_PKTINFO, "invalid type");
+
+	info = (struct in_pktinfo *)CMSG_DATA(cmsg);
+	zassert_true(net_ipv4_addr_cmp(&info->ipi_addr,
+				       &server_addr.sin_addr),
+		     "invalid destination address");
+	zassert_true(info->ipi_ifindex > 0, "invalid interface index");
+
+	/* A short buffer truncates the datagram */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg.msg_iovlen = 1;
+	msg.msg_name = NULL;
+	msg.msg_control = NULL;
+	msg.msg_controllen = 0;
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, sizeof(head), "recvmsg failed (%d)", errno);
+	zassert_true(msg.msg_flags & MSG_TRUNC, "MSG_TRUNC not set");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 3
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int i;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec tx_iov[MMSG_COUNT];
+	struct iovec rx_iov[MMSG_COUNT];
+	char rx_buf[MMSG_COUNT][sizeof(TEST_STR_SMALL)];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		/* Each datagram is one byte shorter than the previous */
+		tx_iov[i].iov_base = TEST_STR_SMALL;
+		tx_iov[i].iov_len = STRLEN(TEST_STR_SMALL) - i;
+
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, tx_iov[i].iov_len,
+			      "invalid sent length");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = sizeof(rx_buf[i]);
+
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Wait for the queue to fill up, only the first message blocks */
+	k_msleep(100);
+
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "invalid received length");
+		zassert_mem_equal(rx_buf[i], TEST_STR_SMALL,
+				  msgs[i].msg_len, "invalid data");
+	}
+
+	/* Nothing is left, the non-blocking batch fails */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_recv_zc(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct iovec iov[8];
+	size_t iovcnt;
+	size_t offset = 0;
+	void *handle;
+	size_t i;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR2), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	/* Too few entries leave the datagram queued */
+	iovcnt = 0;
+	rv = zsock_recv_zc(server_sock, iov, &iovcnt, 0, &handle);
+	zassert_equal(rv, -1, "zsock_recv_zc should fail");
+	zassert_equal(errno, EMSGSIZE, "invalid errno");
+	zassert_true(iovcnt > 0, "needed entries not reported");
+	zassert_true(iovcnt <= ARRAY_SIZE(iov), "too many fragments");
+
+	iovcnt = ARRAY_SIZE(iov);
+	rv = zsock_recv_zc(server_sock, iov, &iovcnt, 0, &handle);
+	zassert_equal(rv, STRLEN(TEST_STR2), "zsock_recv_zc failed (%d)",
+		      errno);
+	zassert_not_null(handle, "no handle");
+
+	for (i = 0; i < iovcnt; i++) {
+		zassert_mem_equal(iov[i].iov_base, TEST_STR2 + offset,
+				  iov[i].iov_len, "invalid data");
+		offset += iov[i].iov_len;
+	}
+
+	zassert_equal(offset, STRLEN(TEST_STR2), "invalid fragments");
+
+	zsock_recv_zc_release(handle);
+
+	iovcnt = ARRAY_SIZE(iov);
+	rv = zsock_recv_zc(server_sock, iov, &iovcnt, MSG_DONTWAIT, &handle);
+	zassert_equal(rv, -1, "zsock_recv_zc should fail");
+	zassert_equal(errno, EAGAIN, "invalid errno");
+	zassert_is_null(handle, "unexpected handle");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static K_SEM_DEFINE(zc_tx_done, 0, 1);
+
+static void zc_tx_done_cb(struct net_pkt_ext_done *done)
+{
+	ARG_UNUSED(done);
+
+	k_sem_give(&zc_tx_done);
+}
+
+void test_v4_sendmsg_zc(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct net_pkt_ext_done done;
+	struct msghdr msg;
+	struct iovec io_vector[2];
+	char rx_buf[sizeof(TEST_STR2)];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock,
+		  (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	/* Both halves are referenced by the packet, not copied */
+	io_vector[0].iov_base = TEST_STR2;
+	io_vector[0].iov_len = 100;
+	io_vector[1].iov_base = TEST_STR2 + 100;
+	io_vector[1].iov_len = STRLEN(TEST_STR2) - 100;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_name = &server_addr;
+	msg.msg_namelen = sizeof(server_addr);
+
+	net_pkt_ext_done_init(&done, zc_tx_done_cb);
+
+	rv = zsock_sendmsg_zc(client_sock, &msg, 0, &done);
+	zassert_equal(rv, STRLEN(TEST_STR2), "zsock_sendmsg_zc failed (%d)",
+		      errno);
+
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR2, STRLEN(TEST_STR2),
+			  "invalid data");
+
+	/* Locally delivered, the packet is freed once it has been read */
+	rv = k_sem_take(&zc_tx_done, K_MSEC(500));
+	zassert_equal(rv, 0, "completion not called");
+
+	/* The completion runs even when nothing could be sent */
+	msg.msg_name = NULL;
+	msg.msg_namelen = 0;
+	net_pkt_ext_done_init(&done, zc_tx_done_cb);
+
+	rv = zsock_sendmsg_zc(server_sock, &msg, 0, &done);
+	zassert_equal(rv, -1, "zsock_sendmsg_zc should fail");
+
+	rv = k_sem_take(&zc_tx_done, K_NO_WAIT);
+	zassert_equal(rv, 0, "completion not called");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_so_txtime(void)
 {
 	struct sockaddr_in bind_addr4;
@@ -976,6 +1287,12 @@ void test_main(void)
 			 ztest_user_unit_test(test_v4_sendmsg_recvfrom_connected),
 			 ztest_unit_test(test_v6_sendmsg_recvfrom_connected),
 			 ztest_user_unit_test(test_v6_sendmsg_recvfrom_connected),
+			 ztest_unit_test(test_v4_recvmsg_pktinfo),
+			 ztest_user_unit_test(test_v4_recvmsg_pktinfo),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v4_recv_zc),
+			 ztest_unit_test(test_v4_sendmsg_zc),
 			 ztest_unit_test(test_setup_eth),
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime)
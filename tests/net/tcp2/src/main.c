@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stddef.h>
 #include <string.h>
 #include <sys/printk.h>
+#include <sys/byteorder.h>
 #include <linker/sections.h>
 #include <tc_util.h>
 
@@ -25,6 +26,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv6.h"
 #include "tcp2.h"
 #include "tcp2_priv.h"
+#include "tcp_internal.h"
 #include "net_stats.h"
 
 #include <ztest.h>
@@ -95,6 +97,9 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th);
 static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
+static void handle_ooo_test(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_gro_test(struct tcphdr *th);
+static void handle_window_test(struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -181,6 +186,11 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+static bool syn_with_options(uint8_t flags)
+{
+	return (test_case_no == 4U || test_case_no == 9U) && (flags & SYN);
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port, uint16_t dst_port,
 					      uint8_t flags, uint8_t *data,
@@ -192,7 +202,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (syn_with_options(flags)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -228,7 +238,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (syn_with_options(flags)) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
@@ -247,7 +257,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (syn_with_options(flags)) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -382,6 +392,27 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 8:
 		handle_client_closing_test(net_pkt_family(pkt), &th);
 		break;
+	case 9:
+		if (t_state == T_DATA) {
+			handle_ooo_test(pkt, &th);
+		} else {
+			handle_server_test(net_pkt_family(pkt), &th);
+		}
+		break;
+	case 10:
+		if (t_state == T_DATA) {
+			handle_gro_test(&th);
+		} else {
+			handle_server_test(net_pkt_family(pkt), &th);
+		}
+		break;
+	case 11:
+		if (t_state == T_DATA) {
+			handle_window_test(&th);
+		} else {
+			handle_server_test(net_pkt_family(pkt), &th);
+		}
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -656,7 +687,8 @@ fail:
 
 static void test_server_timeout(struct k_work *work)
 {
-	if (test_case_no == 3 || test_case_no == 4) {
+	if (test_case_no == 3 || test_case_no == 4 || test_case_no == 9 ||
+	    test_case_no == 10 || test_case_no == 11) {
 		handle_server_test(AF_INET, NULL);
 	} else if (test_case_no == 5) {
 		handle_server_test(AF_INET6, NULL);
@@ -665,6 +697,8 @@ static void test_server_timeout(struct k_work *work)
 	}
 }
 
+static struct net_context *accepted_ctx;
+
 static void test_tcp_recv_cb(struct net_context *context,
 			     struct net_pkt *pkt,
 			     union net_ip_header *ip_hdr,
@@ -689,6 +723,7 @@ static void test_tcp_accept_cb(struct net_context *ctx,
 
 	/* set callback on newly created context */
 	ctx->recv_cb = test_tcp_recv_cb;
+	accepted_ctx = ctx;
 
 	test_sem_give();
 }
@@ -1294,6 +1329,658 @@ static void test_client_invalid_rst(void)
 	check_rst_succeed(NULL, 1);
 }
 
+#define OOO_SEG_LEN 100U
+
+static uint8_t ooo_data[4 * OOO_SEG_LEN];
+static uint32_t ooo_seq_start;
+static uint32_t ooo_ack;
+static uint32_t ooo_sack[TCP_SACK_BLOCKS_MAX][2];
+static int ooo_sack_blocks;
+static size_t ooo_received;
+
+/* Record the ACK number and SACK blocks of every segment sent to the peer */
+static void handle_ooo_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t options[TCP_OPTIONS_MAX_LEN];
+	int len = (th->th_off - 5) * 4;
+
+	ooo_ack = ntohl(th->th_ack);
+	ooo_sack_blocks = 0;
+
+	net_pkt_set_overwrite(pkt, true);
+
+	if (len > 0 &&
+	    net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + sizeof(*th)) == 0 &&
+	    net_pkt_read(pkt, options, len) == 0) {
+		for (int i = 0; i < len; ) {
+			if (options[i] == TCPOPT_NOP) {
+				i++;
+				continue;
+			}
+
+			if (options[i] == TCPOPT_END || i + 1 >= len) {
+				break;
+			}
+
+			if (options[i] == TCPOPT_SACK) {
+				ooo_sack_blocks = (options[i + 1] - 2) / 8;
+
+				for (int b = 0; b < ooo_sack_blocks; b++) {
+					uint8_t *p = &options[i + 2 + b * 8];
+
+					ooo_sack[b][0] = sys_get_be32(p);
+					ooo_sack[b][1] = sys_get_be32(p + 4);
+				}
+			}
+
+			i += options[i + 1];
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	test_sem_give();
+}
+
+static void test_ooo_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	if (pkt) {
+		ooo_received += net_pkt_remaining_data(pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+static void send_ooo_segment(int segment)
+{
+	struct net_pkt *data;
+	int ret;
+
+	seq = ooo_seq_start + segment * OOO_SEG_LEN;
+
+	data = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				   &ooo_data[segment * OOO_SEG_LEN],
+				   OOO_SEG_LEN);
+	zassert_not_null(data, "Failed to prepare data segment");
+
+	ret = net_recv_data(iface, data);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+}
+
+static void verify_ooo_ack(int acked_segments, int sack_left, int sack_right)
+{
+	zassert_equal(ooo_ack, ooo_seq_start + acked_segments * OOO_SEG_LEN,
+		      "Unexpected ACK %u", ooo_ack);
+
+	if (sack_left < 0 || !IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		zassert_equal(ooo_sack_blocks, 0, "Unexpected SACK");
+		return;
+	}
+
+	zassert_equal(ooo_sack_blocks, 1, "Expected a single SACK block");
+	zassert_equal(ooo_sack[0][0], ooo_seq_start + sack_left * OOO_SEG_LEN,
+		      "Unexpected SACK left edge %u", ooo_sack[0][0]);
+	zassert_equal(ooo_sack[0][1], ooo_seq_start + sack_right * OOO_SEG_LEN,
+		      "Unexpected SACK right edge %u", ooo_sack[0][1]);
+}
+
+/* Resend what the last ACK reports missing, the way the peer would:
+ * with SACK up to the first SACK block, otherwise everything after the
+ * ACK. Returns the number of bytes resent.
+ */
+static size_t resend_ooo_hole(void)
+{
+	uint32_t end = ooo_seq_start + sizeof(ooo_data);
+	uint32_t from = ooo_ack;
+	size_t resent = 0;
+	int segment;
+
+	for (int b = 0; b < ooo_sack_blocks; b++) {
+		if (net_tcp_seq_cmp(ooo_sack[b][0], end) < 0) {
+			end = ooo_sack[b][0];
+		}
+	}
+
+	while (net_tcp_seq_cmp(from, end) < 0) {
+		segment = (from - ooo_seq_start) / OOO_SEG_LEN;
+		send_ooo_segment(segment);
+
+		from = ooo_seq_start + (segment + 1) * OOO_SEG_LEN;
+		resent += OOO_SEG_LEN;
+	}
+
+	return resent;
+}
+
+/* Test case scenario IPv4
+ *   Expect SYN with SACK permitted option
+ *   send SYN ACK,
+ *   expect ACK,
+ *   send segments 1, 3, 4 and 2 of a stream,
+ *   expect duplicate ACKs with SACK blocks for the data after the hole,
+ *   resend what the ACK and SACK blocks report missing, only segment 2
+ *   with SACK,
+ *   expect the whole stream to be acked once the hole is filled,
+ *   any failures cause test case to fail.
+ */
+static void test_server_ooo_ipv4(void)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	size_t resent;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_OOO_QUEUE)) {
+		ztest_test_skip();
+	}
+
+	t_state = T_SYN;
+	test_case_no = 9;
+	seq = ack = 0;
+	ooo_received = 0;
+
+	for (int i = 0; i < sizeof(ooo_data); i++) {
+		ooo_data[i] = i;
+	}
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_delayed_work_submit(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	accepted_ctx->recv_cb = test_ooo_recv_cb;
+	ooo_seq_start = seq;
+
+	send_ooo_segment(0);
+	verify_ooo_ack(1, -1, -1);
+
+	/* Segment 1 is lost */
+	send_ooo_segment(2);
+	verify_ooo_ack(1, 2, 3);
+
+	send_ooo_segment(3);
+	verify_ooo_ack(1, 2, 4);
+
+	resent = resend_ooo_hole();
+	verify_ooo_ack(4, -1, -1);
+
+	/* Let the TCP work queue pass the data up */
+	k_msleep(50);
+
+	TC_PRINT("Retransmitted %zu of %zu bytes\n", resent,
+		 sizeof(ooo_data));
+	zassert_equal(resent, IS_ENABLED(CONFIG_NET_TCP_SACK) ?
+		      OOO_SEG_LEN : sizeof(ooo_data) - OOO_SEG_LEN,
+		      "Retransmitted %zu bytes", resent);
+	zassert_equal(ooo_received, sizeof(ooo_data),
+		      "Received %zu bytes", ooo_received);
+
+	seq = ooo_seq_start + sizeof(ooo_data);
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+#define GSO_SEG_LEN 100U
+
+static uint8_t gso_data[2 * GSO_SEG_LEN + GSO_SEG_LEN / 2];
+
+/* A PSH | FIN | ACK packet carrying gso_data, either in one piece or
+ * with each segment worth of data in its own fragment as TCP builds it.
+ */
+static struct net_pkt *prepare_gso_packet(bool fragmented)
+{
+	struct net_buf *frag;
+	struct net_pkt *pkt;
+	size_t off, len;
+	int ret;
+
+	if (!fragmented) {
+		pkt = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT),
+					     htons(PEER_PORT), PSH | FIN | ACK,
+					     gso_data, sizeof(gso_data));
+		zassert_not_null(pkt, "Failed to prepare GSO packet");
+		goto out;
+	}
+
+	pkt = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				     PSH | FIN | ACK, NULL, 0U);
+	zassert_not_null(pkt, "Failed to prepare GSO packet");
+
+	for (off = 0; off < sizeof(gso_data); off += len) {
+		len = MIN(sizeof(gso_data) - off, GSO_SEG_LEN);
+
+		frag = net_pkt_get_frag(pkt, K_NO_WAIT);
+		zassert_not_null(frag, "Failed to get a fragment");
+
+		net_buf_add_mem(frag, &gso_data[off], len);
+		net_pkt_frag_add(pkt, frag);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	zassert_equal(ret, 0, "Failed to finalize GSO packet (%d)", ret);
+out:
+	net_pkt_set_gso_size(pkt, GSO_SEG_LEN);
+
+	return pkt;
+}
+
+/* Every segment but the last one is full sized, follows the previous one
+ * in sequence space and has PSH and FIN cleared.
+ */
+static void verify_gso_segments(sys_slist_t *segs)
+{
+	uint8_t data[GSO_SEG_LEN];
+	struct net_pkt *seg;
+	sys_snode_t *node;
+	struct tcphdr th;
+	size_t off = 0;
+	size_t len;
+	int ret;
+
+	while ((node = sys_slist_get(segs)) != NULL) {
+		seg = CONTAINER_OF(node, struct net_pkt, next);
+		len = MIN(sizeof(gso_data) - off, GSO_SEG_LEN);
+
+		zassert_true(len > 0, "Too many segments");
+		zassert_equal(net_pkt_get_len(seg), NET_IPV4TCPH_LEN + len,
+			      "Segment length %zu", net_pkt_get_len(seg));
+		zassert_equal(ntohs(NET_IPV4_HDR(seg)->len),
+			      NET_IPV4TCPH_LEN + len, "Wrong IPv4 length");
+
+		ret = read_tcp_header(seg, &th);
+		zassert_equal(ret, 0, "Failed to read TCP header");
+
+		zassert_equal(ntohl(th.th_seq), seq + off,
+			      "Segment seq %u", ntohl(th.th_seq));
+		test_verify_flags(&th, off + len < sizeof(gso_data) ?
+				  ACK : PSH | FIN | ACK);
+
+		net_pkt_set_overwrite(seg, true);
+		ret = net_pkt_skip(seg, NET_IPV4TCPH_LEN);
+		zassert_equal(ret, 0, "Failed to skip headers");
+		ret = net_pkt_read(seg, data, len);
+		zassert_equal(ret, 0, "Failed to read segment data");
+		zassert_mem_equal(data, &gso_data[off], len,
+				  "Segment data mismatch");
+
+		off += len;
+		net_pkt_unref(seg);
+	}
+
+	zassert_equal(off, sizeof(gso_data), "Segmented %zu bytes", off);
+}
+
+/* Split a packet carrying more than one MSS of data, copying the data
+ * when it is in one piece and moving the fragments when they are
+ * segment aligned.
+ */
+static void test_tcp_gso_segment(void)
+{
+	struct net_pkt *pkt;
+	sys_slist_t segs;
+	int ret;
+
+	seq = 1000U;
+	ack = 2000U;
+
+	for (int i = 0; i < sizeof(gso_data); i++) {
+		gso_data[i] = i;
+	}
+
+	for (int fragmented = 0; fragmented < 2; fragmented++) {
+		pkt = prepare_gso_packet(fragmented);
+
+		ret = net_tcp_gso_segment(pkt, &segs);
+		zassert_equal(ret, 0, "GSO failed (%d)", ret);
+
+		verify_gso_segments(&segs);
+
+		net_pkt_unref(pkt);
+	}
+}
+#else
+static void test_tcp_gso_segment(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+static int gro_acks;
+static uint32_t gro_ack;
+static uint8_t gro_ack_flags;
+
+/* Count the ACKs sent to the peer, keeping the last one */
+static void handle_gro_test(struct tcphdr *th)
+{
+	gro_acks++;
+	gro_ack = ntohl(th->th_ack);
+	gro_ack_flags = th->th_flags;
+}
+
+#if defined(CONFIG_NET_TCP_GRO)
+/* Full sized for the 127 byte MTU of the test interface */
+#define GRO_SEG_LEN (127U - NET_IPV4TCPH_LEN)
+
+static uint8_t gro_data[GRO_SEG_LEN];
+static int gro_deliveries;
+static size_t gro_received;
+
+static void test_gro_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	if (pkt) {
+		gro_deliveries++;
+		gro_received += net_pkt_remaining_data(pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+static void send_gro_segment(uint8_t flags, size_t len)
+{
+	struct net_pkt *data;
+	int ret;
+
+	data = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT),
+				      htons(PEER_PORT), flags, gro_data, len);
+	zassert_not_null(data, "Failed to prepare segment");
+
+	ret = net_recv_data(iface, data);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	seq += len;
+}
+
+/* Check what was sent to the peer and passed to the application since
+ * the previous call: at most one ACK, with the given flags and number,
+ * and at most one piece of data.
+ */
+static void verify_gro(int acks, uint8_t flags, uint32_t acked,
+		       size_t delivered)
+{
+	/* Let the RX thread and the TCP work queue run */
+	k_msleep(20);
+
+	zassert_equal(gro_acks, acks, "Sent %d ACKs", gro_acks);
+
+	if (acks) {
+		zassert_equal(gro_ack_flags, flags, "ACK flags 0x%02x",
+			      gro_ack_flags);
+		zassert_equal(gro_ack, acked, "Unexpected ACK %u", gro_ack);
+	}
+
+	zassert_equal(gro_deliveries, delivered ? 1 : 0,
+		      "Data passed up %d times", gro_deliveries);
+	zassert_equal(gro_received, delivered, "Received %zu bytes",
+		      gro_received);
+
+	gro_acks = 0;
+	gro_deliveries = 0;
+	gro_received = 0;
+}
+
+/* Test case scenario IPv4
+ *   Expect SYN,
+ *   send SYN ACK,
+ *   expect ACK,
+ *   send full sized segments, expect a single ACK and a single piece of
+ *   data once NET_TCP_GRO_MAX_SEGS of them are received,
+ *   send a held segment followed by a PSH segment, by a segment out of
+ *   order, by nothing until the timeout and by a FIN, expect the held
+ *   data and its ACK to go out right away each time,
+ *   any failures cause test case to fail.
+ */
+static void test_server_gro_ipv4(void)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint32_t hole, end;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_OOO_QUEUE)) {
+		ztest_test_skip();
+	}
+
+	t_state = T_SYN;
+	test_case_no = 10;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_delayed_work_submit(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	accepted_ctx->recv_cb = test_gro_recv_cb;
+	verify_gro(0, 0, 0, 0);
+
+	/* In order segments are merged */
+	for (int i = 0; i < CONFIG_NET_TCP_GRO_MAX_SEGS - 1; i++) {
+		send_gro_segment(ACK, GRO_SEG_LEN);
+	}
+
+	verify_gro(0, 0, 0, 0);
+
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	verify_gro(1, ACK, seq, CONFIG_NET_TCP_GRO_MAX_SEGS * GRO_SEG_LEN);
+
+	/* A PSH segment ends the burst */
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	send_gro_segment(PSH | ACK, GRO_SEG_LEN);
+	verify_gro(1, ACK, seq, 2 * GRO_SEG_LEN);
+
+	/* So does a segment out of order, and the one filling the hole */
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	hole = seq;
+	seq += GRO_SEG_LEN;
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	verify_gro(1, ACK, hole, GRO_SEG_LEN);
+
+	end = seq;
+	seq = hole;
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	verify_gro(1, ACK, end, 2 * GRO_SEG_LEN);
+	seq = end;
+
+	/* Held data goes out on timeout */
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	verify_gro(0, 0, 0, 0);
+
+	k_msleep(CONFIG_NET_TCP_GRO_TIMEOUT);
+	verify_gro(1, ACK, seq, GRO_SEG_LEN);
+
+	/* And along with the ACK of a FIN */
+	send_gro_segment(ACK, GRO_SEG_LEN);
+	send_gro_segment(FIN | ACK, 0U);
+	verify_gro(1, FIN | ACK, seq + 1, GRO_SEG_LEN);
+
+	seq++;
+	pkt = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+#else
+static void test_server_gro_ipv4(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+#define WIN_SEG_LEN 100U
+#define WIN_SEGS 3
+
+static uint8_t win_data[WIN_SEG_LEN];
+static uint16_t win_adv[WIN_SEGS + 1];
+static int win_acks;
+static size_t win_unread;
+
+/* Record the window advertised by every ACK */
+static void handle_window_test(struct tcphdr *th)
+{
+	if (win_acks < ARRAY_SIZE(win_adv)) {
+		win_adv[win_acks] = ntohs(th->th_win);
+	}
+
+	win_acks++;
+
+	test_sem_give();
+}
+
+/* Account for the data like the socket layer does, but never read it */
+static void test_window_recv_cb(struct net_context *context,
+				struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				int status,
+				void *user_data)
+{
+	if (pkt) {
+		win_unread += net_pkt_remaining_data(pkt);
+		net_context_update_recv_wnd(context,
+					    -net_pkt_remaining_data(pkt));
+		net_pkt_unref(pkt);
+	}
+}
+
+static void send_window_segment(void)
+{
+	struct net_pkt *data;
+	int ret;
+
+	data = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				   win_data, WIN_SEG_LEN);
+	zassert_not_null(data, "Failed to prepare data segment");
+
+	ret = net_recv_data(iface, data);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	seq += WIN_SEG_LEN;
+}
+
+/* Test case scenario IPv4
+ *   Expect SYN,
+ *   send SYN ACK,
+ *   expect ACK,
+ *   send data segments that the application does not read,
+ *   expect the advertised window to shrink by the unread data,
+ *   read the data and send another segment,
+ *   expect the full window again,
+ *   any failures cause test case to fail.
+ */
+static void test_server_recv_window_ipv4(void)
+{
+	struct net_context *ctx;
+	struct net_pkt *rst;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 11;
+	seq = ack = 0;
+	win_acks = 0;
+	win_unread = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_delayed_work_submit(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	accepted_ctx->recv_cb = test_window_recv_cb;
+
+	for (int i = 0; i < WIN_SEGS; i++) {
+		send_window_segment();
+	}
+
+	/* Let the data reach the application */
+	k_msleep(10);
+
+	zassert_equal(win_unread, WIN_SEGS * WIN_SEG_LEN,
+		      "Received %zu bytes", win_unread);
+
+	/* The ACK of a segment goes out before its data is passed up */
+	for (int i = 1; i < WIN_SEGS; i++) {
+		zassert_equal(win_adv[i], win_adv[0] - i * WIN_SEG_LEN,
+			      "Window %u after %d unread segments",
+			      win_adv[i], i);
+	}
+
+	ret = net_context_update_recv_wnd(accepted_ctx, win_unread);
+	zassert_equal(ret, 0, "Failed to update the window (%d)", ret);
+
+	send_window_segment();
+	zassert_equal(win_acks, WIN_SEGS + 1, "Sent %d ACKs", win_acks);
+	zassert_equal(win_adv[WIN_SEGS], win_adv[0],
+		      "Window %u once read", win_adv[WIN_SEGS]);
+
+	rst = prepare_rst_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+
 /** Test case main entry */
 void test_main(void)
 {
@@ -1307,7 +1994,11 @@ void test_main(void)
 			 ztest_unit_test(test_client_syn_resend),
 			 ztest_unit_test(test_client_fin_wait_2_ipv4),
 			 ztest_unit_test(test_client_closing_ipv6),
-			 ztest_unit_test(test_client_invalid_rst)
+			 ztest_unit_test(test_client_invalid_rst),
+			 ztest_unit_test(test_server_ooo_ipv4),
+			 ztest_unit_test(test_tcp_gso_segment),
+			 ztest_unit_test(test_server_gro_ipv4),
+			 ztest_unit_test(test_server_recv_window_ipv4)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
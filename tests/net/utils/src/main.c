@@ -848,11 +848,34 @@ void test_addr_parse(void)
 #endif
 }
 
+static void test_chksum_update(void)
+{
+	/* IPv4 header from 192.0.2.2 to 192.0.2.1 with TTL 64 */
+	uint8_t hdr[] = {
+		0x45, 0x00, 0x00, 0x54, 0xea, 0x8c, 0x40, 0x00,
+		0x40, 0x01, 0xcc, 0x18, 0xc0, 0x00, 0x02, 0x02,
+		0xc0, 0x00, 0x02, 0x01,
+	};
+	struct in_addr dst = { { { 192, 0, 2, 3 } } };
+	uint16_t old_word, new_word, chksum;
+
+	memcpy(&old_word, &hdr[8], sizeof(old_word));
+	hdr[8]--;
+	memcpy(&new_word, &hdr[8], sizeof(new_word));
+
+	chksum = net_chksum_update16(htons(0xcc18), old_word, new_word);
+	zassert_equal(chksum, htons(0xcd18), "TTL update failed");
+
+	chksum = net_chksum_update(chksum, &hdr[16], &dst, sizeof(dst));
+	zassert_equal(chksum, htons(0xcd16), "Address update failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }